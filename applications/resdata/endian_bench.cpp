@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <ert/util/util.hpp>
+
+/*
+  Measures the throughput of util_endian_flip_vector() and
+  util_endian_flip_widen_float() against a plain scalar loop:
+
+     endian_bench [size_mb]
+
+  The buffers are 1024 MiB by default. Each kernel is run a few times
+  and the best throughput, in GB/s of input, is reported.
+*/
+
+namespace {
+
+constexpr int repeats = 5;
+
+template <typename F> double best_seconds(F &&f) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+void report(const char *name, size_t bytes, double seconds) {
+    printf("%-28s %8.3f s %8.2f GB/s\n", name, seconds, bytes / seconds / 1e9);
+}
+
+template <typename T> void scalar_flip(T *data, size_t elements) {
+    for (size_t i = 0; i < elements; i++) {
+        unsigned char *p = reinterpret_cast<unsigned char *>(&data[i]);
+        for (size_t j = 0; j < sizeof(T) / 2; j++) {
+            unsigned char tmp = p[j];
+            p[j] = p[sizeof(T) - 1 - j];
+            p[sizeof(T) - 1 - j] = tmp;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t size_mb = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1024;
+    if (size_mb == 0 || (size_mb << 20) / sizeof(uint32_t) > INT32_MAX) {
+        fprintf(stderr, "Usage: %s [size_mb]\n", argv[0]);
+        return 1;
+    }
+    const size_t bytes = size_mb << 20;
+
+    std::vector<uint32_t> data32(bytes / sizeof(uint32_t));
+    for (size_t i = 0; i < data32.size(); i++)
+        data32[i] = static_cast<uint32_t>(i * 2654435761u);
+    const int elements32 = static_cast<int>(data32.size());
+
+    report("scalar loop, 4 byte", bytes, best_seconds([&] {
+               scalar_flip(data32.data(), data32.size());
+           }));
+    report("util_endian_flip, 4 byte", bytes, best_seconds([&] {
+               util_endian_flip_vector(data32.data(), 4, elements32);
+           }));
+
+    {
+        std::vector<uint64_t> data64(bytes / sizeof(uint64_t));
+        for (size_t i = 0; i < data64.size(); i++)
+            data64[i] = i * 0x9E3779B97F4A7C15ull;
+        const int elements64 = static_cast<int>(data64.size());
+
+        report("scalar loop, 8 byte", bytes, best_seconds([&] {
+                   scalar_flip(data64.data(), data64.size());
+               }));
+        report("util_endian_flip, 8 byte", bytes, best_seconds([&] {
+                   util_endian_flip_vector(data64.data(), 8, elements64);
+               }));
+    }
+
+    std::vector<double> target(data32.size());
+    std::vector<float> values(data32.size());
+    report("flip, then widen", bytes, best_seconds([&] {
+               memcpy(values.data(), data32.data(), bytes);
+               util_endian_flip_vector(values.data(), 4, elements32);
+               for (size_t i = 0; i < values.size(); i++)
+                   target[i] = values[i];
+           }));
+    report("util_endian_flip_widen_float", bytes, best_seconds([&] {
+               util_endian_flip_widen_float(data32.data(), target.data(),
+                                            elements32);
+           }));
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_type.hpp>
+
+/*
+  Measures the throughput of the rd_kw arithmetic against plain scalar
+  loops over the same data:
+
+     kw_arith_bench [size_mb]
+
+  Each keyword holds size_mb MiB of doubles, 256 MiB by default. Each
+  operation is run a few times and the best throughput, in GB/s of the
+  keyword data read, is reported.
+*/
+
+namespace {
+
+constexpr int repeats = 5;
+
+template <typename F> double best_seconds(F &&f) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+void report(const char *name, size_t bytes, double seconds) {
+    printf("%-28s %8.3f s %8.2f GB/s\n", name, seconds, bytes / seconds / 1e9);
+}
+
+rd_kw_type *alloc_kw(int size, double offset) {
+    rd_kw_type *kw = rd_kw_alloc("KW", size, RD_DOUBLE);
+    double *data = rd_kw_get_double_ptr(kw);
+    for (int i = 0; i < size; i++)
+        data[i] = offset + (i % 1000) * 0.001;
+    return kw;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t size_mb = argc > 1 ? strtoul(argv[1], nullptr, 10) : 256;
+    if (size_mb == 0 || (size_mb << 20) / sizeof(double) > INT32_MAX) {
+        fprintf(stderr, "Usage: %s [size_mb]\n", argv[0]);
+        return 1;
+    }
+    const size_t bytes = size_mb << 20;
+    const int size = static_cast<int>(bytes / sizeof(double));
+
+    rd_kw_type *target = alloc_kw(size, 1);
+    rd_kw_type *other = alloc_kw(size, 2);
+    double *x = rd_kw_get_double_ptr(target);
+    const double *y = rd_kw_get_double_ptr(other);
+
+    report("scalar loop, add", 2 * bytes, best_seconds([&] {
+               for (int i = 0; i < size; i++)
+                   x[i] += y[i];
+           }));
+    report("rd_kw_inplace_add", 2 * bytes, best_seconds([&] {
+               rd_kw_inplace_add(target, other);
+           }));
+
+    report("scalar loop, mul", 2 * bytes, best_seconds([&] {
+               for (int i = 0; i < size; i++)
+                   x[i] *= y[i];
+           }));
+    report("rd_kw_inplace_mul", 2 * bytes, best_seconds([&] {
+               rd_kw_inplace_mul(target, other);
+           }));
+
+    report("scalar loop, scale", bytes, best_seconds([&] {
+               for (int i = 0; i < size; i++)
+                   x[i] *= 0.5;
+           }));
+    report("rd_kw_scale_double", bytes, best_seconds([&] {
+               rd_kw_scale_double(target, 0.5);
+           }));
+
+    double sum = 0;
+    report("scalar loop, sum", bytes, best_seconds([&] {
+               sum = 0;
+               for (int i = 0; i < size; i++)
+                   sum += y[i];
+           }));
+    report("rd_kw_element_sum", bytes, best_seconds([&] {
+               rd_kw_element_sum(other, &sum);
+           }));
+
+    double max;
+    double min;
+    report("scalar loop, max_min", bytes, best_seconds([&] {
+               max = min = y[0];
+               for (int i = 1; i < size; i++) {
+                   max = y[i] > max ? y[i] : max;
+                   min = y[i] < min ? y[i] : min;
+               }
+           }));
+    report("rd_kw_max_min", bytes, best_seconds([&] {
+               rd_kw_max_min(other, &max, &min);
+           }));
+    printf("sum: %g max: %g min: %g\n", sum, max, min);
+
+    rd_kw_free(target);
+    rd_kw_free(other);
+}
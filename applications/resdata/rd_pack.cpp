@@ -40,10 +40,21 @@ bool fname_cmp(const std::string &f1, const std::string &f2) {
 }
 
 int main(int argc, char **argv) {
-    int num_files = argc - 1;
+    /* With --direct-io the files are read and written past the page cache,
+       see ERT::FortIO::set_direct_io(). */
+    bool direct_io = false;
+    std::vector<std::string> filelist;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--direct-io")
+            direct_io = true;
+        else
+            filelist.push_back(argv[i]);
+    }
+
+    int num_files = filelist.size();
     if (num_files >= 1) {
         /* File type and formatted / unformatted is determined from the first argument on the command line. */
-        fs::path filepath(argv[1]);
+        fs::path filepath(filelist.front());
         std::string filename = filepath.string();
         FileType file_type, target_type;
         bool fmt_file;
@@ -69,11 +80,11 @@ int main(int argc, char **argv) {
         fs::path target_file =
             rd::filename(filepath.stem(), target_type, fmt_file, -1);
 
-        std::vector<std::string> filelist(argv + 1, argv + argc);
         std::sort(filelist.begin(), filelist.end(), fname_cmp);
 
         rd_kw_ptr seqnum_kw(nullptr, &rd_kw_free);
         ERT::FortIO target(target_file, std::ios_base::out, fmt_file);
+        target.set_direct_io(direct_io);
 
         if (target_type == FileType::UNIFIED_RESTART) {
             int dummy;
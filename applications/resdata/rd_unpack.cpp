@@ -23,6 +23,7 @@
 #include <memory>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include <ert/util/util.hpp>
 
@@ -36,7 +37,7 @@
 
 namespace fs = std::filesystem;
 
-static void unpack_file(const fs::path &filepath) {
+static void unpack_file(const fs::path &filepath, bool direct_io) {
     std::string filename = filepath;
     FileType target_type = FileType::OTHER;
     FileType file_type;
@@ -88,13 +89,24 @@ static void unpack_file(const fs::path &filepath) {
         fs::path target_file =
             rd::filename(filepath.stem(), target_type, fmt_file, report_step);
         ERT::FortIO fortio_target(target_file, std::ios_base::out, fmt_file);
+        fortio_target.set_direct_io(direct_io);
         active_view->write(fortio_target, offset);
     }
 }
 
 int main(int argc, char **argv) {
-    if (argc == 1)
-        util_exit("rd_unpack UNIFIED_FILE1   UNIFIED_FILE2   ...\n");
-    for (int i = 1; i < argc; i++)
-        unpack_file(fs::path(argv[i]));
+    bool direct_io = false;
+    std::vector<fs::path> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--direct-io")
+            direct_io = true;
+        else
+            files.emplace_back(argv[i]);
+    }
+
+    if (files.empty())
+        util_exit("rd_unpack [--direct-io] UNIFIED_FILE1   UNIFIED_FILE2   "
+                  "...\n");
+    for (const auto &file : files)
+        unpack_file(file, direct_io);
 }
@@ -184,6 +184,12 @@ void *util_realloc_copy(void *org_ptr, const void *src, size_t byte_size);
 void *util_alloc_copy(const void *, size_t);
 char *util_fread_alloc_file_content(const char *, int *);
 void util_endian_flip_vector(void *data, int element_size, int elements);
+/*
+  Converts @elements floats in the opposite byte order at @source into
+  doubles at @target; the same as flipping and widening in two passes.
+*/
+void util_endian_flip_widen_float(const void *source, double *target,
+                                  int elements);
 
 void util_double_vector_max_min(int, const double *, double *, double *);
 void util_update_double_max_min(double, double *, double *);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ios>
+#include <memory>
 #include <string>
 #include <cstdlib>
 #include <cstdio>
@@ -43,6 +44,16 @@ transparently.
 */
 class FortIO {
 public:
+    /**
+    How the file is going to be read, see advise(). SEQUENTIAL asks for
+    aggressive readahead, RANDOM turns readahead off. STRIDED is for many
+    small reads at regular distances through the file, like reading a few
+    elements from each of the keywords in a summary file; readahead is
+    turned off, the caller is expected to ask for the next strides with
+    will_need(), and the small reads in rd_kw.cpp bypass the stdio buffer.
+    */
+    enum class AccessHint { NORMAL, SEQUENTIAL, RANDOM, STRIDED };
+
     FortIO() = delete;
     FortIO(const std::string &filename, std::ios_base::openmode mode,
            bool fmt_file = false, bool endian_flip_header = RD_ENDIAN_FLIP);
@@ -67,12 +78,24 @@ public:
     int fskip_record();
     bool fread_buffer(char *buffer, int buffer_size);
     void fwrite_record(const char *buffer, int buffer_size);
+    /**
+    Writes the @size bytes at @buffer as consecutive records of
+    @record_size bytes, the last record holds the remainder; the result
+    is the same as calling fwrite_record() for each record. Where
+    writev(2) is available the records of a large write are gathered into
+    a few system calls, smaller writes go through the stream buffer.
+    Throws std::ios_base::failure if the write fails.
+    */
+    void fwrite_records(const char *buffer, size_t size, int record_size);
     [[nodiscard]] FILE *get_FILE() const;
     void fflush() const;
     void rewind() const;
     [[nodiscard]] const char *filename_ref() const;
     [[nodiscard]] const std::string &filename() const { return m_filename; };
     [[nodiscard]] bool fmt_file() const;
+    [[nodiscard]] bool endian_flip_header() const {
+        return m_endian_flip_header;
+    }
     [[nodiscard]] offset_type ftell() const;
     bool fseek(offset_type offset, int whence);
     bool data_fskip(int element_size, int element_count, int block_count);
@@ -85,10 +108,139 @@ public:
     [[nodiscard]] bool stream_is_open() const;
     bool assert_stream_open();
     bool read_at_eof();
+    /**
+    Re-reads the size of the file, which is otherwise recorded when the
+    file is opened, so that data appended to the file by another process
+    can be read. A mapped file is remapped when the size has changed.
+    Returns true if the size has changed.
+    */
+    bool update_size();
     void fwrite_error();
 
+    /**
+    Tells the operating system how the file is going to be read, with
+    posix_fadvise(2) for the stream and madvise(2) for the mapping. The
+    hint is remembered and applied again when the stream is reopened or
+    the file is mapped. Where neither call is available only the stream
+    functions in rd_kw.cpp make use of the hint.
+    */
+    void advise(AccessHint hint);
+    [[nodiscard]] AccessHint access_hint() const { return m_access_hint; }
+    /**
+    Starts reading the @size bytes at @offset into the page cache in the
+    background, so that a later read of the range does not have to wait
+    for the file system. This is only a hint and it does nothing if it is
+    not supported.
+    */
+    void will_need(offset_type offset, offset_type size) const;
+    /**
+    Sets the size of the stdio buffer of the stream to @size bytes; 0
+    restores the default buffer of the C library, which is typically the
+    block size reported by the file system. The buffer is installed when
+    the stream is reopened with fopen_stream(). An open stream is flushed
+    and replaced by a new stream on the same file and at the same
+    position, so the FILE * returned by get_FILE() before the call is no
+    longer valid. Streams which are not owned by the FortIO instance are
+    left alone.
+    */
+    void set_buffer_size(size_t size);
+    [[nodiscard]] size_t buffer_size() const { return m_buffer_size; }
+
+    /**
+    Maps the complete file read-only into memory. When the file is mapped
+    the keyword readers in rd_kw.cpp decode the records straight from the
+    mapping instead of going through fread() and an intermediate buffer;
+    rd::MappedKW gives read-only access to a keyword in the mapping.
+
+    Mapping is only supported for unformatted files opened in read only
+    mode; if the file can not be mapped the function returns false and the
+    FortIO instance continues to work through the FILE * stream.
+    */
+    bool mmap_file();
+    void munmap_file();
+    [[nodiscard]] bool is_mapped() const { return m_map != nullptr; }
+    [[nodiscard]] const char *mapped_data() const { return m_map; }
+    [[nodiscard]] offset_type mapped_size() const { return m_map_size; }
+    /**
+    Returns a pointer to the data part of the fortran record starting at
+    @offset in the mapping, and stores the size of the record in
+    @record_size. On return @offset has been advanced past the record
+    tail. Returns nullptr if there is no complete and consistent record at
+    @offset.
+    */
+    const char *mapped_record(offset_type &offset, int &record_size) const;
+    /**
+    As mapped_record(), for a fortran record at @offset in the @size bytes
+    starting at @data.
+    */
+    const char *buffer_record(const char *data, offset_type size,
+                              offset_type &offset, int &record_size) const;
+
+    /**
+    Whether pread() is supported; that is the case for unformatted files
+    which are mapped, or open on a platform with pread(2).
+    */
+    [[nodiscard]] bool can_pread() const;
+    /**
+    Reads @size bytes at @offset without using or moving the position of
+    the stream. Several threads can call pread() on the same instance
+    concurrently, as long as the stream is neither closed nor moved.
+    Returns false on a short or failed read.
+    */
+    bool pread(offset_type offset, char *buffer, size_t size) const;
+    /**
+    Reads the payloads of the records at @offset, as written by
+    fwrite_records(@buffer, @size, @record_size), into the @size bytes at
+    @buffer, with positional reads as pread(). Returns false if the read
+    fails or the record markers do not match.
+    */
+    bool pread_records(offset_type offset, char *buffer, size_t size,
+                       int record_size) const;
+
+    /**
+    Writes the @size bytes at @offset in @source at the current position,
+    without decoding them; copy_file_range(2) is used where available,
+    otherwise the bytes are copied through a large buffer. The position
+    of the stream of @source is not used when it supports pread().
+
+    Returns false, without writing anything, if the files do not share
+    format and byte order, or if the range is not within @source. Throws
+    std::ios_base::failure if the copy fails part way.
+    */
+    bool fwrite_raw(FortIO &source, offset_type offset, offset_type size);
+
+    /**
+    Turns the direct io mode on or off; it is off by default. In this
+    mode the large writes of fwrite_raw() and fwrite_records() bypass
+    the page cache with O_DIRECT, and fwrite_raw() reads the source the
+    same way. The data goes through two aligned buffers, one is filled
+    while the other is written, or read, in the background.
+
+    This is for tools which read and write large files once, where the
+    page cache only evicts the data of other processes. Where O_DIRECT
+    is not available, or refused by the file system, the files are
+    written as usual.
+
+    Once a large write has started it, the direct writing goes on across
+    the following writes, until the file is sought, flushed or closed,
+    or the stream is used otherwise. The failure of the pending writes
+    is thrown from there as std::ios_base::failure; the destructor
+    ignores it.
+    */
+    void set_direct_io(bool direct_io);
+    [[nodiscard]] bool direct_io() const { return m_direct_io; }
+
 private:
     bool fseek_(offset_type offset, int whence);
+    int buffer_int(const char *data, offset_type offset) const;
+    void apply_buffer();
+    void apply_access_hint() const;
+    bool fwrite_direct(const FortIO &source, offset_type offset,
+                       offset_type size);
+
+    class DirectWriter;
+    DirectWriter *start_direct_write();
+    void finish_direct_write() const;
 
     FILE *m_stream = nullptr;
     std::string m_filename;
@@ -106,5 +258,14 @@ private:
     */
     bool m_writable = false;
     offset_type m_read_size = 0;
+
+    const char *m_map = nullptr;
+    offset_type m_map_size = 0;
+
+    AccessHint m_access_hint = AccessHint::NORMAL;
+    std::unique_ptr<char[]> m_buffer;
+    size_t m_buffer_size = 0;
+    bool m_direct_io = false;
+    std::unique_ptr<DirectWriter> m_direct_writer;
 };
 } // namespace ERT
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <resdata/rd_file_view.hpp>
+#include <resdata/rd_kw_magic.hpp>
+
+namespace rd {
+
+/** Iterates over the blocks of a FileView, e.g. the SEQNUM blocks of a
+    unified restart file or the SEQHDR blocks of a unified summary file,
+    while a background thread loads the keywords of the blocks ahead.
+
+    The blocks are the ones of FileView::blockview(block_kw, block_kw, i),
+    and the loaded blocks wait in a queue which holds at most @depth
+    blocks, and at most @memory_cap bytes of keyword data unless
+    @memory_cap is 0. A block which is larger than @memory_cap on its own
+    is loaded when the queue is empty. With @kws only the keywords named
+    there are loaded; the other keywords of the blocks are still available
+    and loaded on demand.
+
+    The loaded keywords are pinned, see FileView::pin_kw(), until the
+    caller has moved on from the block; they are neither evicted by the
+    memory budget of the file nor dropped by FileView::clear() before. */
+class BlockPrefetcher {
+public:
+    /** Starts loading the first blocks; throws std::invalid_argument
+        if @depth is 0. */
+    BlockPrefetcher(std::shared_ptr<FileView> view,
+                    const std::string &block_kw = SEQNUM_KW,
+                    std::vector<std::string> kws = {}, size_t depth = 2,
+                    size_t memory_cap = 0);
+    /** Cancels the loading and waits for the background thread. */
+    ~BlockPrefetcher();
+    BlockPrefetcher(const BlockPrefetcher &) = delete;
+    BlockPrefetcher &operator=(const BlockPrefetcher &) = delete;
+
+    /** The number of blocks. */
+    [[nodiscard]] size_t size() const { return num_blocks; }
+    /** The next block, waiting for it to be loaded, or nullptr after the
+        last block or cancel(). The keywords of the block stay pinned
+        until the following call to next().
+
+        If a keyword of the block could not be loaded the exception from
+        the background thread is rethrown, and the iteration stops. */
+    std::shared_ptr<FileView> next();
+    /** Stops the loading of the blocks ahead and drops them. */
+    void cancel();
+
+private:
+    struct Block {
+        std::shared_ptr<FileView> view;
+        std::vector<KWHandle> handles;
+        size_t bytes = 0;
+        std::exception_ptr error;
+    };
+
+    void run();
+    [[nodiscard]] bool wanted(const std::string &header) const;
+
+    std::shared_ptr<FileView> view;
+    std::string block_kw;
+    std::vector<std::string> kws;
+    size_t depth;
+    size_t memory_cap;
+    size_t num_blocks;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    /* The loaded blocks, and their size in bytes; guarded by mutex. */
+    std::deque<Block> queue;
+    size_t queued_bytes = 0;
+    bool done = false;
+    std::atomic<bool> cancelled{false};
+
+    /* The pins of the block last returned by next(). */
+    std::vector<KWHandle> current;
+    std::thread worker;
+};
+
+} // namespace rd
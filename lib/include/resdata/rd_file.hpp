@@ -1,10 +1,13 @@
 #pragma once
 #include <ctime>
 
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <resdata/rd_kw.hpp>
 #include <resdata/rd_file_view.hpp>
@@ -12,6 +15,10 @@
 #include <resdata/rd_file_flag.hpp>
 
 namespace rd {
+/** Selects the keywords indexed by File::open(), given the header of each
+    keyword in the file. */
+using KeywordFilter = std::function<bool(const std::string &)>;
+
 class File {
     std::shared_ptr<rd::FileContext> context;
     std::shared_ptr<rd::FileView>
@@ -19,22 +26,70 @@ class File {
     File(std::shared_ptr<rd::FileContext> context,
          std::shared_ptr<rd::FileView> global_view)
         : context(std::move(context)), global_view(std::move(global_view)) {};
-    void scan();
+    void scan(offset_type offset = 0);
+    [[nodiscard]] bool is_indexed(const std::string &header) const;
+
+    KeywordFilter filter;
 
 public:
     static std::unique_ptr<File> open(const std::string &filename,
                                       FileMode flags = FileMode::DEFAULT);
+    /** Opens @filename with only the keywords accepted by @filter in the
+        index, together with the keywords the views are built around:
+        SEQNUM, INTEHEAD, LOGIHEAD, DOUBHEAD, SEQHDR, MINISTEP, LGR and
+        ENDLGR. The other keywords are skipped by the scan, and are not
+        available from the File or its views.
+
+        refresh() applies the same filter. FileMode::INDEX_CACHE has no
+        effect, as the cache holds complete indices. */
+    static std::unique_ptr<File> open(const std::string &filename,
+                                      KeywordFilter filter,
+                                      FileMode flags = FileMode::DEFAULT);
+    /** Opens @filename with only the keywords named in @keywords, and the
+        structural keywords, in the index; see above. */
+    static std::unique_ptr<File> open(const std::string &filename,
+                                      const std::vector<std::string> &keywords,
+                                      FileMode flags = FileMode::DEFAULT);
     static std::unique_ptr<File> fast_open(const std::string &file_name,
                                            const std::string &index_file_name,
                                            FileMode flags = FileMode::DEFAULT);
+    /** See FileView::write(); throws std::logic_error if the file was
+        opened with a keyword filter. */
     void write(ERT::FortIO &target, size_t offset) {
         global_view->write(target, offset);
     };
+    /** Will index the keywords appended to the file since it was opened
+        or last refreshed, and returns the number of new keywords.
+
+        The scan continues after the last indexed keyword, and like open()
+        it stops at the first incomplete keyword; a keyword which is still
+        being written is picked up by a later refresh. Views created before
+        the refresh are not updated.
+
+        Throws std::runtime_error if the last indexed keyword can no longer
+        be read, i.e. if the file has been truncated or rewritten.
+
+        Keyword loads from other threads may be in progress, the refresh
+        waits for them to complete. The index itself is extended in place,
+        so lookups by name or position must not run concurrently with a
+        refresh. */
+    size_t refresh();
+    /** The directory used for the index cache of FileMode::INDEX_CACHE.
+
+       This is $RD_INDEX_CACHE_DIR if set, otherwise resdata/index in
+       $XDG_CACHE_HOME or ~/.cache, and finally resdata-index in the
+       temporary directory. The directory is created on demand. */
+    static std::filesystem::path index_cache_dir();
     /** Write an index of this file to @index_filename.
 
        Throws std::ios_base::failure if the index file cannot be opened or
-       written. */
+       written, and std::logic_error if the file was opened with a keyword
+       filter, as fast_open() would then expose only part of the file. */
     void write_index(const std::string &index_filename);
+    /** Tells the operating system how the file is going to be read, see
+        ERT::FortIO::advise(). The keywords are indexed with the
+        SEQUENTIAL hint, after which the hint given here is restored. */
+    void advise(ERT::FortIO::AccessHint hint);
     /** The rd_file_close() function will close the fortio instance */
     void close() {
         if (context)
@@ -52,6 +107,35 @@ public:
     [[nodiscard]] rd_kw_type *get_kw(const std::string &kw, size_t ith) const {
         return global_view->get_kw(kw, ith);
     }
+    /** As get_kw(), and keeps the keyword loaded while the returned handle
+        exists, see FileView::pin_kw(). */
+    [[nodiscard]] KWHandle pin_kw(const std::string &kw, size_t ith) const {
+        return global_view->pin_kw(kw, ith);
+    }
+    /** Keeps the keywords returned by the file loaded until the returned
+        scope is closed, see FileView::scope(). */
+    [[nodiscard]] KWScope scope() const { return global_view->scope(); }
+    /** Limits the memory used by the loaded keywords to @bytes, or removes
+        the limit with @bytes == 0, which is the default.
+
+        Above the budget the least recently used keywords which are not
+        pinned are dropped, and are read again from file on the next
+        access. The rd_kw returned by get_kw() is then only valid until the
+        next keyword of the file is loaded; pin keywords which are kept,
+        in particular keywords which are modified and written back with
+        save_kw(), and open a scope() around code which uses several
+        keywords at once. */
+    void set_memory_budget(size_t bytes);
+    [[nodiscard]] size_t memory_budget() const {
+        return context->memory_budget;
+    }
+    [[nodiscard]] CacheStats cache_stats() const;
+    /** The counters of the allocator of the keywords loaded from the
+        file, see KWPool; system_allocations counts the chunks of the
+        pool and not the buffers of the larger keywords. */
+    [[nodiscard]] KWAllocationStats kw_allocation_stats() const {
+        return context->kw_pool->stats();
+    }
     /** The total number of rd_kws in the File. */
     [[nodiscard]] size_t size() const { return global_view->size(); }
 
@@ -9,10 +9,18 @@ enum class FileMode : int {
               this is mainly to save filedescriptors in cases where many rd_file
               instances are open at the same time. */
     WRITABLE =
-        2 /* This flag opens the file in a mode where it can be updated and modified,
+        2, /* This flag opens the file in a mode where it can be updated and modified,
              but it must still exist and be readable. I.e. this should not compared
              with the normal: fopen(filename , "w") where an existing file is
              truncated to zero upon successfull open. */
+    MMAP =
+        4, /* This flag maps read only, unformatted files into memory, and keyword
+             data is then decoded directly from the mapping. Falls back to
+             ordinary stream io when the file can not be mapped. */
+    INDEX_CACHE =
+        8 /* This flag makes rd::File::open() look for an index of the file in
+             the index cache directory (see rd::File::index_cache_dir()), and
+             store the index there after scanning when none is found. */
 };
 
 constexpr FileMode operator|(FileMode lhs, FileMode rhs) {
@@ -1,11 +1,14 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
 #include <istream>
 #include <memory>
 #include <utility>
+#include <optional>
 #include <ostream>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include <ert/util/util.hpp>
 
@@ -13,34 +16,46 @@
 #include <resdata/FortIO.hpp>
 #include "resdata/rd_type.hpp"
 
+/** A keyword header, which is at most RD_STRING8_LENGTH characters,
+    packed into an integer so that headers compare and hash as one word. */
+using kw_name_type = uint64_t;
+
+/** Packs @header, or returns nullopt if it is longer than
+    RD_STRING8_LENGTH characters and so can not be a keyword header. */
+std::optional<kw_name_type> pack_kw_name(std::string_view header);
+std::string unpack_kw_name(kw_name_type name);
+
 /** FileKW holds the header information (name, size, type) for an rd_kw
     and the offset in a file containing the keyword.
 
-    If and when the keyword is actually queried for, the
-    get_kw() method will seek to the keyword position in an
-    open fortio instance and read the rd_kw. */
+    A FileKW does not hold the keyword itself; load() reads it from an
+    open fortio instance when it is queried for. The keywords loaded from
+    a file are cached in the FileContext of the file, see
+    rd::FileView::get_kw(). */
 class FileKW {
     offset_type file_offset;
     rd_data_type data_type;
     int kw_size;
-    std::string header;
-    rd_kw_ptr kw{nullptr, &rd_kw_free};
+    kw_name_type name;
 
-    void assert_kw() const;
-    void load_kw(ERT::FortIO &fortio);
+    void assert_kw(const rd_kw_type *kw) const;
 
 public:
+    /** Throws std::invalid_argument if @header is longer than
+        RD_STRING8_LENGTH characters. */
+    FileKW(offset_type file_offset, rd_data_type data_type, int kw_size,
+           std::string_view header);
     FileKW(offset_type file_offset, rd_data_type data_type, int kw_size,
-           std::string header)
+           kw_name_type name)
         : file_offset(file_offset), data_type(data_type), kw_size(kw_size),
-          header(std::move(header)) {};
+          name(name) {}
     /** Create a new FileKW based on header information from
         the input keyword.
 
         Typically only the header has been loaded from the keyword.
 
         It is the users responsibility that the @offset argument comes
-        from the same fortio instance as used when calling get_kw().*/
+        from the same fortio instance as used when calling load().*/
     FileKW(const rd_kw_type *rd_kw, offset_type offset)
         : FileKW(offset, rd_kw_get_data_type(rd_kw), rd_kw_get_size(rd_kw),
                  rd_kw_get_header(rd_kw)) {}
@@ -54,34 +69,35 @@ public:
         if (!rd_type_is_equal(data_type, other.data_type))
             return false;
 
-        return header == other.header;
+        return name == other.name;
     }
-    [[nodiscard]] const std::string &get_header() const { return header; };
+    [[nodiscard]] std::string get_header() const {
+        return unpack_kw_name(name);
+    };
+    [[nodiscard]] kw_name_type get_name() const { return name; };
     [[nodiscard]] int get_size() const { return kw_size; };
     [[nodiscard]] offset_type get_offset() const { return file_offset; };
     [[nodiscard]] rd_data_type get_data_type() const { return data_type; };
 
-    /** The rd_kw, if one is read, otherwise returns nullptr. */
-    [[nodiscard]] rd_kw_type *get_kw_ptr() const { return kw.get(); };
-
-    /** Return the rd_kw. If it is not loaded, the method will read it
-       from @fortio. The kw is then cached. */
-    rd_kw_type *get_kw(ERT::FortIO &fortio);
+    /** Read the rd_kw by seeking to it in @fortio. Throws
+        std::runtime_error if the keyword in the file does not match this
+        header. */
+    [[nodiscard]] rd_kw_ptr load(ERT::FortIO &fortio) const;
+    /** As load(), with positional reads which leave the stream position
+        alone, see ERT::FortIO::pread(). Returns nullptr if @fortio does
+        not support them. */
+    [[nodiscard]] rd_kw_ptr pread(const ERT::FortIO &fortio) const;
 
     bool skip_data(ERT::FortIO &fortio) const;
     /** Read @num keyword headers from @stream.
 
        The stream is expected to have its exception mask configured (e.g.
        std::ios_base::failbit | std::ios_base::badbit) */
-    static std::vector<std::shared_ptr<FileKW>> read(std::istream &stream,
-                                                     size_t num);
-
-    /** Clear the cached kw. Note: previous pointers to
-       kws are invalidated. */
-    void clear();
+    static std::vector<FileKW> read(std::istream &stream, size_t num);
 
-    /** Overwrite the file contents with the new content of the rd_kw. */
-    void inplace_write(ERT::FortIO &fortio) const;
+    /** Overwrite the file contents with the content of @rd_kw, which
+        must have been loaded from this keyword. */
+    void inplace_write(ERT::FortIO &fortio, const rd_kw_type *rd_kw) const;
     /** Write this keyword's header to @stream.
 
        The stream is expected to have its exception mask configured (e.g.
@@ -1,19 +1,27 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <ctime>
 #include <istream>
 #include <iterator>
+#include <list>
 #include <ostream>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
-#include <map>
 #include <optional>
 
 #include <ert/util/int_vector.hpp>
 
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_allocator.hpp>
 #include <resdata/rd_file_kw.hpp>
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_file_flag.hpp>
@@ -21,28 +29,230 @@
 
 namespace rd {
 
-using inv_map_type = std::unordered_map<const rd_kw_type *, FileKW *>;
+/* Maps a loaded rd_kw to its position in the FileIndex of the file. */
+using inv_map_type = std::unordered_map<const rd_kw_type *, size_t>;
+
+/** Counters of the keyword cache of a file, see File::cache_stats(). */
+struct CacheStats {
+    /** Number of keyword lookups served by an already loaded keyword. */
+    size_t hits = 0;
+    /** Number of keyword lookups which read the keyword from file. */
+    size_t misses = 0;
+    /** Number of keywords dropped to stay within the memory budget. */
+    size_t evictions = 0;
+    /** Size in bytes of the data of the keywords currently loaded. */
+    size_t loaded_bytes = 0;
+};
 
 struct FileContext {
     ERT::FortIO fortio;
     FileMode flags;
     inv_map_type inv_map;
+    /* Guards the open/closed state of fortio, inv_map and the cache when
+       keywords are loaded from several threads, see FileView::get_kw().
+       Lock it after the load mutex of a keyword, and before
+       stream_mutex. */
+    std::mutex mutex;
+    /* Guards the position of the fortio stream. */
+    std::mutex stream_mutex;
+    /* Number of keyword loads in progress; the stream is not closed
+       with FileMode::CLOSE_STREAM until the last one completes. */
+    int active_loads = 0;
+    /* Notified when active_loads drops to zero, see File::refresh(). */
+    std::condition_variable loads_done;
+    /* Striped locks serializing the loads of a keyword, so that a keyword
+       requested by several threads is only read once; see load_mutex(). */
+    std::array<std::mutex, 64> load_mutexes;
+
+    /* A loaded keyword, by its position in the FileIndex of the file. */
+    struct CacheEntry {
+        size_t position;
+        rd_kw_ptr kw;
+        size_t bytes;
+        int pins;
+        /* Returned while a KWScope was open, see hold(). */
+        bool held;
+    };
+    /* The loaded keywords, most recently used first. */
+    std::list<CacheEntry> lru;
+    std::unordered_map<size_t, std::list<CacheEntry>::iterator> lru_index;
+    /* Upper limit on loaded_bytes, 0 for no limit. */
+    std::atomic<size_t> memory_budget{0};
+    size_t loaded_bytes = 0;
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+    size_t evictions = 0;
+    /* Number of open KWScope instances. */
+    int scopes = 0;
+    /* Whether the index leaves out the keywords rejected by a keyword
+       filter, see File::open(). */
+    bool filtered = false;
+    /* The allocator of the keywords loaded from the file; the chunks of
+       the pool are kept until the last keyword using them is freed. */
+    std::shared_ptr<KWPool> kw_pool = KWPool::create();
 
     FileContext(ERT::FortIO fortio, FileMode flags)
         : fortio(std::move(fortio)), flags(flags) {}
+
+    std::mutex &load_mutex(size_t position) {
+        return load_mutexes[position % load_mutexes.size()];
+    }
+
+    /* The functions below must be called with mutex held. */
+
+    /* The keyword loaded at @position, or nullptr. */
+    [[nodiscard]] rd_kw_type *find(size_t position) const;
+    /* Marks the keyword loaded at @position as most recently used, and
+       pins it if @pin is set. Returns nullptr if it is not loaded. */
+    rd_kw_type *touch(size_t position, bool pin);
+    /* Keeps the keyword of @entry while a KWScope is open. */
+    void hold(CacheEntry &entry) const;
+    /* Adds the keyword newly loaded at @position to the cache. */
+    rd_kw_type *insert(size_t position, rd_kw_ptr rd_kw, bool pin);
+    /* Drops the least recently used keywords which are neither pinned
+       nor held until the loaded keywords fit in the memory budget. */
+    void evict();
+    /* Drops the keywords loaded at positions [@first, @last) which are
+       neither pinned nor held. */
+    void drop(size_t first, size_t last);
+    void unpin(size_t position);
+    /* Releases the held keywords when the last KWScope closes. */
+    void close_scope();
+};
+
+/** Keeps a keyword loaded while the handle exists, see FileView::pin_kw().
+
+    A pinned keyword is neither evicted to stay within the memory budget of
+    the file, nor dropped by FileView::clear(), so the rd_kw pointer stays
+    valid. */
+class KWHandle {
+    std::shared_ptr<FileContext> context;
+    size_t position = 0;
+    rd_kw_type *kw = nullptr;
+
+public:
+    KWHandle() = default;
+    KWHandle(std::shared_ptr<FileContext> context, size_t position,
+             rd_kw_type *kw)
+        : context(std::move(context)), position(position), kw(kw) {}
+    KWHandle(const KWHandle &) = delete;
+    KWHandle &operator=(const KWHandle &) = delete;
+    KWHandle(KWHandle &&other) noexcept
+        : context(std::move(other.context)), position(other.position),
+          kw(std::exchange(other.kw, nullptr)) {}
+    KWHandle &operator=(KWHandle &&other) noexcept {
+        if (this != &other) {
+            reset();
+            context = std::move(other.context);
+            position = other.position;
+            kw = std::exchange(other.kw, nullptr);
+        }
+        return *this;
+    }
+    ~KWHandle() { reset(); }
+
+    /** Unpins the keyword; the handle is then empty. */
+    void reset();
+    [[nodiscard]] rd_kw_type *get() const { return kw; }
+    explicit operator bool() const { return kw != nullptr; }
+};
+
+/** Keeps the keywords returned by a file loaded while the scope exists,
+    see FileView::scope().
+
+    With a memory budget, every keyword the file returns while a scope is
+    open stays loaded until the last open scope of the file is closed, as
+    if it was pinned. Code which works on several keywords of a file at
+    the same time opens a scope for the duration of the work, instead of
+    pinning each of the keywords. */
+class KWScope {
+    std::shared_ptr<FileContext> context;
+
+public:
+    KWScope() = default;
+    explicit KWScope(std::shared_ptr<FileContext> context);
+    KWScope(const KWScope &) = delete;
+    KWScope &operator=(const KWScope &) = delete;
+    KWScope(KWScope &&other) noexcept = default;
+    KWScope &operator=(KWScope &&other) noexcept {
+        if (this != &other) {
+            reset();
+            context = std::move(other.context);
+        }
+        return *this;
+    }
+    ~KWScope() { reset(); }
+
+    /** Closes the scope. */
+    void reset();
+};
+
+/** The keyword index of a file, shared by the FileView of the file and
+    the blockviews created from it.
+
+    The headers of the keywords are stored as parallel arrays indexed by
+    the position of the keyword in the file, and occurrences maps a
+    packed header to the positions of the keywords with that header, in
+    increasing order. The loaded keywords are kept in the FileContext of
+    the file, so an indexed keyword costs a few dozen bytes. */
+struct FileIndex {
+    std::vector<offset_type> offsets;
+    std::vector<int> sizes;
+    std::vector<rd_data_type> types;
+    std::vector<kw_name_type> names;
+    std::unordered_map<kw_name_type, std::vector<size_t>> occurrences;
+    /* The distinct headers, in order of first occurrence. */
+    std::vector<kw_name_type> distinct;
+
+    [[nodiscard]] size_t size() const { return offsets.size(); }
+    [[nodiscard]] FileKW at(size_t position) const {
+        return {offsets[position], types[position], sizes[position],
+                names[position]};
+    }
+    /** Appends @file_kw to the arrays; see FileView::update_index(). */
+    void push_back(const FileKW &file_kw);
+    /** The number of bytes allocated by the index. */
+    [[nodiscard]] size_t memory_usage() const;
 };
 
 class FileView {
-    std::vector<std::shared_ptr<FileKW>> kw_list;
-    std::map<std::string, std::vector<size_t>> kw_index;
-    std::vector<std::string>
-        distinct_kw; /* A list of the keywords occuring in the file - each string occurs ONLY ONCE. */
+    std::shared_ptr<FileIndex> index;
+    /* The view is the slice [range_begin, range_end) of the index;
+       range_end is npos for the view owning the index, which grows with
+       it. */
+    size_t range_begin = 0;
+    size_t range_end = std::string::npos;
     std::shared_ptr<FileContext> context;
-    [[nodiscard]] std::shared_ptr<FileKW> get_file_kw(const std::string &kw,
-                                                      size_t ith) const {
-        return get_file_kw(kw_index.at(kw).at(ith));
+
+    using position_range = std::pair<const size_t *, const size_t *>;
+    [[nodiscard]] size_t range_stop() const {
+        return std::min(range_end, index->size());
     }
-    [[nodiscard]] rd_kw_type *get_kw(const std::shared_ptr<FileKW> &file_kw);
+    /** The positions in the index of the occurrences of @kw in the
+        view. */
+    [[nodiscard]] position_range occurrences(const std::string &kw) const;
+    /** The position in the index of the ith=@ith occurrence of @kw;
+        throws std::out_of_range if there is no such keyword. */
+    [[nodiscard]] size_t position(const std::string &kw, size_t ith) const;
+    [[nodiscard]] size_t position(size_t global_index) const {
+        if (global_index >= size())
+            throw std::out_of_range("FileView index out of range");
+        return range_begin + global_index;
+    }
+    [[nodiscard]] std::vector<kw_name_type> distinct_names() const;
+    /** Returns the keyword at @position in the index, loading it if
+        needed. */
+    [[nodiscard]] rd_kw_type *load_kw(size_t position, bool pin = false);
+    /** Opens the stream and registers a load in progress, which keeps the
+        stream open until the matching end_load(). Returns false if the
+        stream could not be opened. */
+    bool begin_load();
+    /** Ends a load registered by begin_load(); the last one closes the
+        stream with FileMode::CLOSE_STREAM, unless @keep_open is set. */
+    void end_load(bool keep_open = false);
+    void preload_positions(std::vector<size_t> positions, size_t threads);
+    KWHandle pin_position(size_t position);
+    bool write_raw(const FileKW &file_kw, ERT::FortIO &target);
     [[nodiscard]] size_t get_occurence(size_t global_index);
 
     /** Finds the occurrence of the first block for which @predicate holds for @header_kw.
@@ -55,87 +265,141 @@ class FileView {
     template <typename Predicate>
     [[nodiscard]] std::optional<size_t> find_block(const std::string &header_kw,
                                                    Predicate predicate) {
-        auto seqnum_it = kw_index.find(SEQNUM_KW);
-        if (seqnum_it == kw_index.end())
-            return std::nullopt;
-        auto header_it = kw_index.find(header_kw);
-        if (header_it == kw_index.end())
-            return std::nullopt;
-
-        const std::vector<size_t> &seqnum_list = seqnum_it->second;
-        const std::vector<size_t> &header_list = header_it->second;
-        auto header_cursor = header_list.begin();
-
-        for (auto start = seqnum_list.begin(); start != seqnum_list.end();
-             ++start) {
+        auto [seqnum_begin, seqnum_end] = occurrences(SEQNUM_KW);
+        auto [header_cursor, header_end] = occurrences(header_kw);
+
+        for (auto start = seqnum_begin; start != seqnum_end; ++start) {
             auto next = std::next(start);
             const size_t block_end =
-                (next != seqnum_list.end()) ? *next : kw_list.size();
+                (next != seqnum_end) ? *next : range_stop();
 
             // Advance to the first header keyword inside this block.
-            while (header_cursor != header_list.end() &&
-                   *header_cursor < *start)
+            while (header_cursor != header_end && *header_cursor < *start)
                 ++header_cursor;
 
-            if (header_cursor == header_list.end())
+            if (header_cursor == header_end)
                 break;
 
-            if (*header_cursor < block_end && predicate(get_kw(*header_cursor)))
-                return static_cast<size_t>(
-                    std::distance(seqnum_list.begin(), start));
+            if (*header_cursor < block_end &&
+                predicate(load_kw(*header_cursor)))
+                return static_cast<size_t>(std::distance(seqnum_begin, start));
         }
         return std::nullopt;
     }
 
 public:
     explicit FileView(std::shared_ptr<FileContext> context)
-        : context(std::move(context)) {};
+        : index(std::make_shared<FileIndex>()), context(std::move(context)) {};
 
     [[nodiscard]] bool has_flags(FileMode flags) const;
     bool drop_flags(FileMode flags);
     void add_flag(FileMode flag);
 
     [[nodiscard]] const std::string &filename() const;
-    [[nodiscard]] std::shared_ptr<FileKW>
-    get_file_kw(size_t global_index) const {
-        return kw_list.at(global_index);
+    [[nodiscard]] FileKW get_file_kw(size_t global_index) const {
+        return index->at(position(global_index));
+    }
+    /** The ith=@ith occurrence of @kw; throws std::out_of_range if there
+        is no such keyword. */
+    [[nodiscard]] FileKW get_file_kw(const std::string &kw, size_t ith) const {
+        return index->at(position(kw, ith));
+    }
+    /** The keyword at @global_index if it is loaded, otherwise nullptr. */
+    [[nodiscard]] rd_kw_type *get_loaded_kw(size_t global_index) const;
+    [[nodiscard]] std::vector<std::string> get_distinct_kw() const;
+    [[nodiscard]] size_t num_distinct_kw() const {
+        return distinct_names().size();
     }
-    [[nodiscard]] auto begin() { return kw_list.begin(); }
-    [[nodiscard]] auto end() { return kw_list.end(); }
-    [[nodiscard]] std::vector<std::string> get_distinct_kw() const {
-        return distinct_kw;
+    [[nodiscard]] size_t size() const { return range_stop() - range_begin; }
+    /** The number of bytes allocated by the index of the file, which is
+        shared by the views of the file. */
+    [[nodiscard]] size_t index_memory_usage() const {
+        return index->memory_usage();
     }
-    [[nodiscard]] size_t num_distinct_kw() const { return distinct_kw.size(); }
-    [[nodiscard]] size_t size() const { return kw_list.size(); }
     [[nodiscard]] size_t num_named_kw(const std::string &kw) const {
-        auto it = kw_index.find(kw);
-        return (it != kw_index.end()) ? it->second.size() : 0;
+        auto [first, last] = occurrences(kw);
+        return static_cast<size_t>(last - first);
     }
 
-    void add_kw(std::shared_ptr<FileKW> file_kw) {
-        kw_list.push_back(std::move(file_kw));
-    }
+    /** Appends @file_kw to the view; only for the view which owns the
+        index, i.e. not for blockviews. */
+    void add_kw(const FileKW &file_kw) { index->push_back(file_kw); }
 
     /** Builds the internal index.
 
-        Must be called every time the content of the kw_list vector is
-        modified (otherwise the rd_file instance will be in an
-        inconsistent state). */
+        Must be called every time keywords are added to the view
+        (otherwise the rd_file instance will be in an inconsistent
+        state). */
     void make_index();
+    /** Adds the keywords from position @first in the view to the index.
+
+        Used instead of make_index() when keywords have only been appended
+        to the view since the index was last built. */
+    void update_index(size_t first);
 
     [[nodiscard]] bool has_kw(const std::string &kw) const {
-        return kw_index.find(kw) != kw_index.end();
+        return num_named_kw(kw) > 0;
     }
-    rd_kw_type *get_kw(size_t index) { return get_kw(get_file_kw(index)); }
+    rd_kw_type *get_kw(size_t index) { return load_kw(position(index)); }
     rd_kw_type *get_kw(const std::string &kw, size_t ith) {
-        return get_kw(get_file_kw(kw, ith));
+        return load_kw(position(kw, ith));
     }
-
+    /** As get_kw(), and pins the keyword while the returned handle exists.
+
+        With a memory budget, see File::set_memory_budget(), the rd_kw
+        returned by get_kw() is only valid until another keyword of the
+        file is loaded; use pin_kw() for keywords which are kept for longer.
+        Returns an empty handle if the keyword could not be loaded. */
+    KWHandle pin_kw(size_t index) { return pin_position(position(index)); }
+    KWHandle pin_kw(const std::string &kw, size_t ith) {
+        return pin_position(position(kw, ith));
+    }
+    /** Opens a scope which keeps the keywords returned by the file loaded
+        until it is closed, see KWScope; this covers all the views of the
+        file. */
+    [[nodiscard]] KWScope scope() const { return KWScope(context); }
+
+    /** Loads all the occurrences of the keywords named in @kws, using a
+        pool of @threads worker threads; with threads == 0 the number of
+        hardware threads is used. Names which are not in the view are
+        ignored.
+
+        The workers pick the keywords in order of file offset, so the
+        file is read close to sequentially. If a keyword can not be
+        loaded the remaining keywords are skipped and the first exception
+        is rethrown. */
+    void preload(const std::vector<std::string> &kws, size_t threads = 0);
+    /** As preload(), for all the keywords in the view. */
+    void preload_all(size_t threads = 0);
+
+    /** Reads the data of the ith=@ith occurrence of @kw into @target,
+        which holds get_size() elements of @target_type; @target_type is
+        the type of the keyword, or RD_DOUBLE for a float keyword.
+
+        The data is decoded from the file straight into @target, and the
+        keyword is neither loaded nor cached; if the keyword is already
+        loaded the data is copied from it instead, including any changes
+        made to it. Throws std::out_of_range if there is no such keyword,
+        std::invalid_argument for other types and std::runtime_error if
+        the keyword can not be read. */
+    void read_into(const std::string &kw, size_t ith, void *target,
+                   rd_data_type target_type);
     void index_fload_kw(const std::string &kw, int index,
                         const int_vector_type *index_map, char *io_buffer);
+    /** Starts reading the ith=@ith occurrence of @kw into the page cache
+        in the background, see ERT::FortIO::will_need(). Does nothing for
+        formatted files. */
+    void will_need(const std::string &kw, size_t ith) const;
+    /** Writes the keywords from position @offset to @target. Keywords
+        which are not loaded are copied without decoding them when the
+        files share format and byte order.
+
+        Throws std::logic_error if the file was opened with a keyword
+        filter, as the copy would silently lack the filtered keywords. */
     void write(ERT::FortIO &target, size_t offset);
 
-    /** Creates a FileView with keywords from @start_kw to @end_kw.
+    /** Creates a FileView with keywords from @start_kw to @end_kw. The
+        new view shares the index of this view.
 
         Will go from the ith=@occurence keyword named @start_kw to the
         the first keyword named @end_kw. Returns nullptr if there is no such
@@ -190,6 +454,8 @@ public:
     static std::shared_ptr<FileView> read(std::shared_ptr<FileContext> context,
                                           std::istream &istream);
 
+    /** Drops the loaded keywords of this view, except the pinned ones.
+        Note: previous pointers to the dropped kws are invalidated. */
     void clear();
 };
 } // namespace rd
@@ -38,9 +38,17 @@ typedef enum { RD_KW_READ_OK = 0, RD_KW_READ_FAIL = 1 } rd_read_status_enum;
 #define RD_KW_HEADER_DATA_SIZE RD_STRING8_LENGTH + RD_TYPE_LENGTH + 4
 #define RD_KW_HEADER_FORTIO_SIZE RD_KW_HEADER_DATA_SIZE + 8
 
+/*
+  When reading a selection of elements with rd_kw_fread_indexed_data()
+  elements which are at most this many bytes apart in the file are
+  fetched with one contiguous read instead of one seek + read each.
+*/
+#define RD_KW_FREAD_INDEXED_MAX_GAP 8192
+
 int rd_kw_first_different(const rd_kw_type *kw1, const rd_kw_type *kw2,
                           int offset, double abs_epsilon, double rel_epsilon);
 size_t rd_kw_fortio_size(const rd_kw_type *rd_kw);
+size_t rd_kw_fortio_size__(rd_data_type data_type, int element_count);
 void *rd_kw_get_ptr(const rd_kw_type *rd_kw);
 void rd_kw_set_data_ptr(rd_kw_type *rd_kw, void *data);
 void rd_kw_fwrite_data(const rd_kw_type *_rd_kw, ERT::FortIO &fortio);
@@ -54,10 +62,20 @@ bool rd_kw_fseek_kw(const char *, bool, bool, ERT::FortIO &);
 void rd_kw_fskip(ERT::FortIO &);
 bool rd_kw_fread_realloc(rd_kw_type *, ERT::FortIO &);
 rd_kw_type *rd_kw_fread_alloc(ERT::FortIO &);
+rd_kw_type *rd_kw_pread_alloc(const ERT::FortIO &, offset_type offset);
 rd_kw_type *rd_kw_alloc_actnum(const rd_kw_type *porv_kw, float porv_limit);
-void rd_kw_fread_indexed_data(ERT::FortIO &fortio, offset_type kw_offset,
-                              rd_data_type, int element_count,
-                              const int_vector_type *index_map, char *buffer);
+void rd_kw_get_data_into(const rd_kw_type *rd_kw, void *target,
+                         rd_data_type target_type);
+void rd_kw_fread_data_into(ERT::FortIO &fortio, offset_type kw_offset,
+                           rd_data_type data_type, int element_count,
+                           void *target, rd_data_type target_type);
+bool rd_kw_pread_data_into(const ERT::FortIO &fortio, offset_type kw_offset,
+                           rd_data_type data_type, int element_count,
+                           void *target, rd_data_type target_type);
+void rd_kw_fread_indexed_data(
+    ERT::FortIO &fortio, offset_type kw_offset, rd_data_type,
+    int element_count, const int_vector_type *index_map, char *buffer,
+    offset_type max_gap = RD_KW_FREAD_INDEXED_MAX_GAP);
 void rd_kw_free(rd_kw_type *);
 rd_kw_type *rd_kw_alloc_copy(const rd_kw_type *);
 rd_kw_type *rd_kw_alloc_sub_copy(const rd_kw_type *src, const char *new_kw,
@@ -0,0 +1,159 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rd {
+
+/** Counters of a KWAllocator, see KWAllocator::stats(). */
+struct KWAllocationStats {
+    /** Number of buffers handed out. */
+    size_t allocations = 0;
+    /** Number of buffers given back. */
+    size_t deallocations = 0;
+    /** Total size in bytes of the buffers handed out. */
+    size_t bytes_allocated = 0;
+    /** Size in bytes of the buffers currently handed out. */
+    size_t bytes_in_use = 0;
+    /** The largest value of bytes_in_use. */
+    size_t peak_bytes_in_use = 0;
+    /** Number of blocks requested from the system, or from the upstream
+        allocator of a KWPool. */
+    size_t system_allocations = 0;
+};
+
+/** The storage of the data of rd_kw instances.
+
+    Each keyword remembers the allocator its data came from, and gives the
+    data back to it when it is freed or resized; new keywords take their
+    data from current_kw_allocator(). The allocate() and deallocate()
+    functions keep the counters returned by stats(), and call the
+    do_allocate() and do_deallocate() of the implementation. */
+class KWAllocator {
+public:
+    KWAllocator() = default;
+    KWAllocator(const KWAllocator &) = delete;
+    KWAllocator &operator=(const KWAllocator &) = delete;
+    virtual ~KWAllocator() = default;
+
+    /** A buffer of @bytes bytes; throws std::bad_alloc on failure. */
+    void *allocate(size_t bytes);
+    /** Gives back @ptr, which was allocated with @bytes bytes. */
+    void deallocate(void *ptr, size_t bytes);
+
+    [[nodiscard]] KWAllocationStats stats() const;
+
+protected:
+    virtual void *do_allocate(size_t bytes) = 0;
+    /** Called last by deallocate(), so it may destroy the allocator. */
+    virtual void do_deallocate(void *ptr, size_t bytes) = 0;
+    void count_system_allocation() { system_allocations++; }
+
+private:
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<size_t> bytes_allocated{0};
+    std::atomic<size_t> bytes_in_use{0};
+    std::atomic<size_t> peak_bytes_in_use{0};
+    std::atomic<size_t> system_allocations{0};
+};
+
+/** Allocates every buffer from the system, aligned to alignment bytes so
+    that the loops over the elements start on a cache line.
+
+    Buffers of at least huge_page_threshold() bytes are aligned to, and
+    sized in multiples of, huge_page_size, and advised to be backed by
+    transparent huge pages where the platform supports madvise(). */
+class AlignedKWAllocator : public KWAllocator {
+public:
+    static constexpr size_t alignment = 64;
+    static constexpr size_t huge_page_size = size_t(2) << 20;
+
+    /** Enables huge pages for buffers of at least @bytes bytes, or
+        disables them with @bytes == 0, which is the default. */
+    void set_huge_page_threshold(size_t bytes) { huge_pages_from = bytes; }
+    [[nodiscard]] size_t huge_page_threshold() const {
+        return huge_pages_from;
+    }
+
+protected:
+    void *do_allocate(size_t bytes) override;
+    void do_deallocate(void *ptr, size_t bytes) override;
+
+private:
+    std::atomic<size_t> huge_pages_from{0};
+};
+
+/** Hands out small buffers from chunks shared by many keywords, with one
+    free list for each power of two size class up to max_block_size;
+    larger buffers are forwarded to the upstream allocator.
+
+    Each rd::File has a pool for the keywords it loads, so that the many
+    small keywords of a restart step, INTEHEAD, LOGIHEAD, IWEL, ZWEL and
+    so on, do not take one system allocation each. The chunks are given
+    back to the upstream allocator when both the pool has been released
+    by its owner and the last buffer from it has been deallocated, so
+    keywords may outlive the file they were loaded from. */
+class KWPool : public KWAllocator {
+public:
+    static constexpr size_t min_block_size = 16;
+    static constexpr size_t max_block_size = 4096;
+    static constexpr size_t chunk_size = size_t(64) << 10;
+
+    /** A new pool, which is released when the returned pointer is
+        destroyed. @upstream must outlive the pool. */
+    static std::shared_ptr<KWPool> create(KWAllocator &upstream);
+    static std::shared_ptr<KWPool> create();
+
+protected:
+    void *do_allocate(size_t bytes) override;
+    void do_deallocate(void *ptr, size_t bytes) override;
+
+private:
+    static constexpr size_t num_classes = 9;
+    static_assert(min_block_size << (num_classes - 1) == max_block_size);
+
+    explicit KWPool(KWAllocator &upstream) : upstream(upstream) {}
+    ~KWPool() override;
+    static size_t size_class(size_t bytes);
+    /* A new block of @block_size bytes from the chunks, with mutex held. */
+    void *carve(size_t block_size);
+    /* Drops one reference; the owner holds one, and each buffer handed
+       out holds one, as the keyword gives it back through the pool. */
+    void release();
+
+    KWAllocator &upstream;
+    std::mutex mutex;
+    /* The free blocks of each size class, linked through their first
+       bytes. */
+    std::array<void *, num_classes> free_blocks{};
+    std::vector<void *> chunks;
+    char *chunk_next = nullptr;
+    char *chunk_end = nullptr;
+    std::atomic<size_t> references{1};
+};
+
+/** The allocator shared by all keywords which are not created inside a
+    ScopedKWAllocator. */
+AlignedKWAllocator &default_kw_allocator();
+
+/** The allocator used for the data of keywords created by this thread. */
+KWAllocator &current_kw_allocator();
+
+/** Makes @allocator the current_kw_allocator() of this thread while the
+    object exists. */
+class ScopedKWAllocator {
+public:
+    explicit ScopedKWAllocator(KWAllocator &allocator);
+    ScopedKWAllocator(const ScopedKWAllocator &) = delete;
+    ScopedKWAllocator &operator=(const ScopedKWAllocator &) = delete;
+    ~ScopedKWAllocator();
+
+private:
+    KWAllocator *previous;
+};
+
+} // namespace rd
@@ -0,0 +1,73 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <resdata/FortIO.hpp>
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_type.hpp>
+
+namespace rd {
+
+/** A read-only keyword in a memory mapped file, see
+    ERT::FortIO::mmap_file(), which uses the data in the mapping instead
+    of reading it into a keyword of its own.
+
+    The data records can always be reached in their on-disk form through
+    records(). get() returns the data as a keyword: where the records
+    can be used as they are, the keyword borrows its data from the
+    mapping. That is the case for int, float and double data in a single
+    record, i.e. at most 1000 elements as blocked by rd_kw_fwrite(), in
+    host byte order and suitably aligned in the file. For all other
+    keywords, which includes all numeric keywords on a little endian
+    host since the files are big endian, the first call to get() decodes
+    a shadow copy from the mapping, and later calls return that copy.
+
+    The MappedKW refers to the @fortio instance and its mapping, and
+    must not be used after the file has been unmapped or remapped by
+    ERT::FortIO::update_size(). The mapping is read-only, so the keyword
+    from get() must not be modified. */
+class MappedKW {
+public:
+    /** The data of @count elements starting at element @first, in
+        on-disk representation. */
+    struct Record {
+        int first;
+        int count;
+        const char *data;
+    };
+
+    /** Throws std::invalid_argument if @fortio is not mapped, and
+        std::runtime_error if there is no complete keyword at @offset. */
+    MappedKW(const ERT::FortIO &fortio, offset_type offset);
+    MappedKW(const MappedKW &) = delete;
+    MappedKW &operator=(const MappedKW &) = delete;
+
+    [[nodiscard]] const std::string &header() const { return m_header; }
+    [[nodiscard]] int size() const { return m_size; }
+    [[nodiscard]] rd_data_type data_type() const { return m_data_type; }
+    [[nodiscard]] const std::vector<Record> &records() const {
+        return m_records;
+    }
+    /** Whether get() returns a keyword borrowing the mapped data. */
+    [[nodiscard]] bool borrowed() const { return m_borrowed; }
+
+    const rd_kw_type *get() const;
+
+private:
+    MappedKW(const ERT::FortIO &fortio, offset_type offset,
+             const char *header);
+
+    const ERT::FortIO &m_fortio;
+    offset_type m_offset;
+    std::string m_header;
+    int m_size;
+    rd_data_type m_data_type;
+    std::vector<Record> m_records;
+    bool m_borrowed = false;
+
+    mutable std::once_flag m_load_once;
+    mutable rd_kw_ptr m_kw{nullptr, rd_kw_free};
+};
+
+} // namespace rd
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_type.hpp>
+
+namespace rd {
+
+template <typename T> struct kw_element_type;
+template <> struct kw_element_type<int> {
+    static constexpr rd_type_enum value = RD_INT_TYPE;
+};
+template <> struct kw_element_type<float> {
+    static constexpr rd_type_enum value = RD_FLOAT_TYPE;
+};
+template <> struct kw_element_type<double> {
+    static constexpr rd_type_enum value = RD_DOUBLE_TYPE;
+};
+template <> struct kw_element_type<bool> {
+    static constexpr rd_type_enum value = RD_BOOL_TYPE;
+};
+
+/** The data of a keyword as a contiguous array of T, which is int,
+    float, double or bool, possibly const qualified.
+
+    The type of the keyword is checked once when the view is created,
+    so that loops over the elements index plain memory, instead of going
+    through rd_kw_iget_*() for every element. The view does not own the
+    keyword, and is invalidated when the keyword is resized or freed. */
+template <typename T> class KWView {
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+    using iterator = T *;
+    using kw_pointer = std::conditional_t<std::is_const_v<T>,
+                                          const rd_kw_type *, rd_kw_type *>;
+
+    /** Throws std::invalid_argument unless @kw holds value_type elements. */
+    explicit KWView(kw_pointer kw) {
+        if (rd_kw_get_type(kw) != kw_element_type<value_type>::value)
+            throw std::invalid_argument(
+                std::string("KWView: keyword ") + rd_kw_get_header(kw) +
+                " is of type " + rd_type_name(rd_kw_get_data_type(kw)));
+        elements = static_cast<T *>(rd_kw_get_ptr(kw));
+        count = static_cast<size_t>(rd_kw_get_size(kw));
+    }
+
+    [[nodiscard]] T *data() const { return elements; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    iterator begin() const { return elements; }
+    iterator end() const { return elements + count; }
+
+    T &operator[](size_t index) const { return elements[index]; }
+    /** As operator[], but throws std::out_of_range for an index outside
+        the keyword. */
+    T &at(size_t index) const {
+        if (index >= count)
+            throw std::out_of_range("KWView: index " + std::to_string(index) +
+                                    " outside keyword of size " +
+                                    std::to_string(count));
+        return elements[index];
+    }
+
+private:
+    T *elements;
+    size_t count;
+};
+
+/** Calls @f with a KWView<const int>, KWView<const float> or
+    KWView<const double> of @kw, depending on its type, and returns the
+    result; @f is typically a generic lambda, so that the type of the
+    keyword is looked up once per call rather than once per element.
+    Throws std::invalid_argument for other types of keywords. */
+template <typename F> decltype(auto) visit_kw(const rd_kw_type *kw, F &&f) {
+    switch (rd_kw_get_type(kw)) {
+    case RD_INT_TYPE:
+        return f(KWView<const int>(kw));
+    case RD_FLOAT_TYPE:
+        return f(KWView<const float>(kw));
+    case RD_DOUBLE_TYPE:
+        return f(KWView<const double>(kw));
+    default:
+        throw std::invalid_argument(
+            std::string("visit_kw: keyword ") + rd_kw_get_header(kw) +
+            " is not numeric, but of type " +
+            rd_type_name(rd_kw_get_data_type(kw)));
+    }
+}
+
+/** As visit_kw() above, with views of mutable elements. */
+template <typename F> decltype(auto) visit_kw(rd_kw_type *kw, F &&f) {
+    switch (rd_kw_get_type(kw)) {
+    case RD_INT_TYPE:
+        return f(KWView<int>(kw));
+    case RD_FLOAT_TYPE:
+        return f(KWView<float>(kw));
+    case RD_DOUBLE_TYPE:
+        return f(KWView<double>(kw));
+    default:
+        throw std::invalid_argument(
+            std::string("visit_kw: keyword ") + rd_kw_get_header(kw) +
+            " is not numeric, but of type " +
+            rd_type_name(rd_kw_get_data_type(kw)));
+    }
+}
+
+} // namespace rd
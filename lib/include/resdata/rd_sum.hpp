@@ -109,6 +109,22 @@ rd_smspec_var_type rd_sum_identify_var_type(const char *var);
 int rd_sum_iget_report_end(const rd_sum_type *rd_sum, int report_step);
 void rd_sum_set_case(rd_sum_type *rd_sum, const std::string &input_arg);
 void rd_sum_fwrite(const rd_sum_type *rd_sum);
+/**
+   Writes a transposed (column major) copy of the UNSMRY file of the case
+   next to it. While the copy is up to date it is used automatically when
+   the case is loaded, and a single vector can be read without scanning the
+   UNSMRY file. Only the case itself is written, not its restart chain.
+
+   Throws std::invalid_argument if the case is not unified.
+*/
+void rd_sum_fwrite_transposed(const rd_sum_type *rd_sum);
+/**
+   Appends the ministeps which have been written to the UNSMRY file of the
+   case since it was loaded, and returns the number of new ministeps. The
+   SMSPEC file and the data which has already been loaded are not read
+   again. Cases with non-unified summary files are not refreshed.
+*/
+int rd_sum_refresh(rd_sum_type *rd_sum);
 bool rd_sum_can_write(const rd_sum_type *rd_sum);
 const rd::smspec_node *rd_sum_add_smspec_node(rd_sum_type *rd_sum,
                                               const rd::smspec_node *node);
@@ -147,6 +163,9 @@ void rd_sum_init_double_vector_interp(const rd_sum_type *rd_sum,
                                       double *data);
 void rd_sum_init_double_vector(const rd_sum_type *rd_sum, const char *gen_key,
                                double *data);
+void rd_sum_init_double_frame(const rd_sum_type *rd_sum,
+                              const rd_sum_vector_type *keywords,
+                              double *data);
 void rd_sum_init_double_frame_interp(const rd_sum_type *rd_sum,
                                      const rd_sum_vector_type *keywords,
                                      const time_t_vector_type *time_points,
@@ -24,6 +24,7 @@ void rd_sum_data_fwrite(const rd_sum_data_type *data, const char *rd_case,
 bool rd_sum_data_can_write(const rd_sum_data_type *data);
 bool rd_sum_data_fread(rd_sum_data_type *data, const stringlist_type *filelist,
                        bool lazy_load, FileMode file_options);
+int rd_sum_data_refresh(rd_sum_data_type *data);
 rd_sum_data_type *rd_sum_data_alloc_writer(rd_smspec_type *smspec);
 rd_sum_data_type *rd_sum_data_alloc(rd_smspec_type *smspec);
 double rd_sum_data_time2days(const rd_sum_data_type *data, time_t sim_time);
@@ -86,6 +87,9 @@ double_vector_type *
 rd_sum_data_alloc_seconds_solution(const rd_sum_data_type *data,
                                    const rd::smspec_node &node, double value,
                                    bool rates_clamp_lower);
+void rd_sum_data_init_double_frame(const rd_sum_data_type *data,
+                                   const rd_sum_vector_type *keywords,
+                                   double *output_data);
 void rd_sum_data_init_double_frame_interp(const rd_sum_data_type *data,
                                           const rd_sum_vector_type *keywords,
                                           const time_t_vector_type *time_points,
@@ -19,6 +19,18 @@ rd_sum_tstep_type *rd_sum_tstep_alloc_from_file(int report_step,
                                                 const rd_kw_type *params_kw,
                                                 const char *src_file,
                                                 const rd_smspec_type *smspec);
+rd_sum_tstep_type *rd_sum_tstep_alloc_from_data(int report_step,
+                                                int ministep_nr,
+                                                const float *data,
+                                                const rd_smspec_type *smspec);
+
+/*
+  Extracts the time of the PARAMS row @params, from the TIME/DAYS vector
+  if the case has one, and otherwise from the DAY, MONTH and YEAR vectors.
+*/
+void rd_sum_tstep_time_from_params(const rd_smspec_type *smspec,
+                                   const float *params, time_t *sim_time,
+                                   double *sim_seconds);
 
 rd_sum_tstep_type *rd_sum_tstep_alloc_new(int report_step, int ministep,
                                           float sim_seconds,
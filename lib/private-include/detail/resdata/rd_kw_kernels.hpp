@@ -0,0 +1,249 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+  Typed kernels for the element wise arithmetic of rd_kw.
+
+  The loops work on blocks of a fixed number of elements, with the
+  pointers marked __restrict, so that the compiler vectorises them also
+  at -O2, where only loops without a scalar remainder are vectorised;
+  the remainder of the array is handled by a separate scalar loop.
+  Arrays of at least parallel_threshold elements are split in ranges
+  which are processed by separate threads.
+*/
+namespace rd::kernels {
+
+constexpr size_t block_size = 64;
+constexpr size_t parallel_threshold = size_t(1) << 20;
+/* The smallest range handed to a thread. */
+constexpr size_t parallel_min_range = size_t(1) << 18;
+
+/* Calls @f(begin, end) for ranges covering [0, size), on several threads
+   for large @size. The ranges start at multiples of block_size. If no
+   more threads can be started, the remaining ranges are processed by the
+   calling thread. */
+template <typename F> void parallel_for(size_t size, F &&f) {
+    size_t threads = 1;
+    if (size >= parallel_threshold)
+        threads = std::min<size_t>(
+            std::max(1u, std::thread::hardware_concurrency()),
+            size / parallel_min_range);
+    if (threads <= 1) {
+        f(size_t(0), size);
+        return;
+    }
+
+    size_t range = (size / threads + block_size - 1) / block_size * block_size;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    size_t begin = range;
+    try {
+        for (; begin < size; begin += range)
+            workers.emplace_back(f, begin, std::min(size, begin + range));
+    } catch (const std::system_error &) {
+        for (; begin < size; begin += range)
+            f(begin, std::min(size, begin + range));
+    }
+    f(size_t(0), std::min(size, range));
+    for (auto &worker : workers)
+        worker.join();
+}
+
+/* data[i] = op(data[i]) */
+template <typename T, typename Op>
+void unary_range(T *__restrict data, size_t begin, size_t end, Op op) {
+    size_t i = begin;
+    for (; i + block_size <= end; i += block_size)
+        for (size_t j = 0; j < block_size; j++)
+            data[i + j] = op(data[i + j]);
+    for (; i < end; i++)
+        data[i] = op(data[i]);
+}
+
+/* target[i] = op(target[i], src[i]) */
+template <typename T, typename Op>
+void binary_range(T *__restrict target, const T *__restrict src, size_t begin,
+                  size_t end, Op op) {
+    size_t i = begin;
+    for (; i + block_size <= end; i += block_size)
+        for (size_t j = 0; j < block_size; j++)
+            target[i + j] = op(target[i + j], src[i + j]);
+    for (; i < end; i++)
+        target[i] = op(target[i], src[i]);
+}
+
+template <typename T, typename Op> void unary(T *data, size_t size, Op op) {
+    parallel_for(size, [data, op](size_t begin, size_t end) {
+        unary_range(data, begin, end, op);
+    });
+}
+
+/* @target and @src may be the same array, as in x *= x. */
+template <typename T, typename Op>
+void binary(T *target, const T *src, size_t size, Op op) {
+    if (target == src) {
+        unary(target, size, [op](T value) { return op(value, value); });
+        return;
+    }
+    parallel_for(size, [target, src, op](size_t begin, size_t end) {
+        binary_range(target, src, begin, end, op);
+    });
+}
+
+/*
+  Index lists, like the cells of a region, are mostly runs of consecutive
+  indices. The runs are handed to the block kernels, so that only the
+  scattered indices are processed one at a time. Duplicate indices are
+  applied in order, as in a plain loop over the list.
+*/
+constexpr size_t min_run = 16;
+
+template <typename RunOp, typename ElementOp>
+void for_each_run(const int *index, size_t size, RunOp run_op,
+                  ElementOp element_op) {
+    size_t i = 0;
+    while (i < size) {
+        size_t run_end = i + 1;
+        while (run_end < size && index[run_end] == index[run_end - 1] + 1)
+            run_end++;
+
+        if (run_end - i >= min_run)
+            run_op(size_t(index[i]), size_t(index[i]) + (run_end - i));
+        else
+            for (size_t k = i; k < run_end; k++)
+                element_op(size_t(index[k]));
+        i = run_end;
+    }
+}
+
+template <typename T, typename Op>
+void binary_indexed(T *target, const T *src, const int *index, size_t size,
+                    Op op) {
+    if (target == src) {
+        for_each_run(
+            index, size,
+            [=](size_t begin, size_t end) {
+                unary_range(target, begin, end,
+                            [op](T value) { return op(value, value); });
+            },
+            [=](size_t i) { target[i] = op(target[i], target[i]); });
+        return;
+    }
+    for_each_run(
+        index, size,
+        [=](size_t begin, size_t end) {
+            binary_range(target, src, begin, end, op);
+        },
+        [=](size_t i) { target[i] = op(target[i], src[i]); });
+}
+
+/*
+  The sums keep block_size partial sums, which are added at the end, and
+  one set per thread for large arrays; the rounding of floating point
+  sums therefore differs from a sequential loop, and is usually smaller.
+*/
+template <typename T>
+T sum_range(const T *__restrict data, size_t begin, size_t end) {
+    T partial[block_size] = {};
+    size_t i = begin;
+    for (; i + block_size <= end; i += block_size)
+        for (size_t j = 0; j < block_size; j++)
+            partial[j] += data[i + j];
+
+    T sum = 0;
+    for (size_t j = 0; j < block_size; j++)
+        sum += partial[j];
+    for (; i < end; i++)
+        sum += data[i];
+    return sum;
+}
+
+template <typename T> T sum(const T *data, size_t size) {
+    if (size < parallel_threshold)
+        return sum_range(data, 0, size);
+
+    std::vector<std::pair<size_t, T>> partial_sums;
+    std::mutex mutex;
+    parallel_for(size, [&](size_t begin, size_t end) {
+        T partial = sum_range(data, begin, end);
+        std::lock_guard<std::mutex> lock(mutex);
+        partial_sums.emplace_back(begin, partial);
+    });
+    /* Added in order of the ranges, so the result does not depend on
+       the order in which the threads finish. */
+    std::sort(partial_sums.begin(), partial_sums.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    T total = 0;
+    for (const auto &partial : partial_sums)
+        total += partial.second;
+    return total;
+}
+
+template <typename T>
+T sum_indexed(const T *data, const int *index, size_t size) {
+    T total = 0;
+    for_each_run(
+        index, size,
+        [&](size_t begin, size_t end) { total += sum_range(data, begin, end); },
+        [&](size_t i) { total += data[i]; });
+    return total;
+}
+
+/*
+  As util_update_<type>_max_min() applied to data[1..size) starting from
+  data[0]: a NaN is ignored unless it is the first element.
+*/
+template <typename T>
+void max_min_range(const T *__restrict data, size_t begin, size_t end,
+                   T first, T &max, T &min) {
+    T lane_max[block_size];
+    T lane_min[block_size];
+    for (size_t j = 0; j < block_size; j++)
+        lane_max[j] = lane_min[j] = first;
+
+    size_t i = begin;
+    for (; i + block_size <= end; i += block_size)
+        for (size_t j = 0; j < block_size; j++) {
+            T value = data[i + j];
+            lane_max[j] = value > lane_max[j] ? value : lane_max[j];
+            lane_min[j] = value < lane_min[j] ? value : lane_min[j];
+        }
+
+    max = min = first;
+    for (size_t j = 0; j < block_size; j++) {
+        max = lane_max[j] > max ? lane_max[j] : max;
+        min = lane_min[j] < min ? lane_min[j] : min;
+    }
+    for (; i < end; i++) {
+        max = data[i] > max ? data[i] : max;
+        min = data[i] < min ? data[i] : min;
+    }
+}
+
+template <typename T>
+void max_min(const T *data, size_t size, T &max, T &min) {
+    const T first = data[0];
+    std::vector<std::pair<T, T>> results;
+    std::mutex mutex;
+    parallel_for(size, [&](size_t begin, size_t end) {
+        T range_max;
+        T range_min;
+        max_min_range(data, begin, end, first, range_max, range_min);
+        std::lock_guard<std::mutex> lock(mutex);
+        results.emplace_back(range_max, range_min);
+    });
+
+    max = min = first;
+    for (const auto &[range_max, range_min] : results) {
+        max = range_max > max ? range_max : max;
+        min = range_min < min ? range_min : min;
+    }
+}
+
+} // namespace rd::kernels
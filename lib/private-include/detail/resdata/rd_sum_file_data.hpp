@@ -97,7 +97,8 @@ private:
     std::vector<std::pair<int, int>> report_map;
 };
 
-class unsmry_loader;
+class summary_loader;
+class tsmry_loader;
 
 class rd_sum_file_data {
 
@@ -109,6 +110,19 @@ public:
     int length_before(time_t end_time) const;
     void get_time(int length, time_t *data);
     void get_data(int params_index, int length, double *data);
+    /*
+      Column major: the value of params_indices[k] at time index t is
+      written to data[k * length + t].
+    */
+    void get_data(const std::vector<int> &params_indices, int length,
+                  double *data);
+    /*
+      As above, for the time indices @time_indices only; the value of
+      params_indices[k] at time_indices[i] is written to
+      data[k * time_indices.size() + i].
+    */
+    void get_data(const std::vector<int> &params_indices,
+                  const std::vector<int> &time_indices, double *data);
     int length() const;
     time_t get_data_start() const;
     time_t get_sim_end() const;
@@ -140,20 +154,70 @@ public:
     void fwrite_multiple(const std::string &rd_case, bool fmt_case) const;
     bool fread(const stringlist_type *filelist, bool lazy_load,
                FileMode file_options = FileMode::DEFAULT);
+    /*
+      Appends the ministeps written to a unified summary file since it was
+      loaded, and returns the number of new ministeps. Data loaded from
+      non-unified files is not refreshed.
+    */
+    int refresh();
 
 private:
+    /* PARAMS rows read by refresh(), before they are appended. */
+    struct ParamsRows {
+        std::vector<float> values;
+        std::vector<IndexNode> time;
+        std::vector<int> ministeps;
+    };
+
     const rd_smspec_type *rd_smspec;
 
     TimeIndex index;
     vector_type *data;
 
-    std::unique_ptr<rd::unsmry_loader> loader;
-
+    /*
+      Eagerly loaded files keep PARAMS as one column major matrix, with
+      room for @column_capacity time steps in each column; the value of
+      params index p at time index t is columns[p * column_capacity + t].
+      The rows are only turned into rd_sum_tstep instances in @data when a
+      new tstep is added.
+    */
+    std::vector<float> columns;
+    size_t column_capacity = 0;
+    std::vector<int> column_ministeps;
+
+    std::unique_ptr<rd::summary_loader> loader;
+
+    /*
+      The unified summary file the data was loaded from. When loaded
+      eagerly @unified_params is the number of PARAMS keywords in the file
+      which have been loaded; refresh() continues the read after the last
+      of them, which starts at @unified_offset and belongs to report step
+      @unified_report_step. The offset is -1 until it is known.
+    */
+    std::string unified_filename;
+    FileMode file_options = FileMode::DEFAULT;
+    size_t unified_params = 0;
+    offset_type unified_offset = -1;
+    int unified_report_step = 0;
+
+    bool columnar() const { return !this->column_ministeps.empty(); }
+    const float *column(int params_index) const;
     void append_tstep(rd_sum_tstep_type *tstep);
     void build_index();
+    void reserve_columns(size_t capacity);
+    void grow_columns(size_t length);
+    void index_columns(const std::vector<IndexNode> &time);
+    bool load_columns(const tsmry_loader &tsmry);
+    void columns_to_tsteps();
+    void append_rows(const ParamsRows &rows);
     void fwrite_report(int report_step, ERT::FortIO &fortio) const;
     bool check_file(rd::File *rd_file);
-    void add_rd_file(int report_step, rd::FileView &summary_view);
+    void set_unified_position(const rd::File &rd_file, size_t num_params);
+    void add_rd_file(int report_step, rd::FileView &summary_view,
+                     std::vector<IndexNode> &time);
+    void add_ministep(int report_step, const rd_kw_type *ministep_kw,
+                      const rd_kw_type *params_kw, const std::string &filename,
+                      ParamsRows &rows);
 };
 
 } // namespace rd
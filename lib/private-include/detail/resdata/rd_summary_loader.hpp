@@ -0,0 +1,46 @@
+#pragma once
+#include <ctime>
+#include <vector>
+
+namespace rd {
+
+/*
+  Lazy access to the data of one summary data file, as used by
+  rd_sum_file_data. The values are addressed with the params index of the
+  smspec the loader was created with.
+*/
+class summary_loader {
+public:
+    virtual ~summary_loader() = default;
+
+    /* Number of ministeps. */
+    virtual int length() const = 0;
+    /*
+      The vectors at @positions, column major; the value of positions[k] at
+      time index t is found at [k * length() + t].
+    */
+    virtual std::vector<double>
+    get_vectors(const std::vector<int> &positions) const = 0;
+    /*
+      The vectors at @positions at the ministeps @time_indices only; the
+      value of positions[k] at time_indices[i] is found at
+      [k * time_indices.size() + i].
+    */
+    virtual std::vector<double>
+    get_values(const std::vector<int> &positions,
+               const std::vector<int> &time_indices) const = 0;
+    virtual double iget(int time_index, int params_index) const = 0;
+    virtual std::vector<int> report_steps(int offset) const = 0;
+    virtual std::vector<time_t> sim_time() const = 0;
+    virtual std::vector<double> sim_seconds() const = 0;
+    virtual time_t iget_sim_time(int time_index) const = 0;
+    virtual double iget_sim_seconds(int time_index) const = 0;
+    /*
+      Picks up the ministeps appended to the file since the loader was
+      created or last refreshed, and returns the number of new ministeps.
+      Returns -1 if the loader reads a snapshot which can not grow.
+    */
+    virtual int refresh() = 0;
+};
+
+} // namespace rd
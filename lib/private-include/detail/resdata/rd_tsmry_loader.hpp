@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <resdata/rd_smspec.hpp>
+#include <resdata/rd_file_flag.hpp>
+
+#include <detail/resdata/rd_summary_loader.hpp>
+
+namespace rd {
+
+/*
+  A transposed summary file is a sidecar to a UNSMRY file holding the same
+  PARAMS data column major: a header, the time axis, an offset table with
+  one entry per params index and then one contiguous block of floats per
+  params index. All values are stored in native byte order.
+
+  The sidecar is written next to the UNSMRY file, see tsmry_filename(), and
+  is only used while it is at least as new as the UNSMRY file and the size
+  of the UNSMRY file matches the size recorded when it was written.
+*/
+std::string tsmry_filename(const std::string &unsmry_file);
+
+/*
+  Writes the transposed sidecar of @unsmry_file. The file is written to a
+  temporary name and renamed in place when complete.
+
+  Throws std::ios_base::failure if the sidecar cannot be written, and
+  std::invalid_argument if the UNSMRY file cannot be loaded with @smspec.
+*/
+void tsmry_fwrite(const rd_smspec_type *smspec, const std::string &unsmry_file);
+
+class tsmry_loader : public summary_loader {
+public:
+    /*
+      Opens the sidecar of @unsmry_file. Throws std::ios_base::failure if
+      it is missing, out of date or does not match @smspec.
+    */
+    tsmry_loader(const rd_smspec_type *smspec, const std::string &unsmry_file,
+                 FileMode file_options = FileMode::DEFAULT);
+
+    int length() const override;
+    std::vector<double>
+    get_vectors(const std::vector<int> &positions) const override;
+    std::vector<double>
+    get_values(const std::vector<int> &positions,
+               const std::vector<int> &time_indices) const override;
+    double iget(int time_index, int params_index) const override;
+    std::vector<int> report_steps(int offset) const override;
+    std::vector<time_t> sim_time() const override;
+    std::vector<double> sim_seconds() const override;
+    time_t iget_sim_time(int time_index) const override;
+    double iget_sim_seconds(int time_index) const override;
+    /* The sidecar is a snapshot of the UNSMRY file, and always returns -1. */
+    int refresh() override;
+    const std::vector<int> &ministeps() const { return this->m_ministeps; }
+
+    /*
+      Reads all the data into @columns, which must have room for
+      params size * length() floats, laid out as in the file.
+    */
+    void read_columns(float *columns) const;
+
+private:
+    std::string filename;
+    FileMode file_options;
+    int size; //Number of entries in the smspec index
+    int m_length;
+
+    std::vector<time_t> m_sim_time;
+    std::vector<double> m_sim_seconds;
+    std::vector<int> m_report_steps;
+    std::vector<int> m_ministeps;
+    std::vector<int64_t> offsets;
+
+    mutable std::ifstream stream;
+
+    std::ifstream &open_stream() const;
+    void read_block(int64_t offset, float *data, size_t count) const;
+};
+
+} // namespace rd
@@ -9,22 +9,38 @@
 #include <resdata/rd_file_flag.hpp>
 #include <resdata/rd_file_view.hpp>
 
+#include <detail/resdata/rd_summary_loader.hpp>
+
 namespace rd {
 
-class unsmry_loader {
+class unsmry_loader : public summary_loader {
 public:
     unsmry_loader(const rd_smspec_type *smspec, const std::string &filename,
                   FileMode file_options = FileMode::DEFAULT);
 
     std::vector<double> get_vector(int pos) const;
-    std::vector<double> sim_seconds() const;
-    std::vector<time_t> sim_time() const;
-    int length() const;
-
-    time_t iget_sim_time(int time_index) const;
-    double iget_sim_seconds(int time_index) const;
-    std::vector<int> report_steps(int offset) const;
-    double iget(int time_index, int params_index) const;
+    /*
+      Loads the vectors at @positions in one pass over the PARAMS keywords,
+      with one read per PARAMS block. The result is column major, i.e. the
+      value of positions[k] at time index t is found at [k * length() + t].
+    */
+    std::vector<double>
+    get_vectors(const std::vector<int> &positions) const override;
+    /* Reads one PARAMS block for each of @time_indices. */
+    std::vector<double>
+    get_values(const std::vector<int> &positions,
+               const std::vector<int> &time_indices) const override;
+    std::vector<double> sim_seconds() const override;
+    std::vector<time_t> sim_time() const override;
+    int length() const override;
+
+    time_t iget_sim_time(int time_index) const override;
+    double iget_sim_seconds(int time_index) const override;
+    std::vector<int> report_steps(int offset) const override;
+    /* The MINISTEP number of every PARAMS block. */
+    std::vector<int> ministeps() const;
+    double iget(int time_index, int params_index) const override;
+    int refresh() override;
 
 private:
     int size; //Number of entries in the smspec index
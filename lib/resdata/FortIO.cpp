@@ -1,9 +1,13 @@
+#include <exception>
 #include <ios>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <cstdio>
@@ -12,6 +16,30 @@
 
 #include <ert/util/util_unlink.hpp>
 #include <ert/util/util.hpp>
+#include "ert/util/build_config.hpp"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#if defined(HAVE_PREAD) || defined(HAVE_COPY_FILE_RANGE) ||                  \
+    defined(HAVE_WRITEV) || defined(HAVE_MADVISE)
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_WRITEV) || defined(HAVE_PREADV)
+#include <climits>
+#include <sys/uio.h>
+#endif
+
+#if defined(HAVE_POSIX_FADVISE) || defined(HAVE_PREAD)
+#include <fcntl.h>
+#endif
+
+#if defined(HAVE_PREAD) && defined(O_DIRECT)
+#define FORTIO_DIRECT_IO
+#include <future>
+#endif
 
 #include <resdata/FortIO.hpp>
 
@@ -133,7 +161,12 @@ FortIO::FortIO(const std::string &filename, bool fmt_file, bool writable,
     m_stream = stream;
 }
 
-FortIO::~FortIO() { close(); }
+FortIO::~FortIO() {
+    try {
+        close();
+    } catch (const std::ios_base::failure &) {
+    }
+}
 
 FortIO::FortIO(FortIO &&other) noexcept
     : m_stream(std::exchange(other.m_stream, nullptr)),
@@ -143,7 +176,14 @@ FortIO::FortIO(FortIO &&other) noexcept
       m_fopen_mode(std::exchange(other.m_fopen_mode, nullptr)),
       m_stream_owner(std::exchange(other.m_stream_owner, false)),
       m_writable(std::exchange(other.m_writable, false)),
-      m_read_size(std::exchange(other.m_read_size, 0)) {
+      m_read_size(std::exchange(other.m_read_size, 0)),
+      m_map(std::exchange(other.m_map, nullptr)),
+      m_map_size(std::exchange(other.m_map_size, 0)),
+      m_access_hint(std::exchange(other.m_access_hint, AccessHint::NORMAL)),
+      m_buffer(std::move(other.m_buffer)),
+      m_buffer_size(std::exchange(other.m_buffer_size, 0)),
+      m_direct_io(std::exchange(other.m_direct_io, false)),
+      m_direct_writer(std::move(other.m_direct_writer)) {
     other.m_filename = "";
 }
 
@@ -151,7 +191,10 @@ FortIO &FortIO::operator=(FortIO &&other) noexcept {
     if (this == &other)
         return *this;
 
-    close();
+    try {
+        close();
+    } catch (const std::ios_base::failure &) {
+    }
 
     m_stream = std::exchange(other.m_stream, nullptr);
     m_filename = std::move(other.m_filename);
@@ -161,6 +204,13 @@ FortIO &FortIO::operator=(FortIO &&other) noexcept {
     m_stream_owner = std::exchange(other.m_stream_owner, false);
     m_writable = std::exchange(other.m_writable, false);
     m_read_size = std::exchange(other.m_read_size, 0);
+    m_map = std::exchange(other.m_map, nullptr);
+    m_map_size = std::exchange(other.m_map_size, 0);
+    m_access_hint = std::exchange(other.m_access_hint, AccessHint::NORMAL);
+    m_buffer = std::move(other.m_buffer);
+    m_buffer_size = std::exchange(other.m_buffer_size, 0);
+    m_direct_io = std::exchange(other.m_direct_io, false);
+    m_direct_writer = std::move(other.m_direct_writer);
 
     other.m_filename = "";
 
@@ -196,9 +246,20 @@ void FortIO::open(const std::string &filename, std::ios_base::openmode mode,
     m_stream = stream;
     m_fopen_mode = cmode;
     m_read_size = util_fd_size(fileno(m_stream));
+    apply_buffer();
+    apply_access_hint();
 }
 
 void FortIO::close() {
+    std::exception_ptr error;
+    try {
+        finish_direct_write();
+    } catch (const std::ios_base::failure &) {
+        error = std::current_exception();
+    }
+    m_direct_writer.reset();
+
+    munmap_file();
     if (m_stream && m_stream_owner)
         fclose(m_stream);
     m_stream = nullptr;
@@ -207,6 +268,12 @@ void FortIO::close() {
     m_stream_owner = false;
     m_writable = false;
     m_read_size = 0;
+    m_access_hint = AccessHint::NORMAL;
+    m_buffer.reset();
+    m_buffer_size = 0;
+    m_direct_io = false;
+    if (error)
+        std::rethrow_exception(error);
 }
 
 /**
@@ -233,6 +300,7 @@ bool FortIO::looks_like_fortran_file(const char *filename, bool endian_flip) {
 }
 
 bool FortIO::fclose_stream() {
+    finish_direct_write();
     if (m_stream_owner) {
         if (m_stream) {
             int fclose_return = fclose(m_stream);
@@ -250,9 +318,11 @@ bool FortIO::fclose_stream() {
 bool FortIO::fopen_stream() {
     if (m_stream == nullptr) {
         m_stream = fopen(m_filename.c_str(), m_fopen_mode);
-        if (m_stream)
+        if (m_stream) {
+            apply_buffer();
+            apply_access_hint();
             return true;
-        else
+        } else
             return false;
     } else
         return false;
@@ -284,6 +354,7 @@ int FortIO::init_read() {
     int elm_read;
     int record_size;
 
+    finish_direct_write();
     elm_read = fread(&record_size, sizeof(record_size), 1, m_stream);
     if (elm_read == 1) {
         if (m_endian_flip_header)
@@ -323,6 +394,7 @@ void FortIO::data_fseek(offset_type data_offset, size_t data_element,
 }
 
 int FortIO::fclean() {
+    finish_direct_write();
     long current_pos = ::ftell(m_stream);
     if (current_pos == -1)
         return -1;
@@ -386,6 +458,7 @@ int FortIO::fskip_record() {
 }
 
 void FortIO::init_write(int record_size) {
+    finish_direct_write();
     int file_header;
     file_header = record_size;
     if (m_endian_flip_header)
@@ -402,15 +475,433 @@ void FortIO::complete_write(int record_size) {
     util_fwrite_int(file_header, m_stream);
 }
 
+#ifdef FORTIO_DIRECT_IO
+namespace {
+
+/*
+  The direct io mode, see FortIO::set_direct_io(). The file offsets, sizes
+  and memory of the O_DIRECT transfers are aligned to direct_io_alignment,
+  which covers the logical block size of the common devices.
+*/
+constexpr offset_type direct_io_alignment = 4096;
+constexpr size_t direct_io_buffer_size = 8 << 20;
+/* Smaller transfers are not worth opening the file for direct io. */
+constexpr offset_type direct_io_min_size = 1 << 20;
+
+struct aligned_free {
+    void operator()(char *buffer) const { std::free(buffer); }
+};
+using aligned_buffer = std::unique_ptr<char[], aligned_free>;
+
+aligned_buffer alloc_aligned_buffer() {
+    void *buffer = std::aligned_alloc(direct_io_alignment,
+                                      direct_io_buffer_size);
+    if (!buffer)
+        throw std::bad_alloc();
+    return aligned_buffer(static_cast<char *>(buffer));
+}
+
+/*
+  Turns O_DIRECT off for @fd; some file systems accept the flag in open()
+  and then refuse the transfers with EINVAL.
+*/
+bool clear_direct(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && (flags & O_DIRECT) &&
+           fcntl(fd, F_SETFL, flags & ~O_DIRECT) == 0;
+}
+
+/*
+  Returns the number of bytes read, which is short at end of file; a
+  direct read which ends off the alignment has reached the end.
+*/
+ssize_t pread_full(int fd, char *buffer, size_t size, offset_type offset) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t bytes =
+            ::pread(fd, buffer + done, size - done, offset + done);
+        if (bytes < 0 &&
+            (errno == EINTR || (errno == EINVAL && clear_direct(fd))))
+            continue;
+        if (bytes < 0)
+            return -1;
+        if (bytes == 0)
+            break;
+        done += bytes;
+        if ((offset + done) % direct_io_alignment != 0)
+            break;
+    }
+    return done;
+}
+
+ssize_t pwrite_full(int fd, const char *buffer, size_t size,
+                    offset_type offset) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t bytes =
+            ::pwrite(fd, buffer + done, size - done, offset + done);
+        if (bytes < 0 &&
+            (errno == EINTR || (errno == EINVAL && clear_direct(fd))))
+            continue;
+        if (bytes <= 0)
+            return -1;
+        done += bytes;
+    }
+    return done;
+}
+
+/*
+  Reads the @size bytes at @offset in @filename with O_DIRECT, in aligned
+  chunks; the next chunk is read in the background while the current one
+  is used.
+*/
+class DirectReader {
+public:
+    DirectReader(const std::string &filename, offset_type offset,
+                 offset_type size)
+        : m_filename(filename), m_fd(::open(filename.c_str(),
+                                            O_RDONLY | O_DIRECT)),
+          m_begin(offset), m_end(offset + size),
+          m_next_offset(offset - offset % direct_io_alignment) {
+        if (m_fd < 0)
+            return;
+        for (auto &buffer : m_buffers)
+            buffer = alloc_aligned_buffer();
+        start_read();
+    }
+    ~DirectReader() {
+        if (m_pending.valid())
+            m_pending.wait();
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+    DirectReader(const DirectReader &) = delete;
+    DirectReader &operator=(const DirectReader &) = delete;
+
+    [[nodiscard]] bool is_open() const { return m_fd >= 0; }
+
+    /*
+      The next piece of the range, which is valid until the following
+      call; the size is 0 at the end of the range.
+    */
+    std::pair<const char *, size_t> next() {
+        if (!m_pending.valid())
+            return {nullptr, 0};
+
+        const ssize_t bytes = m_pending.get();
+        const char *chunk = m_buffers[m_filling].get();
+        const offset_type chunk_offset = m_chunk_offset;
+        m_filling ^= 1;
+        start_read();
+
+        const offset_type first = std::max(m_begin, chunk_offset);
+        const offset_type last =
+            std::min(m_end, chunk_offset + static_cast<offset_type>(
+                                               direct_io_buffer_size));
+        if (bytes < last - chunk_offset)
+            throw std::ios_base::failure(
+                fmt::format("Failed to read from \"{}\"", m_filename));
+        return {chunk + (first - chunk_offset),
+                static_cast<size_t>(last - first)};
+    }
+
+private:
+    void start_read() {
+        if (m_next_offset >= m_end)
+            return;
+
+        offset_type end = m_end + direct_io_alignment - 1;
+        end -= end % direct_io_alignment;
+        const size_t size = std::min<offset_type>(direct_io_buffer_size,
+                                                  end - m_next_offset);
+        m_pending = std::async(std::launch::async, pread_full, m_fd,
+                               m_buffers[m_filling].get(), size,
+                               m_next_offset);
+        m_chunk_offset = m_next_offset;
+        m_next_offset += size;
+    }
+
+    std::string m_filename;
+    int m_fd;
+    offset_type m_begin;
+    offset_type m_end;
+    offset_type m_next_offset;
+    offset_type m_chunk_offset = 0;
+    aligned_buffer m_buffers[2];
+    int m_filling = 0;
+    std::future<ssize_t> m_pending;
+};
+
+} // namespace
+
+/*
+  Writes a stream of bytes to @filename with O_DIRECT, from the position
+  given to start() until finish(). The bytes are collected in one aligned
+  buffer while the other is written in the background. The first buffer
+  starts at the aligned offset before the position, with the bytes
+  already in the file, and the last bytes which do not fill an aligned
+  block are written through the descriptor of the stream by finish().
+
+  The descriptor and the buffers are kept by the FortIO between the
+  writes, so consecutive writes are collected in the same buffers.
+*/
+class FortIO::DirectWriter {
+public:
+    explicit DirectWriter(const std::string &filename)
+        : m_filename(filename),
+          m_direct_fd(::open(filename.c_str(), O_RDWR | O_DIRECT)) {
+        if (m_direct_fd < 0)
+            return;
+        for (auto &buffer : m_buffers)
+            buffer = alloc_aligned_buffer();
+    }
+    ~DirectWriter() {
+        if (m_pending.valid())
+            m_pending.wait();
+        if (m_direct_fd >= 0)
+            ::close(m_direct_fd);
+    }
+    DirectWriter(const DirectWriter &) = delete;
+    DirectWriter &operator=(const DirectWriter &) = delete;
+
+    [[nodiscard]] bool is_open() const { return m_direct_fd >= 0; }
+    [[nodiscard]] bool active() const { return m_active; }
+    [[nodiscard]] offset_type position() const {
+        return m_buffer_offset + m_used;
+    }
+
+    void start(offset_type position) {
+        m_buffer_offset = position - position % direct_io_alignment;
+        m_used = position - m_buffer_offset;
+        if (m_used > 0 &&
+            pread_full(m_direct_fd, m_buffers[m_current].get(),
+                       direct_io_alignment, m_buffer_offset) <
+                static_cast<ssize_t>(m_used))
+            throw std::ios_base::failure(
+                fmt::format("Failed to read from \"{}\"", m_filename));
+        m_active = true;
+    }
+
+    void put(const char *data, size_t size) {
+        while (size > 0) {
+            size_t bytes = std::min(size, direct_io_buffer_size - m_used);
+            memcpy(m_buffers[m_current].get() + m_used, data, bytes);
+            m_used += bytes;
+            data += bytes;
+            size -= bytes;
+            if (m_used == direct_io_buffer_size)
+                write_buffer(m_used);
+        }
+    }
+
+    /*
+      Writes the remaining bytes, the tail through @fd, and returns the
+      end position.
+    */
+    offset_type finish(int fd) {
+        m_active = false;
+        const offset_type end = position();
+        const size_t tail_size = m_used % direct_io_alignment;
+        const char *tail = m_buffers[m_current].get() + m_used - tail_size;
+        if (m_used > tail_size)
+            write_buffer(m_used - tail_size);
+        wait();
+
+        if (tail_size > 0 &&
+            pwrite_full(fd, tail, tail_size, end - tail_size) !=
+                static_cast<ssize_t>(tail_size))
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+        return end;
+    }
+
+private:
+    void wait() {
+        if (m_pending.valid() &&
+            m_pending.get() != static_cast<ssize_t>(m_pending_size))
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+    }
+
+    void write_buffer(size_t size) {
+        wait();
+        m_pending = std::async(std::launch::async, pwrite_full, m_direct_fd,
+                               m_buffers[m_current].get(), size,
+                               m_buffer_offset);
+        m_pending_size = size;
+        m_buffer_offset += size;
+        m_current ^= 1;
+        m_used = 0;
+    }
+
+    std::string m_filename;
+    int m_direct_fd;
+    bool m_active = false;
+    offset_type m_buffer_offset = 0;
+    aligned_buffer m_buffers[2];
+    int m_current = 0;
+    size_t m_used = 0;
+    std::future<ssize_t> m_pending;
+    size_t m_pending_size = 0;
+};
+#else
+class FortIO::DirectWriter {};
+#endif
+
 void FortIO::fwrite_record(const char *buffer, int record_size) {
+#ifdef FORTIO_DIRECT_IO
+    if (m_direct_writer && m_direct_writer->active()) {
+        int header = record_size;
+        if (m_endian_flip_header)
+            util_endian_flip_vector(&header, sizeof header, 1);
+        m_direct_writer->put(reinterpret_cast<const char *>(&header),
+                             sizeof header);
+        m_direct_writer->put(buffer, record_size);
+        m_direct_writer->put(reinterpret_cast<const char *>(&header),
+                             sizeof header);
+        return;
+    }
+#endif
     init_write(record_size);
     util_fwrite(buffer, 1, record_size, m_stream, __func__);
     complete_write(record_size);
 }
 
-offset_type FortIO::ftell() const { return util_ftell(m_stream); }
+#if defined(HAVE_WRITEV) || defined(HAVE_PREADV)
+#ifdef IOV_MAX
+constexpr int records_max_iov = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+constexpr int records_max_iov = 16;
+#endif
+
+/* Skips the buffers of @next which were transferred in full by a
+   vectored read or write of @bytes, and the transferred part of the first
+   one which was not. */
+static void advance_iov(struct iovec *&next, int &iov_count, size_t bytes) {
+    while (iov_count > 0 && bytes >= next->iov_len) {
+        bytes -= next->iov_len;
+        next++;
+        iov_count--;
+    }
+    if (iov_count > 0) {
+        next->iov_base = static_cast<char *>(next->iov_base) + bytes;
+        next->iov_len -= bytes;
+    }
+}
+#endif
+
+#ifdef HAVE_WRITEV
+/* Gathering the records costs a flush and two seeks of the stream, so
+   writes smaller than this, and than the stream buffer, are buffered. */
+constexpr size_t fwrite_records_min_gather_size = 1 << 20;
+#endif
+
+void FortIO::fwrite_records(const char *buffer, size_t size,
+                            int record_size) {
+    if (size == 0)
+        return;
+    if (record_size <= 0)
+        throw std::invalid_argument(
+            fmt::format("Invalid record size: {}", record_size));
+
+#ifdef FORTIO_DIRECT_IO
+    DirectWriter *writer = nullptr;
+    if (m_direct_writer && m_direct_writer->active())
+        writer = m_direct_writer.get();
+    else if (m_direct_io &&
+             static_cast<offset_type>(size) >= direct_io_min_size)
+        writer = start_direct_write();
+
+    if (writer) {
+        for (size_t offset = 0; offset < size; offset += record_size) {
+            int bytes = static_cast<int>(
+                std::min<size_t>(record_size, size - offset));
+            int header = bytes;
+            if (m_endian_flip_header)
+                util_endian_flip_vector(&header, sizeof header, 1);
+            writer->put(reinterpret_cast<const char *>(&header),
+                        sizeof header);
+            writer->put(buffer + offset, bytes);
+            writer->put(reinterpret_cast<const char *>(&header),
+                        sizeof header);
+        }
+        return;
+    }
+#endif
+
+#ifdef HAVE_WRITEV
+    if (size >= std::max<size_t>({fwrite_records_min_gather_size,
+                                  m_buffer_size, BUFSIZ})) {
+        const size_t num_records = (size + record_size - 1) / record_size;
+        const size_t last_size = size - (num_records - 1) * record_size;
+        int full_size = record_size;
+        int tail_size = static_cast<int>(last_size);
+        if (m_endian_flip_header) {
+            util_endian_flip_vector(&full_size, sizeof full_size, 1);
+            util_endian_flip_vector(&tail_size, sizeof tail_size, 1);
+        }
+
+        // The FILE buffer is flushed, and the records are written to the
+        // file descriptor at the position of the stream.
+        offset_type position = ftell();
+        if (::fflush(m_stream) != 0 ||
+            lseek(fileno(m_stream), position, SEEK_SET) != position)
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+
+        struct iovec iov[records_max_iov];
+        size_t record = 0;
+        while (record < num_records) {
+            int iov_count = 0;
+            size_t bytes = 0;
+            for (; record < num_records &&
+                   iov_count + 3 <= records_max_iov;
+                 record++) {
+                const bool last = record == num_records - 1;
+                const int *header = last ? &tail_size : &full_size;
+                iov[iov_count++] = {const_cast<int *>(header), sizeof(int)};
+                iov[iov_count++] = {
+                    const_cast<char *>(buffer + record * record_size),
+                    last ? last_size : static_cast<size_t>(record_size)};
+                iov[iov_count++] = {const_cast<int *>(header), sizeof(int)};
+                bytes += iov[iov_count - 2].iov_len + 2 * sizeof(int);
+            }
+
+            struct iovec *next = iov;
+            while (bytes > 0) {
+                ssize_t written = ::writev(fileno(m_stream), next, iov_count);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                    throw std::ios_base::failure(
+                        fmt::format("Failed to write to \"{}\"", m_filename));
+
+                position += written;
+                bytes -= written;
+                advance_iov(next, iov_count, written);
+            }
+        }
+        fseek_(position, SEEK_SET);
+        return;
+    }
+#endif
+
+    for (size_t offset = 0; offset < size; offset += record_size)
+        fwrite_record(buffer + offset,
+                      static_cast<int>(std::min<size_t>(record_size,
+                                                        size - offset)));
+}
+
+offset_type FortIO::ftell() const {
+#ifdef FORTIO_DIRECT_IO
+    if (m_direct_writer && m_direct_writer->active())
+        return m_direct_writer->position();
+#endif
+    return util_ftell(m_stream);
+}
 
 bool FortIO::fseek_(offset_type offset, int whence) {
+    finish_direct_write();
     int fseek_return = util_fseek(m_stream, offset, whence);
     if (fseek_return == 0)
         return true;
@@ -464,7 +955,8 @@ bool FortIO::ftruncate(offset_type size) {
 /**
   It is undefined behaviour to call this function for a file
   which has been updated; in that case the util_fd_size() function
-  will return the size of the file *when it was opened*.
+  will return the size of the file *when it was opened*, or when
+  update_size() was last called.
 */
 bool FortIO::read_at_eof() {
     if (ftell() == m_read_size)
@@ -473,6 +965,23 @@ bool FortIO::read_at_eof() {
         return false;
 }
 
+bool FortIO::update_size() {
+    if (!assert_stream_open())
+        return false;
+
+    finish_direct_write();
+    offset_type size = util_fd_size(fileno(m_stream));
+    if (size == m_read_size)
+        return false;
+
+    m_read_size = size;
+    if (m_map) {
+        munmap_file();
+        mmap_file();
+    }
+    return true;
+}
+
 /**
   When this function is called the underlying file is unlinked, and
   the entry will be removed from the filesystem. Subsequent calls which
@@ -483,10 +992,479 @@ void FortIO::fwrite_error() {
         util_unlink(m_filename.c_str());
 }
 
-void FortIO::fflush() const { ::fflush(m_stream); }
-FILE *FortIO::get_FILE() const { return m_stream; }
+bool FortIO::mmap_file() {
+#ifdef HAVE_MMAP
+    if (m_map)
+        return true;
+
+    if (m_writable || m_fmt_file || !m_stream_owner || m_read_size <= 0)
+        return false;
+
+    if (!assert_stream_open())
+        return false;
+
+    void *map = mmap(nullptr, static_cast<size_t>(m_read_size), PROT_READ,
+                     MAP_SHARED, fileno(m_stream), 0);
+    if (map == MAP_FAILED)
+        return false;
+
+    m_map = static_cast<const char *>(map);
+    m_map_size = m_read_size;
+    apply_access_hint();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FortIO::munmap_file() {
+#ifdef HAVE_MMAP
+    if (m_map)
+        munmap(const_cast<char *>(m_map), static_cast<size_t>(m_map_size));
+#endif
+    m_map = nullptr;
+    m_map_size = 0;
+}
+
+void FortIO::advise(AccessHint hint) {
+    m_access_hint = hint;
+    apply_access_hint();
+}
+
+void FortIO::apply_access_hint() const {
+#ifdef HAVE_POSIX_FADVISE
+    if (m_stream) {
+        int advice = POSIX_FADV_NORMAL;
+        if (m_access_hint == AccessHint::SEQUENTIAL)
+            advice = POSIX_FADV_SEQUENTIAL;
+        else if (m_access_hint == AccessHint::RANDOM ||
+                 m_access_hint == AccessHint::STRIDED)
+            advice = POSIX_FADV_RANDOM;
+        posix_fadvise(fileno(m_stream), 0, 0, advice);
+    }
+#endif
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+    if (m_map) {
+        int advice = MADV_NORMAL;
+        if (m_access_hint == AccessHint::SEQUENTIAL)
+            advice = MADV_SEQUENTIAL;
+        else if (m_access_hint == AccessHint::RANDOM ||
+                 m_access_hint == AccessHint::STRIDED)
+            advice = MADV_RANDOM;
+        madvise(const_cast<char *>(m_map), static_cast<size_t>(m_map_size),
+                advice);
+    }
+#endif
+}
+
+void FortIO::will_need(offset_type offset, offset_type size) const {
+    if (offset < 0 || size <= 0)
+        return;
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+    if (m_map) {
+        if (offset >= m_map_size)
+            return;
+        /* madvise() requires a page aligned address */
+        const offset_type page_size = sysconf(_SC_PAGESIZE);
+        const offset_type start = offset - offset % page_size;
+        const offset_type end = std::min(offset + size, m_map_size);
+        madvise(const_cast<char *>(m_map + start),
+                static_cast<size_t>(end - start), MADV_WILLNEED);
+        return;
+    }
+#endif
+
+#ifdef HAVE_POSIX_FADVISE
+    if (m_stream)
+        posix_fadvise(fileno(m_stream), offset, size, POSIX_FADV_WILLNEED);
+#endif
+}
+
+void FortIO::set_buffer_size(size_t size) {
+    if (size == 0 && !m_buffer)
+        return;
+
+    std::unique_ptr<char[]> buffer;
+    if (size > 0)
+        buffer.reset(new char[size]);
+
+    /*
+      setvbuf() may only be called before the first operation on a stream,
+      so an open stream is replaced by a new stream at the same position,
+      which gets the buffer before it is used. A file opened for writing
+      is reopened without truncating it. The old buffer is released after
+      the old stream has been closed.
+    */
+    if (m_stream && m_stream_owner) {
+        finish_direct_write();
+        if (::fflush(m_stream) != 0)
+            throw std::ios_base::failure("Failed to flush FortIO file " +
+                                         m_filename);
+
+        offset_type position = util_ftell(m_stream);
+        const char *mode = m_fopen_mode;
+        if (strcmp(mode, WRITE_MODE_TXT) == 0 ||
+            strcmp(mode, WRITE_MODE_BINARY) == 0)
+            mode = fortio_fopen_readwrite_mode(m_fmt_file);
+
+        FILE *stream = fopen(m_filename.c_str(), mode);
+        if (!stream)
+            throw std::ios_base::failure("Failed to reopen FortIO file " +
+                                         m_filename);
+        if (size > 0)
+            setvbuf(stream, buffer.get(), _IOFBF, size);
+        fclose(m_stream);
+        m_stream = stream;
+        util_fseek(m_stream, position, SEEK_SET);
+        apply_access_hint();
+    }
+    m_buffer = std::move(buffer);
+    m_buffer_size = size;
+}
+
+void FortIO::apply_buffer() {
+    if (m_buffer && m_stream && m_stream_owner)
+        setvbuf(m_stream, m_buffer.get(), _IOFBF, m_buffer_size);
+}
+
+int FortIO::buffer_int(const char *data, offset_type offset) const {
+    int value;
+    memcpy(&value, &data[offset], sizeof value);
+    if (m_endian_flip_header)
+        util_endian_flip_vector(&value, sizeof value, 1);
+    return value;
+}
+
+const char *FortIO::mapped_record(offset_type &offset,
+                                  int &record_size) const {
+    if (!m_map)
+        return nullptr;
+
+    return buffer_record(m_map, m_map_size, offset, record_size);
+}
+
+const char *FortIO::buffer_record(const char *data, offset_type size,
+                                  offset_type &offset,
+                                  int &record_size) const {
+    if (offset < 0)
+        return nullptr;
+
+    if (offset + 4 > size)
+        return nullptr;
+
+    record_size = buffer_int(data, offset);
+    if (record_size < 0)
+        return nullptr;
+
+    offset_type data_offset = offset + 4;
+    offset_type tail_offset = data_offset + record_size;
+    if (tail_offset + 4 > size)
+        return nullptr;
+
+    if (buffer_int(data, tail_offset) != record_size)
+        return nullptr;
+
+    offset = tail_offset + 4;
+    return &data[data_offset];
+}
+
+bool FortIO::can_pread() const {
+    if (m_fmt_file)
+        return false;
+
+    if (m_map)
+        return true;
+
+#ifdef HAVE_PREAD
+    return m_stream != nullptr;
+#else
+    return false;
+#endif
+}
+
+bool FortIO::pread(offset_type offset, char *buffer, size_t size) const {
+    if (offset < 0)
+        return false;
+
+    if (m_map) {
+        if (offset + static_cast<offset_type>(size) > m_map_size)
+            return false;
+        memcpy(buffer, &m_map[offset], size);
+        return true;
+    }
+
+#ifdef HAVE_PREAD
+    if (!m_stream)
+        return false;
+
+    finish_direct_write();
+    int fd = fileno(m_stream);
+    while (size > 0) {
+        ssize_t bytes_read = ::pread(fd, buffer, size, offset);
+        if (bytes_read < 0 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            return false;
+
+        buffer += bytes_read;
+        offset += bytes_read;
+        size -= bytes_read;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+  With preadv(2) the markers of the records are read into a small array
+  and the payloads straight into @buffer, a batch of records per system
+  call; otherwise each record takes three positional reads.
+*/
+bool FortIO::pread_records(offset_type offset, char *buffer, size_t size,
+                           int record_size) const {
+    if (size == 0)
+        return true;
+    if (record_size <= 0)
+        throw std::invalid_argument(
+            fmt::format("Invalid record size: {}", record_size));
+    if (!can_pread() || offset < 0)
+        return false;
+
+    const size_t num_records = (size + record_size - 1) / record_size;
+    auto marker = [&](size_t record) {
+        int bytes = static_cast<int>(
+            std::min<size_t>(record_size, size - record * record_size));
+        if (m_endian_flip_header)
+            util_endian_flip_vector(&bytes, sizeof bytes, 1);
+        return bytes;
+    };
+
+#ifdef HAVE_PREADV
+    if (!m_map) {
+        finish_direct_write();
+        int fd = fileno(m_stream);
+        struct iovec iov[records_max_iov];
+        int markers[2 * (records_max_iov / 3)];
+        size_t record = 0;
+        while (record < num_records) {
+            const size_t first = record;
+            int iov_count = 0;
+            size_t bytes = 0;
+            for (; record < num_records && iov_count + 3 <= records_max_iov;
+                 record++) {
+                size_t payload = std::min<size_t>(record_size,
+                                                  size - record * record_size);
+                int *head = &markers[2 * (record - first)];
+                iov[iov_count++] = {head, sizeof(int)};
+                iov[iov_count++] = {buffer + record * record_size, payload};
+                iov[iov_count++] = {head + 1, sizeof(int)};
+                bytes += payload + 2 * sizeof(int);
+            }
+
+            struct iovec *next = iov;
+            while (bytes > 0) {
+                ssize_t bytes_read = ::preadv(fd, next, iov_count, offset);
+                if (bytes_read < 0 && errno == EINTR)
+                    continue;
+                if (bytes_read <= 0)
+                    return false;
+
+                offset += bytes_read;
+                bytes -= bytes_read;
+                advance_iov(next, iov_count, bytes_read);
+            }
+
+            for (size_t r = first; r < record; r++) {
+                int expected = marker(r);
+                if (markers[2 * (r - first)] != expected ||
+                    markers[2 * (r - first) + 1] != expected)
+                    return false;
+            }
+        }
+        return true;
+    }
+#endif
+
+    for (size_t record = 0; record < num_records; record++) {
+        size_t payload =
+            std::min<size_t>(record_size, size - record * record_size);
+        int head, tail;
+        if (!pread(offset, reinterpret_cast<char *>(&head), sizeof head) ||
+            !pread(offset + 4, buffer + record * record_size, payload) ||
+            !pread(offset + 4 + static_cast<offset_type>(payload),
+                   reinterpret_cast<char *>(&tail), sizeof tail))
+            return false;
+
+        int expected = marker(record);
+        if (head != expected || tail != expected)
+            return false;
+        offset += static_cast<offset_type>(payload) + 8;
+    }
+    return true;
+}
+
+/* Size of the buffer used by fwrite_raw() when copying through memory. */
+constexpr size_t raw_copy_buffer_size = 4 << 20;
+
+bool FortIO::fwrite_raw(FortIO &source, offset_type offset,
+                        offset_type size) {
+    if (source.m_fmt_file != m_fmt_file ||
+        source.m_endian_flip_header != m_endian_flip_header)
+        return false;
+
+    if (offset < 0 || size < 0 || !m_stream || !source.assert_stream_open())
+        return false;
+
+    if (offset + size >
+        static_cast<offset_type>(util_fd_size(fileno(source.m_stream))))
+        return false;
+
+    if (m_direct_io && fwrite_direct(source, offset, size))
+        return true;
+    finish_direct_write();
+
+    if (source.m_map) {
+        if (::fwrite(&source.m_map[offset], 1, size, m_stream) !=
+            static_cast<size_t>(size))
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+        return true;
+    }
+
+#ifdef HAVE_COPY_FILE_RANGE
+    {
+        ::fflush(m_stream);
+        loff_t source_offset = offset;
+        loff_t target_offset = ftell();
+        while (size > 0) {
+            ssize_t copied = copy_file_range(fileno(source.m_stream),
+                                             &source_offset, fileno(m_stream),
+                                             &target_offset, size, 0);
+            if (copied <= 0)
+                break;
+            size -= copied;
+        }
+        // Copies the rest through memory if copy_file_range() is not
+        // supported for these files
+        offset = source_offset;
+        fseek_(target_offset, SEEK_SET);
+    }
+#endif
+
+    std::vector<char> buffer(
+        std::min(static_cast<size_t>(size), raw_copy_buffer_size));
+    while (size > 0) {
+        size_t chunk = std::min(static_cast<size_t>(size), buffer.size());
+        bool read_ok;
+        if (source.can_pread())
+            read_ok = source.pread(offset, buffer.data(), chunk);
+        else
+            read_ok =
+                source.fseek_(offset, SEEK_SET) &&
+                ::fread(buffer.data(), 1, chunk, source.m_stream) == chunk;
+
+        if (!read_ok)
+            throw std::ios_base::failure(
+                fmt::format("Failed to read from \"{}\"", source.m_filename));
+
+        if (::fwrite(buffer.data(), 1, chunk, m_stream) != chunk)
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+
+        offset += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+bool FortIO::fwrite_direct(const FortIO &source, offset_type offset,
+                           offset_type size) {
+#ifdef FORTIO_DIRECT_IO
+    if (size < direct_io_min_size)
+        return false;
+
+    DirectReader reader(source.m_filename, offset, size);
+    if (!reader.is_open())
+        return false;
+
+    DirectWriter *writer = start_direct_write();
+    if (!writer)
+        return false;
+
+    for (auto piece = reader.next(); piece.second > 0; piece = reader.next())
+        writer->put(piece.first, piece.second);
+
+#ifdef HAVE_POSIX_FADVISE
+    // Drops what the scan of the source file left in the page cache
+    posix_fadvise(fileno(source.m_stream), offset, size, POSIX_FADV_DONTNEED);
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+  Returns the direct writer of the file, started at the current position
+  if it is not writing already; nullptr if the file can not be opened
+  for direct io.
+*/
+FortIO::DirectWriter *FortIO::start_direct_write() {
+#ifdef FORTIO_DIRECT_IO
+    if (!m_direct_writer)
+        m_direct_writer = std::make_unique<DirectWriter>(m_filename);
+    if (!m_direct_writer->is_open())
+        return nullptr;
+
+    if (!m_direct_writer->active()) {
+        offset_type position = util_ftell(m_stream);
+        if (::fflush(m_stream) != 0)
+            throw std::ios_base::failure(
+                fmt::format("Failed to write to \"{}\"", m_filename));
+        m_direct_writer->start(position);
+    }
+    return m_direct_writer.get();
+#else
+    return nullptr;
+#endif
+}
+
+/*
+  Writes what the direct writer holds, and moves the stream to the end
+  of it; called before anything else uses the stream.
+*/
+void FortIO::finish_direct_write() const {
+#ifdef FORTIO_DIRECT_IO
+    if (m_direct_writer && m_direct_writer->active())
+        util_fseek(m_stream, m_direct_writer->finish(fileno(m_stream)),
+                   SEEK_SET);
+#endif
+}
+
+void FortIO::set_direct_io(bool direct_io) {
+    if (!direct_io) {
+        finish_direct_write();
+        m_direct_writer.reset();
+    }
+    m_direct_io = direct_io;
+}
+
+void FortIO::fflush() const {
+    finish_direct_write();
+    ::fflush(m_stream);
+}
+FILE *FortIO::get_FILE() const {
+    finish_direct_write();
+    return m_stream;
+}
 bool FortIO::fmt_file() const { return m_fmt_file; }
-void FortIO::rewind() const { util_rewind(m_stream); }
+void FortIO::rewind() const {
+    finish_direct_write();
+    util_rewind(m_stream);
+}
 const char *FortIO::filename_ref() const { return m_filename.c_str(); }
 
 } // namespace ERT
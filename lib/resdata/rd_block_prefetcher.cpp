@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <exception>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <resdata/rd_block_prefetcher.hpp>
+#include <resdata/rd_file_kw.hpp>
+#include <resdata/rd_file_view.hpp>
+#include <resdata/rd_type.hpp>
+
+namespace rd {
+
+BlockPrefetcher::BlockPrefetcher(std::shared_ptr<FileView> view,
+                                 const std::string &block_kw,
+                                 std::vector<std::string> kws, size_t depth,
+                                 size_t memory_cap)
+    : view(std::move(view)), block_kw(block_kw), kws(std::move(kws)),
+      depth(depth), memory_cap(memory_cap) {
+    if (depth == 0)
+        throw std::invalid_argument(
+            "BlockPrefetcher needs room for at least one block");
+
+    num_blocks = this->view->num_named_kw(block_kw);
+    worker = std::thread(&BlockPrefetcher::run, this);
+}
+
+BlockPrefetcher::~BlockPrefetcher() { cancel(); }
+
+bool BlockPrefetcher::wanted(const std::string &header) const {
+    return kws.empty() ||
+           std::find(kws.begin(), kws.end(), header) != kws.end();
+}
+
+/*
+  The worker sizes up the next block before it waits for room in the
+  queue, and then loads the keywords one by one so that a cancel() is
+  noticed between them. An error ends the iteration: the block is queued
+  with the exception, which next() rethrows.
+*/
+void BlockPrefetcher::run() {
+    for (size_t index = 0; index < num_blocks && !cancelled; index++) {
+        Block block;
+        try {
+            block.view = view->blockview(block_kw, block_kw, index);
+            for (size_t kw_index = 0; kw_index < block.view->size();
+                 kw_index++) {
+                auto file_kw = block.view->get_file_kw(kw_index);
+                if (wanted(file_kw.get_header()))
+                    block.bytes +=
+                        static_cast<size_t>(file_kw.get_size()) *
+                        rd_type_get_sizeof_ctype(file_kw.get_data_type());
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] {
+                    return cancelled || queue.empty() ||
+                           (queue.size() < depth &&
+                            (memory_cap == 0 ||
+                             queued_bytes + block.bytes <= memory_cap));
+                });
+            }
+
+            for (size_t kw_index = 0;
+                 kw_index < block.view->size() && !cancelled; kw_index++) {
+                auto file_kw = block.view->get_file_kw(kw_index);
+                if (!wanted(file_kw.get_header()))
+                    continue;
+
+                auto handle = block.view->pin_kw(kw_index);
+                if (!handle)
+                    throw std::ios_base::failure(fmt::format(
+                        "Failed to load {} from \"{}\"",
+                        file_kw.get_header(), view->filename()));
+                block.handles.push_back(std::move(handle));
+            }
+        } catch (...) {
+            block.error = std::current_exception();
+        }
+
+        if (cancelled)
+            break;
+
+        bool failed = static_cast<bool>(block.error);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queued_bytes += block.bytes;
+            queue.push_back(std::move(block));
+        }
+        changed.notify_all();
+        if (failed)
+            break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    changed.notify_all();
+}
+
+std::shared_ptr<FileView> BlockPrefetcher::next() {
+    current.clear();
+
+    Block block;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return !queue.empty() || done; });
+        if (queue.empty())
+            return nullptr;
+
+        block = std::move(queue.front());
+        queue.pop_front();
+        queued_bytes -= block.bytes;
+    }
+    changed.notify_all();
+
+    if (block.error)
+        std::rethrow_exception(block.error);
+
+    current = std::move(block.handles);
+    return block.view;
+}
+
+void BlockPrefetcher::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+    }
+    changed.notify_all();
+    if (worker.joinable())
+        worker.join();
+
+    std::deque<Block> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dropped.swap(queue);
+        queued_bytes = 0;
+    }
+    current.clear();
+}
+
+} // namespace rd
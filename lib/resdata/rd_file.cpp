@@ -1,20 +1,30 @@
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 
+#include <algorithm>
 #include <ios>
 #include <fstream>
 #include <istream>
 #include <ostream>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <filesystem>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
 
 #include <ert/util/util.hpp>
 #include <fmt/format.h>
 
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_magic.hpp>
 #include <resdata/rd_file.hpp>
 #include <resdata/rd_file_view.hpp>
 #include <resdata/rd_file_kw.hpp>
@@ -23,6 +33,11 @@
 #include <resdata/rd_util.hpp>
 
 namespace fs = std::filesystem;
+
+/* The range read ahead at the next keyword when rd::File::scan() skips
+   the data of a keyword. */
+static constexpr offset_type scan_readahead_size = 1 << 20;
+
 /**
    This file implements functionality to load a file in
    restart format. The implementation works by first searching through
@@ -88,10 +103,11 @@ namespace fs = std::filesystem;
 
    The following illustrates the indexing. The rd_file contains in
    total 7 rd_kw instances, the global index [0...6] is the internal
-   way to access the various keywords. The kw_index is a hash table
-   with entries 'SEQHDR', 'MINISTEP' and 'PARAMS'. Each entry in the
-   hash table is an integer vector which again contains the internal
-   index of the various occurences:
+   way to access the various keywords. The occurrences member of the
+   FileIndex is a hash table with entries 'SEQHDR', 'MINISTEP' and
+   'PARAMS', keyed on the headers packed into 64 bit integers. Each entry
+   in the hash table is an integer vector which again contains the
+   internal index of the various occurences:
 
    ------------------
    SEQHDR            \
@@ -103,8 +119,11 @@ namespace fs = std::filesystem;
    PARAMS    .....   /
    ------------------
 
-   kw_index    = {"SEQHDR": [0], "MINISTEP": [1,3,5], "PARAMS": [2,4,6]}    <== This is hash table.
-   kw_list     = [SEQHDR , MINISTEP , PARAMS , MINISTEP , PARAMS , MINISTEP , PARAMS]
+   occurrences = {"SEQHDR": [0], "MINISTEP": [1,3,5], "PARAMS": [2,4,6]}    <== This is hash table.
+   names       = [SEQHDR , MINISTEP , PARAMS , MINISTEP , PARAMS , MINISTEP , PARAMS]
+
+   A blockview, like 'Block 2' above, shares the FileIndex of the file and
+   only holds the range of positions it covers.
 
    [1]: This is not entirely true - there are several specialized function
         for working with restart files. However the restart files are
@@ -112,6 +131,20 @@ namespace fs = std::filesystem;
         internalized as in e.g. rd_sum.
 */
 
+/* The keywords the views of a file are built around; they are indexed
+   whatever the keyword filter of the file. */
+static bool is_structural_kw(const std::string &header) {
+    static const std::vector<std::string> structural_kws = {
+        SEQNUM_KW,   INTEHEAD_KW, LOGIHEAD_KW, DOUBHEAD_KW,
+        SEQHDR_KW,   MINISTEP_KW, LGR_KW,      ENDLGR_KW};
+    return std::find(structural_kws.begin(), structural_kws.end(), header) !=
+           structural_kws.end();
+}
+
+bool rd::File::is_indexed(const std::string &header) const {
+    return !filter || is_structural_kw(header) || filter(header);
+}
+
 /** Will scan through the whole file and build an index of all keywords.
    The map created from this scan will be stored under the 'global_view'
    field; and all subsequent lookup operations will ultimately be based
@@ -121,28 +154,54 @@ namespace fs = std::filesystem;
    valid rd_kw instances on the disk; it will return when EOF is encountered or
    an invalid rd_kw instance is detected. This implies that for a partly broken
    file the rd_file_scan function will index the valid keywords which are in
-   the file, possible garbage at the end will be ignored. */
-void rd::File::scan() {
-    context->fortio.fseek(0, SEEK_SET);
+   the file, possible garbage at the end will be ignored.
+
+   The scan starts at @offset, which must be the start of a keyword, and
+   the keywords found are appended to the global view. Keywords rejected
+   by the keyword filter of the file are skipped without an index entry. */
+void rd::File::scan(offset_type offset) {
+    auto &fortio = context->fortio;
+    const auto access_hint = fortio.access_hint();
+    fortio.advise(ERT::FortIO::AccessHint::SEQUENTIAL);
+
+    size_t first = global_view->size();
+    offset_type readahead_end = offset;
+    fortio.fseek(offset, SEEK_SET);
     {
         rd_kw_ptr work_kw = make_rd_kw("WORK-KW", 0, RD_INT, nullptr);
 
         while (true) {
-            if (context->fortio.read_at_eof())
+            if (fortio.read_at_eof())
                 break;
 
             {
-                offset_type current_offset = context->fortio.ftell();
+                offset_type current_offset = fortio.ftell();
                 rd_read_status_enum read_status =
-                    rd_kw_fread_header(work_kw.get(), context->fortio);
+                    rd_kw_fread_header(work_kw.get(), fortio);
                 if (read_status == RD_KW_READ_FAIL)
                     break;
 
                 if (read_status == RD_KW_READ_OK) {
-                    auto file_kw =
-                        std::make_shared<FileKW>(work_kw.get(), current_offset);
+                    /* The data of the keyword is skipped, and the readahead
+                       of the file system restarts with a small window at the
+                       next keyword; ask for a larger range up front. */
+                    offset_type next_offset =
+                        current_offset + rd_kw_fortio_size(work_kw.get());
+                    if (!fortio.fmt_file() &&
+                        next_offset + RD_KW_HEADER_FORTIO_SIZE >
+                            readahead_end) {
+                        fortio.will_need(next_offset, scan_readahead_size);
+                        readahead_end = next_offset + scan_readahead_size;
+                    }
 
-                    if (file_kw->skip_data(context->fortio)) {
+                    if (!is_indexed(rd_kw_get_header(work_kw.get()))) {
+                        if (!rd_kw_fskip_data(work_kw.get(), fortio))
+                            break;
+                        continue;
+                    }
+
+                    FileKW file_kw(work_kw.get(), current_offset);
+                    if (file_kw.skip_data(fortio)) {
                         global_view->add_kw(file_kw);
                     } else {
                         break;
@@ -151,7 +210,50 @@ void rd::File::scan() {
             }
         }
     }
-    global_view->make_index();
+    global_view->update_index(first);
+    fortio.advise(access_hint);
+}
+
+void rd::File::advise(ERT::FortIO::AccessHint hint) {
+    std::lock_guard<std::mutex> lock(context->mutex);
+    std::lock_guard<std::mutex> stream_lock(context->stream_mutex);
+    context->fortio.advise(hint);
+}
+
+size_t rd::File::refresh() {
+    /* The loads in progress may read the mapping of the file, which is
+       replaced below; new loads wait for the mutex. */
+    std::unique_lock<std::mutex> lock(context->mutex);
+    context->loads_done.wait(lock,
+                             [this] { return context->active_loads == 0; });
+    std::lock_guard<std::mutex> stream_lock(context->stream_mutex);
+
+    auto &fortio = context->fortio;
+    if (!fortio.assert_stream_open())
+        throw std::ios_base::failure(
+            fmt::format("Failed to open file \"{}\"", fortio.filename()));
+    fortio.update_size();
+
+    size_t num_kw = global_view->size();
+    offset_type offset = 0;
+    if (num_kw > 0) {
+        auto last_kw = global_view->get_file_kw(num_kw - 1);
+        rd_kw_ptr work_kw = make_rd_kw("WORK-KW", 0, RD_INT, nullptr);
+        if (!fortio.fseek(last_kw.get_offset(), SEEK_SET) ||
+            rd_kw_fread_header(work_kw.get(), fortio) != RD_KW_READ_OK ||
+            !(FileKW(work_kw.get(), last_kw.get_offset()) == last_kw) ||
+            !last_kw.skip_data(fortio))
+            throw std::runtime_error(fmt::format(
+                "The file \"{}\" has been modified since it was indexed",
+                fortio.filename()));
+        offset = fortio.ftell();
+    }
+    scan(offset);
+
+    if ((context->flags & FileMode::CLOSE_STREAM) == FileMode::CLOSE_STREAM)
+        fortio.fclose_stream();
+
+    return global_view->size() - num_kw;
 }
 
 static std::unique_ptr<ERT::FortIO>
@@ -162,9 +264,104 @@ rd_file_alloc_fortio(const std::string &filename, FileMode flags) {
     if ((flags & FileMode::WRITABLE) == FileMode::WRITABLE)
         return std::make_unique<ERT::FortIO>(
             filename, std::ios_base::in | std::ios_base::out, fmt_file);
-    else
-        return std::make_unique<ERT::FortIO>(filename, std::ios_base::in,
-                                             fmt_file);
+
+    auto fortio =
+        std::make_unique<ERT::FortIO>(filename, std::ios_base::in, fmt_file);
+    if ((flags & FileMode::MMAP) == FileMode::MMAP)
+        fortio->mmap_file();
+
+    return fortio;
+}
+
+/*
+  The index cache of FileMode::INDEX_CACHE. A cached index is stored under
+  a name derived from the absolute path of the file, and is only used when
+  the size, modification time and a fingerprint of the first and last
+  bytes of the file are unchanged since the index was written.
+*/
+namespace {
+constexpr char index_cache_magic[8] = "RDIDXC1";
+constexpr std::size_t index_cache_fingerprint_bytes = 4096;
+
+struct IndexCacheKey {
+    std::string path;
+    int64_t size;
+    int64_t mtime;
+    uint64_t fingerprint;
+
+    bool operator==(const IndexCacheKey &other) const {
+        return path == other.path && size == other.size &&
+               mtime == other.mtime && fingerprint == other.fingerprint;
+    }
+};
+
+uint64_t fnv1a(const char *data, std::size_t size,
+               uint64_t hash = 14695981039346656037ULL) {
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* The key of @filename, or nullopt if the file can not be inspected. */
+std::optional<IndexCacheKey> index_cache_key(const std::string &filename) {
+    std::error_code ec;
+    fs::path path = fs::canonical(filename, ec);
+    if (ec)
+        return std::nullopt;
+    auto size = fs::file_size(path, ec);
+    if (ec)
+        return std::nullopt;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec)
+        return std::nullopt;
+
+    std::ifstream stream(path, std::ios_base::binary);
+    if (!stream)
+        return std::nullopt;
+
+    std::size_t head_size =
+        std::min<std::size_t>(size, index_cache_fingerprint_bytes);
+    std::vector<char> buffer(head_size);
+    stream.read(buffer.data(), static_cast<std::streamsize>(head_size));
+    uint64_t fingerprint = fnv1a(buffer.data(), head_size);
+    if (size > head_size) {
+        std::size_t tail_size = std::min<std::size_t>(size - head_size,
+                                                      head_size);
+        stream.seekg(static_cast<std::streamoff>(size - tail_size));
+        stream.read(buffer.data(), static_cast<std::streamsize>(tail_size));
+        fingerprint = fnv1a(buffer.data(), tail_size, fingerprint);
+    }
+    if (!stream)
+        return std::nullopt;
+
+    return IndexCacheKey{path.string(), static_cast<int64_t>(size),
+                         static_cast<int64_t>(mtime.time_since_epoch().count()),
+                         fingerprint};
+}
+
+fs::path index_cache_file(const IndexCacheKey &key) {
+    uint64_t path_hash = fnv1a(key.path.data(), key.path.size());
+    return rd::File::index_cache_dir() /
+           fmt::format("{:016x}.index", path_hash);
+}
+} // namespace
+
+static std::shared_ptr<rd::FileView>
+read_cached_index(const IndexCacheKey &key,
+                  std::shared_ptr<rd::FileContext> context);
+static void write_cached_index(const IndexCacheKey &key,
+                               const rd::FileView &global_view);
+
+fs::path rd::File::index_cache_dir() {
+    if (const char *dir = std::getenv("RD_INDEX_CACHE_DIR"))
+        return fs::path(dir);
+    if (const char *dir = std::getenv("XDG_CACHE_HOME"))
+        return fs::path(dir) / "resdata" / "index";
+    if (const char *dir = std::getenv("HOME"))
+        return fs::path(dir) / ".cache" / "resdata" / "index";
+    return fs::temp_directory_path() / "resdata-index";
 }
 
 /** The fundamental open file function; all alternative open()
@@ -174,14 +371,49 @@ rd_file_alloc_fortio(const std::string &filename, FileMode flags) {
    structure. No keyword data will be loaded from the file.*/
 std::unique_ptr<rd::File> rd::File::open(const std::string &filename,
                                          FileMode flags) {
+    return open(filename, KeywordFilter{}, flags);
+}
+
+std::unique_ptr<rd::File>
+rd::File::open(const std::string &filename,
+               const std::vector<std::string> &keywords, FileMode flags) {
+    return open(
+        filename,
+        [keywords](const std::string &header) {
+            return std::find(keywords.begin(), keywords.end(), header) !=
+                   keywords.end();
+        },
+        flags);
+}
+
+std::unique_ptr<rd::File> rd::File::open(const std::string &filename,
+                                         KeywordFilter filter,
+                                         FileMode flags) {
     auto fortio = rd_file_alloc_fortio(filename, flags);
 
     auto context = std::make_shared<rd::FileContext>(std::move(*fortio), flags);
-    auto global_view = std::make_shared<rd::FileView>(context);
-    auto rd_file =
-        std::unique_ptr<rd::File>(new rd::File(context, global_view));
 
-    rd_file->scan();
+    std::optional<IndexCacheKey> cache_key;
+    std::shared_ptr<rd::FileView> global_view;
+    if ((flags & FileMode::INDEX_CACHE) == FileMode::INDEX_CACHE &&
+        !filter) {
+        cache_key = index_cache_key(filename);
+        if (cache_key)
+            global_view = read_cached_index(*cache_key, context);
+    }
+
+    std::unique_ptr<rd::File> rd_file;
+    if (global_view)
+        rd_file.reset(new rd::File(context, global_view));
+    else {
+        global_view = std::make_shared<rd::FileView>(context);
+        rd_file.reset(new rd::File(context, global_view));
+        context->filtered = static_cast<bool>(filter);
+        rd_file->filter = std::move(filter);
+        rd_file->scan();
+        if (cache_key)
+            write_cached_index(*cache_key, *global_view);
+    }
 
     if ((rd_file->context->flags & FileMode::CLOSE_STREAM) ==
         FileMode::CLOSE_STREAM)
@@ -190,6 +422,22 @@ std::unique_ptr<rd::File> rd::File::open(const std::string &filename,
     return rd_file;
 }
 
+void rd::File::set_memory_budget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(context->mutex);
+    context->memory_budget = bytes;
+    context->evict();
+}
+
+rd::CacheStats rd::File::cache_stats() const {
+    std::lock_guard<std::mutex> lock(context->mutex);
+    CacheStats stats;
+    stats.hits = context->hits;
+    stats.misses = context->misses;
+    stats.evictions = context->evictions;
+    stats.loaded_bytes = context->loaded_bytes;
+    return stats;
+}
+
 /** Will save the content of @rd_kw to the on-disk file wrapped by the
     rd_file instance. This function is quite strict:
 
@@ -203,10 +451,12 @@ std::unique_ptr<rd::File> rd::File::open(const std::string &filename,
     3. The rd_file must have been opened with one of the _writable()
        open functions. */
 bool rd::File::save_kw(const rd_kw_type *rd_kw) {
-    FileKW *file_kw = context->inv_map.at(rd_kw);
+    std::lock_guard<std::mutex> lock(context->mutex);
+    std::lock_guard<std::mutex> stream_lock(context->stream_mutex);
+    FileKW file_kw = global_view->get_file_kw(context->inv_map.at(rd_kw));
     if (context->fortio.assert_stream_open()) {
 
-        file_kw->inplace_write(context->fortio);
+        file_kw.inplace_write(context->fortio, rd_kw);
 
         if ((context->flags & FileMode::CLOSE_STREAM) == FileMode::CLOSE_STREAM)
             context->fortio.fclose_stream();
@@ -284,6 +534,12 @@ static void write_index_filename(const std::string &s, std::ostream &stream) {
 }
 
 void rd::File::write_index(const std::string &index_filename) {
+    if (filter)
+        throw std::logic_error(fmt::format(
+            "Can not write the index of \"{}\", which was opened with a "
+            "keyword filter",
+            context->fortio.filename()));
+
     std::ofstream ostream(index_filename, std::ios_base::binary);
     if (!ostream)
         throw std::ios_base::failure(fmt::format(
@@ -319,3 +575,78 @@ rd::File::fast_open(const std::string &file_name,
         rd_file->context->fortio.fclose_stream();
     return rd_file;
 }
+
+/*
+  Returns nullptr when there is no usable cached index for @key; a cache
+  file which can not be read is treated as missing.
+*/
+static std::shared_ptr<rd::FileView>
+read_cached_index(const IndexCacheKey &key,
+                  std::shared_ptr<rd::FileContext> context) {
+    std::ifstream istream(index_cache_file(key), std::ios_base::binary);
+    if (!istream)
+        return nullptr;
+
+    try {
+        istream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        char magic[sizeof index_cache_magic];
+        istream.read(magic, sizeof magic);
+        if (std::string(magic, sizeof magic) !=
+            std::string(index_cache_magic, sizeof index_cache_magic))
+            return nullptr;
+
+        IndexCacheKey cached_key{};
+        istream.read(reinterpret_cast<char *>(&cached_key.size),
+                     sizeof cached_key.size);
+        istream.read(reinterpret_cast<char *>(&cached_key.mtime),
+                     sizeof cached_key.mtime);
+        istream.read(reinterpret_cast<char *>(&cached_key.fingerprint),
+                     sizeof cached_key.fingerprint);
+        cached_key.path = read_index_filename(istream);
+        if (!(cached_key == key))
+            return nullptr;
+
+        return rd::FileView::read(std::move(context), istream);
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+}
+
+/*
+  The index is written to a uniquely named temporary file which is renamed
+  into place, so concurrent readers see either the old or the new index.
+  Failing to write the cache is not an error.
+*/
+static void write_cached_index(const IndexCacheKey &key,
+                               const rd::FileView &global_view) {
+    std::error_code ec;
+    fs::path cache_file = index_cache_file(key);
+    fs::create_directories(cache_file.parent_path(), ec);
+    if (ec)
+        return;
+
+    std::random_device random;
+    fs::path tmp_file = cache_file;
+    tmp_file += fmt::format(".{:08x}{:08x}.tmp", random(), random());
+    try {
+        {
+            std::ofstream ostream(tmp_file, std::ios_base::binary);
+            if (!ostream)
+                return;
+            ostream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+            ostream.write(index_cache_magic, sizeof index_cache_magic);
+            ostream.write(reinterpret_cast<const char *>(&key.size),
+                          sizeof key.size);
+            ostream.write(reinterpret_cast<const char *>(&key.mtime),
+                          sizeof key.mtime);
+            ostream.write(reinterpret_cast<const char *>(&key.fingerprint),
+                          sizeof key.fingerprint);
+            write_index_filename(key.path, ostream);
+            global_view.write_index(ostream);
+        }
+        fs::rename(tmp_file, cache_file);
+    } catch (const std::exception &) {
+        fs::remove(tmp_file, ec);
+    }
+}
@@ -1,12 +1,16 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ios>
 #include <istream>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -17,25 +21,57 @@
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_type.hpp>
 
-void FileKW::assert_kw() const {
+static_assert(sizeof(kw_name_type) == RD_STRING8_LENGTH);
+
+std::optional<kw_name_type> pack_kw_name(std::string_view header) {
+    if (header.size() > RD_STRING8_LENGTH)
+        return std::nullopt;
+
+    kw_name_type name = 0;
+    memcpy(&name, header.data(), header.size());
+    return name;
+}
+
+std::string unpack_kw_name(kw_name_type name) {
+    char chars[RD_STRING8_LENGTH];
+    memcpy(chars, &name, sizeof name);
+    size_t length = 0;
+    while (length < RD_STRING8_LENGTH && chars[length] != '\0')
+        length++;
+    return {chars, length};
+}
+
+FileKW::FileKW(offset_type file_offset, rd_data_type data_type, int kw_size,
+               std::string_view header)
+    : file_offset(file_offset), data_type(data_type), kw_size(kw_size) {
+    auto packed = pack_kw_name(header);
+    if (!packed)
+        throw std::invalid_argument(
+            "The keyword header \"" + std::string(header) +
+            "\" is longer than " + std::to_string(RD_STRING8_LENGTH) +
+            " characters");
+    name = *packed;
+}
+
+void FileKW::assert_kw(const rd_kw_type *kw) const {
     if (!kw)
         throw std::runtime_error("keyword could not be loaded from file "
                                  "(rd_kw_fread_alloc returned NULL)");
 
-    if (!rd_type_is_equal(this->data_type, rd_kw_get_data_type(kw.get())))
+    if (!rd_type_is_equal(this->data_type, rd_kw_get_data_type(kw)))
         throw std::runtime_error(std::string(__func__) +
                                  ": type mismatch between header and file.");
 
-    if (kw_size != rd_kw_get_size(kw.get()))
+    if (kw_size != rd_kw_get_size(kw))
         throw std::runtime_error(std::string(__func__) +
                                  ": size mismatch between header and file.");
 
-    if (header != rd_kw_get_header(kw.get()))
+    if (pack_kw_name(rd_kw_get_header(kw)) != name)
         throw std::runtime_error(std::string(__func__) +
                                  ": name mismatch between header and file.");
 }
 
-void FileKW::load_kw(ERT::FortIO &fortio) {
+rd_kw_ptr FileKW::load(ERT::FortIO &fortio) const {
     if (!fortio.assert_stream_open())
         throw std::ios_base::failure(
             std::string(__func__) +
@@ -43,31 +79,33 @@ void FileKW::load_kw(ERT::FortIO &fortio) {
             "been detached.");
 
     fortio.fseek(file_offset, SEEK_SET);
-    // Note load_kw is only called when kw is nullptr
-    kw.reset(rd_kw_fread_alloc(fortio));
-    assert_kw();
+    rd_kw_ptr kw{rd_kw_fread_alloc(fortio), &rd_kw_free};
+    assert_kw(kw.get());
+    return kw;
 }
 
-rd_kw_type *FileKW::get_kw(ERT::FortIO &fortio) {
-    if (!kw)
-        load_kw(fortio);
-
-    return kw.get();
+rd_kw_ptr FileKW::pread(const ERT::FortIO &fortio) const {
+    rd_kw_ptr kw{rd_kw_pread_alloc(fortio, file_offset), &rd_kw_free};
+    if (kw)
+        assert_kw(kw.get());
+    return kw;
 }
 
 bool FileKW::skip_data(ERT::FortIO &fortio) const {
     return rd_kw_fskip_data__(data_type, kw_size, fortio);
 }
 
-void FileKW::inplace_write(ERT::FortIO &fortio) const {
-    assert_kw();
+void FileKW::inplace_write(ERT::FortIO &fortio,
+                           const rd_kw_type *rd_kw) const {
+    assert_kw(rd_kw);
     fortio.fseek(file_offset, SEEK_SET);
     rd_kw_fskip_header(fortio);
     fortio.fclean();
-    rd_kw_fwrite_data(kw.get(), fortio);
+    rd_kw_fwrite_data(rd_kw, fortio);
 }
 
 void FileKW::write_header(std::ostream &stream) const {
+    std::string header = get_header();
     size_t header_length = header.size();
     for (size_t i = 0; i < RD_STRING8_LENGTH; i++) {
         if (i < header_length)
@@ -85,9 +123,8 @@ void FileKW::write_header(std::ostream &stream) const {
     stream.write(reinterpret_cast<const char *>(&type_size), sizeof(type_size));
 }
 
-std::vector<std::shared_ptr<FileKW>> FileKW::read(std::istream &stream,
-                                                  size_t num) {
-    std::vector<std::shared_ptr<FileKW>> kw_list;
+std::vector<FileKW> FileKW::read(std::istream &stream, size_t num) {
+    std::vector<FileKW> kw_list;
     kw_list.reserve(num);
 
     for (size_t ikw = 0; ikw < num; ikw++) {
@@ -106,12 +143,10 @@ std::vector<std::shared_ptr<FileKW>> FileKW::read(std::istream &stream,
         stream.read(reinterpret_cast<char *>(&type), sizeof(type));
         stream.read(reinterpret_cast<char *>(&type_size), sizeof(type_size));
 
-        kw_list.push_back(std::make_shared<FileKW>(
+        kw_list.emplace_back(
             file_offset,
             rd_type_create(static_cast<rd_type_enum>(type), type_size), kw_size,
-            std::move(header)));
+            header);
     }
     return kw_list;
 }
-
-void FileKW::clear() { kw.reset(nullptr); }
@@ -100,8 +100,14 @@ PYBIND11_MODULE(rd_file, m) {
 
     py::class_<rd::File>(m, "ResdataFile", py::dynamic_attr())
         .def(py::init([](std::string filename, FileMode flags,
-                         std::optional<std::string> index_filename)
+                         std::optional<std::string> index_filename,
+                         std::optional<std::vector<std::string>> keywords)
                           -> std::unique_ptr<rd::File> {
+                 if (index_filename && keywords)
+                     throw std::invalid_argument(
+                         "Can not combine index_filename and keywords");
+                 if (keywords)
+                     return rd::File::open(filename, *keywords, flags);
                  if (!index_filename)
                      return rd::File::open(filename, flags);
                  return rd::File::fast_open(filename, *index_filename, flags);
@@ -109,6 +115,7 @@ PYBIND11_MODULE(rd_file, m) {
              py::arg("filename"),
              py::arg_v("flags", FileMode::DEFAULT, "FileMode.DEFAULT"),
              py::arg("index_filename") = py::none(),
+             py::arg("keywords") = py::none(),
              "Loads the complete file filename.\n"
              "\n"
              "Will create a new ResdataFile instance with the content of file\n"
@@ -129,6 +136,13 @@ PYBIND11_MODULE(rd_file, m) {
              "\n"
              "   ResdataFile(name, FileMode.WRITABLE | FileMode.CLOSE_STREAM)\n"
              "\n"
+             "With keywords only the keywords named there, and the keywords\n"
+             "which restart and summary blocks are built around, like\n"
+             "SEQNUM and INTEHEAD, are indexed; the other keywords of the\n"
+             "file are skipped:\n"
+             "\n"
+             "   ResdataFile(name, keywords=[\"PRESSURE\", \"SWAT\"])\n"
+             "\n"
              "When the file has been loaded the ResdataFile instance can be\n"
              "used to query for and get reference to the ResdataKW instances\n"
              "constituting the file, like e.g. SWAT from a restart file or\n"
@@ -258,6 +272,12 @@ PYBIND11_MODULE(rd_file, m) {
             "     called is read on first access. Accessing such a keyword\n"
             "     through a ResdataFileView (or through this ResdataFile)\n"
             "     re-opens the file on disk to read it.\n")
+        .def("refresh", &rd::File::refresh,
+             "Indexes the keywords appended to the file since it was opened\n"
+             "or last refreshed, and returns the number of new keywords.\n"
+             "\n"
+             "A keyword which is still being written is picked up by a later\n"
+             "refresh. Views created before the refresh are not updated.\n")
         .def(
             "block_view",
             [](py::object py_self, std::string kw, py::int_ kw_index) {
@@ -1,12 +1,19 @@
+#include <atomic>
 #include <ctime>
+#include <exception>
 
+#include <ios>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <fmt/format.h>
 #include <algorithm>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -15,6 +22,7 @@
 
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_allocator.hpp>
 #include <resdata/rd_kw_magic.hpp>
 #include <resdata/rd_file_kw.hpp>
 #include <resdata/rd_file_view.hpp>
@@ -25,20 +33,101 @@
 
 namespace rd {
 
+void FileIndex::push_back(const FileKW &file_kw) {
+    offsets.push_back(file_kw.get_offset());
+    sizes.push_back(file_kw.get_size());
+    types.push_back(file_kw.get_data_type());
+    names.push_back(file_kw.get_name());
+}
+
+size_t FileIndex::memory_usage() const {
+    size_t bytes = offsets.capacity() * sizeof(offset_type) +
+                   sizes.capacity() * sizeof(int) +
+                   types.capacity() * sizeof(rd_data_type) +
+                   names.capacity() * sizeof(kw_name_type) +
+                   distinct.capacity() * sizeof(kw_name_type);
+    /* The nodes and buckets of the hash table are estimated */
+    bytes += occurrences.bucket_count() * sizeof(void *);
+    for (const auto &[name, positions] : occurrences)
+        bytes += sizeof(std::pair<const kw_name_type, std::vector<size_t>>) +
+                 sizeof(void *) + positions.capacity() * sizeof(size_t);
+    return bytes;
+}
+
 void FileView::make_index() {
-    distinct_kw.clear();
-    kw_index.clear();
-
-    size_t global_index = 0;
-    for (const auto &file_kw : kw_list) {
-        const std::string &header = file_kw->get_header();
-        if (kw_index.find(header) == kw_index.end())
-            distinct_kw.push_back(header);
-
-        auto &index_vector = kw_index[header];
-        index_vector.push_back(global_index);
-        global_index++;
+    index->occurrences.clear();
+    index->distinct.clear();
+    update_index(0);
+}
+
+void FileView::update_index(size_t first) {
+    for (size_t position = range_begin + first; position < index->size();
+         position++) {
+        kw_name_type name = index->names[position];
+        auto [it, inserted] = index->occurrences.try_emplace(name);
+        if (inserted)
+            index->distinct.push_back(name);
+
+        it->second.push_back(position);
+    }
+}
+
+/*
+  A blockview is a slice of the index of the view it was created from, so
+  the occurrences of a keyword in the view are found by bisecting the
+  occurrence list of the complete index with the bounds of the slice.
+*/
+FileView::position_range FileView::occurrences(const std::string &kw) const {
+    auto name = pack_kw_name(kw);
+    if (!name)
+        return {nullptr, nullptr};
+
+    auto it = index->occurrences.find(*name);
+    if (it == index->occurrences.end())
+        return {nullptr, nullptr};
+
+    const size_t *first = it->second.data();
+    const size_t *last = first + it->second.size();
+    if (range_begin > 0)
+        first = std::lower_bound(first, last, range_begin);
+    if (range_end != std::string::npos)
+        last = std::lower_bound(first, last, range_end);
+    return {first, last};
+}
+
+size_t FileView::position(const std::string &kw, size_t ith) const {
+    auto [first, last] = occurrences(kw);
+    if (ith >= static_cast<size_t>(last - first))
+        throw std::out_of_range(fmt::format(
+            "No occurrence {} of {} in \"{}\"", ith, kw, filename()));
+    return first[ith];
+}
+
+rd_kw_type *FileView::get_loaded_kw(size_t global_index) const {
+    size_t kw_position = position(global_index);
+    std::lock_guard<std::mutex> lock(context->mutex);
+    return context->find(kw_position);
+}
+
+std::vector<kw_name_type> FileView::distinct_names() const {
+    if (range_begin == 0 && range_end == std::string::npos)
+        return index->distinct;
+
+    std::vector<kw_name_type> distinct;
+    std::unordered_set<kw_name_type> seen;
+    for (size_t position = range_begin; position < range_stop(); position++) {
+        kw_name_type name = index->names[position];
+        if (seen.insert(name).second)
+            distinct.push_back(name);
     }
+    return distinct;
+}
+
+std::vector<std::string> FileView::get_distinct_kw() const {
+    std::vector<std::string> distinct_kw;
+    for (kw_name_type name : distinct_names())
+        distinct_kw.push_back(unpack_kw_name(name));
+    return distinct_kw;
 }
 
 bool FileView::has_flags(FileMode flags) const {
@@ -61,20 +150,306 @@ bool FileView::drop_flags(FileMode flag) {
     return flag_set;
 }
 
-rd_kw_type *FileView::get_kw(const std::shared_ptr<FileKW> &file_kw) {
-    rd_kw_type *rd_kw = file_kw->get_kw_ptr();
-    if (!rd_kw) {
-        if (context->fortio.assert_stream_open()) {
-            rd_kw = file_kw->get_kw(context->fortio);
-            context->inv_map[rd_kw] = file_kw.get();
+bool FileView::begin_load() {
+    std::lock_guard<std::mutex> lock(context->mutex);
+    if (!context->fortio.assert_stream_open())
+        return false;
+
+    context->active_loads++;
+    return true;
+}
+
+void FileView::end_load(bool keep_open) {
+    std::lock_guard<std::mutex> lock(context->mutex);
+    context->active_loads--;
+    if (context->active_loads == 0) {
+        if (!keep_open && has_flags(FileMode::CLOSE_STREAM))
+            context->fortio.fclose_stream();
+        context->loads_done.notify_all();
+    }
+}
 
-            if (has_flags(FileMode::CLOSE_STREAM))
-                context->fortio.fclose_stream();
+rd_kw_type *FileContext::find(size_t position) const {
+    auto it = lru_index.find(position);
+    return it == lru_index.end() ? nullptr : it->second->kw.get();
+}
+
+rd_kw_type *FileContext::touch(size_t position, bool pin) {
+    auto it = lru_index.find(position);
+    if (it == lru_index.end())
+        return nullptr;
+
+    if (memory_budget > 0)
+        lru.splice(lru.begin(), lru, it->second);
+    if (pin)
+        it->second->pins++;
+    hold(*it->second);
+    return it->second->kw.get();
+}
+
+void FileContext::hold(CacheEntry &entry) const {
+    if (scopes > 0)
+        entry.held = true;
+}
+
+rd_kw_type *FileContext::insert(size_t position, rd_kw_ptr rd_kw, bool pin) {
+    rd_kw_type *kw = rd_kw.get();
+    size_t bytes = static_cast<size_t>(rd_kw_get_size(kw)) *
+                   rd_type_get_sizeof_ctype(rd_kw_get_data_type(kw));
+    lru.push_front(
+        CacheEntry{position, std::move(rd_kw), bytes, pin ? 1 : 0, false});
+    hold(lru.front());
+    lru_index[position] = lru.begin();
+    inv_map[kw] = position;
+    loaded_bytes += bytes;
+    return kw;
+}
+
+void FileContext::evict() {
+    size_t budget = memory_budget;
+    if (budget == 0 || lru.empty())
+        return;
+
+    /* The most recently used keyword is kept even if it exceeds the
+       budget on its own, as it is about to be returned to the caller. */
+    auto it = std::prev(lru.end());
+    while (loaded_bytes > budget && it != lru.begin()) {
+        auto entry = it--;
+        if (entry->pins > 0 || entry->held)
+            continue;
+
+        inv_map.erase(entry->kw.get());
+        loaded_bytes -= entry->bytes;
+        lru_index.erase(entry->position);
+        lru.erase(entry);
+        evictions++;
+    }
+}
+
+void FileContext::drop(size_t first, size_t last) {
+    for (auto it = lru.begin(); it != lru.end();) {
+        auto entry = it++;
+        if (entry->position < first || entry->position >= last ||
+            entry->pins > 0 || entry->held)
+            continue;
+
+        inv_map.erase(entry->kw.get());
+        loaded_bytes -= entry->bytes;
+        lru_index.erase(entry->position);
+        lru.erase(entry);
+    }
+}
+
+void FileContext::unpin(size_t position) {
+    auto it = lru_index.find(position);
+    if (it != lru_index.end() && it->second->pins > 0)
+        it->second->pins--;
+}
+
+void FileContext::close_scope() {
+    if (--scopes > 0)
+        return;
+
+    for (auto &entry : lru)
+        entry.held = false;
+    evict();
+}
+
+KWScope::KWScope(std::shared_ptr<FileContext> context)
+    : context(std::move(context)) {
+    std::lock_guard<std::mutex> lock(this->context->mutex);
+    this->context->scopes++;
+}
+
+void KWScope::reset() {
+    if (context) {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        context->close_scope();
+    }
+    context.reset();
+}
+
+void KWHandle::reset() {
+    if (kw) {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        context->unpin(position);
+        context->evict();
+    }
+    context.reset();
+    kw = nullptr;
+}
+
+/*
+  Keywords can be loaded from several threads at the same time: the
+  stream is opened once, the keywords are read with positional reads when
+  the platform supports it and the stream is only closed when the last
+  load in progress completes. The load mutex of the keyword makes a
+  thread wait for a load of the same keyword which is in progress,
+  rather than reading it again.
+
+  Loaded keywords are kept in the cache of the context; with a memory
+  budget the lookups are recorded in its LRU list, and loading a keyword
+  may evict others.
+*/
+rd_kw_type *FileView::load_kw(size_t position, bool pin) {
+    {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        if (rd_kw_type *rd_kw = context->touch(position, pin)) {
+            context->hits++;
+            return rd_kw;
+        }
+    }
+
+    if (!begin_load())
+        return nullptr;
+
+    rd_kw_type *rd_kw;
+    try {
+        std::lock_guard<std::mutex> load_lock(context->load_mutex(position));
+        {
+            std::lock_guard<std::mutex> lock(context->mutex);
+            rd_kw = context->touch(position, pin);
+        }
+        if (rd_kw)
+            context->hits++;
+        else {
+            FileKW file_kw = index->at(position);
+            rd_kw_ptr loaded{nullptr, &rd_kw_free};
+            {
+                ScopedKWAllocator allocator(*context->kw_pool);
+                loaded = file_kw.pread(context->fortio);
+                if (!loaded) {
+                    std::lock_guard<std::mutex> stream_lock(
+                        context->stream_mutex);
+                    loaded = file_kw.load(context->fortio);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(context->mutex);
+            rd_kw = context->insert(position, std::move(loaded), pin);
+            context->misses++;
+            context->evict();
         }
+    } catch (...) {
+        end_load();
+        throw;
     }
+    end_load();
     return rd_kw;
 }
 
+KWHandle FileView::pin_position(size_t position) {
+    rd_kw_type *rd_kw = load_kw(position, true);
+    if (!rd_kw)
+        return {};
+
+    return {context, position, rd_kw};
+}
+
+void FileView::preload(const std::vector<std::string> &kws, size_t threads) {
+    std::vector<size_t> positions;
+    for (const auto &kw : kws) {
+        auto [first, last] = occurrences(kw);
+        positions.insert(positions.end(), first, last);
+    }
+    preload_positions(std::move(positions), threads);
+}
+
+void FileView::preload_all(size_t threads) {
+    std::vector<size_t> positions(size());
+    std::iota(positions.begin(), positions.end(), range_begin);
+    preload_positions(std::move(positions), threads);
+}
+
+void FileView::preload_positions(std::vector<size_t> positions,
+                                 size_t threads) {
+    {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        positions.erase(std::remove_if(positions.begin(), positions.end(),
+                                       [this](size_t position) {
+                                           return context->find(position) !=
+                                                  nullptr;
+                                       }),
+                        positions.end());
+    }
+    /* The positions of a file are in order of file offset */
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()),
+                    positions.end());
+    if (positions.empty())
+        return;
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, positions.size());
+
+    /* Keeps the stream open between the loads with CLOSE_STREAM */
+    if (!begin_load())
+        throw std::ios_base::failure(fmt::format(
+            "Failed to open \"{}\" to preload keywords", filename()));
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < positions.size(); i = next++) {
+            try {
+                load_kw(positions[i]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = positions.size();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &thread : pool)
+        thread.join();
+
+    end_load();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void FileView::read_into(const std::string &kw, size_t ith, void *target,
+                         rd_data_type target_type) {
+    size_t kw_position = position(kw, ith);
+    FileKW file_kw = index->at(kw_position);
+    {
+        /* Holding the mutex keeps a loaded keyword from being evicted
+           while it is copied */
+        std::lock_guard<std::mutex> lock(context->mutex);
+        if (const rd_kw_type *rd_kw = context->find(kw_position)) {
+            rd_kw_get_data_into(rd_kw, target, target_type);
+            return;
+        }
+    }
+
+    if (!begin_load())
+        throw std::ios_base::failure(
+            fmt::format("Failed to open \"{}\" to read {}", filename(), kw));
+
+    try {
+        if (!rd_kw_pread_data_into(context->fortio, file_kw.get_offset(),
+                                   file_kw.get_data_type(),
+                                   file_kw.get_size(), target, target_type)) {
+            std::lock_guard<std::mutex> stream_lock(context->stream_mutex);
+            rd_kw_fread_data_into(context->fortio, file_kw.get_offset(),
+                                  file_kw.get_data_type(),
+                                  file_kw.get_size(), target, target_type);
+        }
+    } catch (...) {
+        end_load();
+        throw;
+    }
+    end_load();
+}
+
 void FileView::index_fload_kw(const std::string &kw, int index,
                               const int_vector_type *index_map,
                               char *io_buffer) {
@@ -82,40 +457,90 @@ void FileView::index_fload_kw(const std::string &kw, int index,
         throw std::invalid_argument(
             fmt::format("Got negative index in index_fload_kw: {}", index));
 
-    auto file_kw = get_file_kw(kw, static_cast<size_t>(index));
-
-    if (!file_kw)
-        throw std::invalid_argument(std::string("Keyword '") + kw + "' index " +
-                                    std::to_string(index) +
-                                    " not found in file view");
-    if (context->fortio.assert_stream_open()) {
-        offset_type offset = file_kw->get_offset();
-        rd_data_type data_type = file_kw->get_data_type();
-        int element_count = file_kw->get_size();
-
-        rd_kw_fread_indexed_data(context->fortio, offset, data_type,
-                                 element_count, index_map, io_buffer);
+    FileKW file_kw = get_file_kw(kw, static_cast<size_t>(index));
+    /* Only the stream is locked during the read, so that keyword lookups
+       and other loads are not held up. The stream is left open for the
+       next call, as the callers read many keywords in a row and close the
+       view when done. */
+    if (!begin_load())
+        return;
+
+    try {
+        std::lock_guard<std::mutex> stream_lock(context->stream_mutex);
+        rd_kw_fread_indexed_data(context->fortio, file_kw.get_offset(),
+                                 file_kw.get_data_type(), file_kw.get_size(),
+                                 index_map, io_buffer);
+    } catch (...) {
+        end_load(true);
+        throw;
     }
+    end_load(true);
+}
+
+void FileView::will_need(const std::string &kw, size_t ith) const {
+    FileKW file_kw = get_file_kw(kw, ith);
+    std::lock_guard<std::mutex> lock(context->mutex);
+    if (!context->fortio.fmt_file())
+        context->fortio.will_need(
+            file_kw.get_offset(),
+            rd_kw_fortio_size__(file_kw.get_data_type(), file_kw.get_size()));
 }
 
+/*
+  Keywords which are not loaded are copied to @target as the raw header and
+  data records, see ERT::FortIO::fwrite_raw(), when the files share format
+  and byte order; the remaining keywords are decoded and written with
+  rd_kw_fwrite(), which also writes any modifications of a loaded keyword.
+*/
 void FileView::write(ERT::FortIO &target, size_t offset) {
-    for (size_t index = offset; index < kw_list.size(); index++) {
-        rd_kw_type *rd_kw = get_kw(index);
+    if (context->filtered)
+        throw std::logic_error(fmt::format(
+            "Can not write \"{}\", which was opened with a keyword filter",
+            context->fortio.filename()));
+
+    for (size_t kw_nr = offset; kw_nr < size(); kw_nr++) {
+        if (!get_loaded_kw(kw_nr) && write_raw(get_file_kw(kw_nr), target))
+            continue;
+
+        rd_kw_type *rd_kw = get_kw(kw_nr);
         rd_kw_fwrite(rd_kw, target);
     }
 }
 
-size_t FileView::get_occurence(size_t global_index) {
-    const auto &file_kw = kw_list[global_index];
-    const std::string &header = file_kw->get_header();
-    const auto &index_vector = kw_index.at(header);
-
-    for (size_t i = 0; i < index_vector.size(); i++) {
-        if (index_vector[i] == global_index)
-            return i;
+bool FileView::write_raw(const FileKW &file_kw, ERT::FortIO &target) {
+    ERT::FortIO &source = context->fortio;
+    if (source.fmt_file() || target.fmt_file())
+        return false;
+
+    if (!begin_load())
+        return false;
+
+    bool written;
+    try {
+        std::lock_guard<std::mutex> lock(context->stream_mutex);
+        written = target.fwrite_raw(
+            source, file_kw.get_offset(),
+            rd_kw_fortio_size__(file_kw.get_data_type(), file_kw.get_size()));
+    } catch (...) {
+        end_load();
+        throw;
     }
-    throw std::out_of_range(
-        fmt::format("Could not find index {}", global_index));
+    end_load();
+    return written;
+}
+
+size_t FileView::get_occurence(size_t global_index) {
+    size_t position = range_begin + global_index;
+    if (global_index >= size())
+        throw std::out_of_range(
+            fmt::format("Could not find index {}", global_index));
+
+    auto [first, last] = occurrences(get_file_kw(global_index).get_header());
+    auto it = std::lower_bound(first, last, position);
+    if (it == last || *it != position)
+        throw std::out_of_range(
+            fmt::format("Could not find index {}", global_index));
+    return static_cast<size_t>(it - first);
 }
 
 std::shared_ptr<FileView>
@@ -125,17 +550,20 @@ FileView::blockview(const std::optional<std::string> &start_kw,
     if (start_kw && num_named_kw(*start_kw) <= occurence)
         return {nullptr};
 
+    size_t begin =
+        start_kw ? occurrences(*start_kw).first[occurence] : range_begin;
+    size_t stop = range_stop();
+    if (end_kw) {
+        auto [first, last] = occurrences(*end_kw);
+        auto next = std::upper_bound(first, last, begin);
+        if (next != last)
+            stop = *next;
+    }
+
     auto block_map = std::make_shared<FileView>(context);
-    auto begin = kw_list.begin() +
-                 static_cast<std::vector<size_t>::iterator::difference_type>(
-                     start_kw ? kw_index.at(*start_kw).at(occurence) : 0);
-    auto stop = end_kw ? std::find_if(begin + 1, kw_list.end(),
-                                      [&](const auto &kw) {
-                                          return *end_kw == kw->get_header();
-                                      })
-                       : kw_list.end();
-    block_map->kw_list.assign(begin, stop);
-    block_map->make_index();
+    block_map->index = index;
+    block_map->range_begin = begin;
+    block_map->range_end = std::max(begin, stop);
     return block_map;
 }
 
@@ -311,13 +739,11 @@ of course quite strict.
 Each report step only has one occurence of SEQNUM, but one INTEHEAD
 for each LGR.*/
 std::optional<size_t> FileView::find_sim_time(time_t sim_time) {
-    if (has_kw(INTEHEAD_KW)) {
-        const auto &intehead_index_list = kw_index.at(INTEHEAD_KW);
-        for (size_t index = 0; index < intehead_index_list.size(); index++) {
-            const rd_kw_type *intehead_kw = get_kw(intehead_index_list[index]);
-            if (rd_rsthead_date(intehead_kw) == sim_time)
-                return index;
-        }
+    auto [first, last] = occurrences(INTEHEAD_KW);
+    for (auto position = first; position != last; ++position) {
+        const rd_kw_type *intehead_kw = get_kw(*position - range_begin);
+        if (rd_rsthead_date(intehead_kw) == sim_time)
+            return static_cast<size_t>(position - first);
     }
     return std::nullopt;
 }
@@ -372,9 +798,8 @@ void FileView::write_index(std::ostream &ostream) const {
     int n = static_cast<int>(size());
     ostream.write(reinterpret_cast<const char *>(&n), sizeof(n));
 
-    for (const auto &file_kw : kw_list) {
-        file_kw->write_header(ostream);
-    }
+    for (size_t kw_nr = 0; kw_nr < size(); kw_nr++)
+        get_file_kw(kw_nr).write_header(ostream);
 }
 
 std::shared_ptr<FileView> FileView::read(std::shared_ptr<FileContext> context,
@@ -386,17 +811,16 @@ std::shared_ptr<FileView> FileView::read(std::shared_ptr<FileContext> context,
             fmt::format("Invalid index size: {}", index_size));
     auto file_view = std::make_shared<FileView>(std::move(context));
 
-    file_view->kw_list = FileKW::read(istream, static_cast<size_t>(index_size));
+    for (const auto &file_kw :
+         FileKW::read(istream, static_cast<size_t>(index_size)))
+        file_view->add_kw(file_kw);
 
     file_view->make_index();
     return file_view;
 }
 
 void FileView::clear() {
-    for (const auto &file_kw : kw_list) {
-        if (auto *rd_kw = file_kw->get_kw_ptr())
-            context->inv_map.erase(rd_kw);
-        file_kw->clear();
-    }
+    std::lock_guard<std::mutex> lock(context->mutex);
+    context->drop(range_begin, range_stop());
 }
 } // namespace rd
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include <pybind11/chrono.h>
 #include <pybind11/cast.h>
@@ -35,6 +36,21 @@ py::object create_kw_reference(rd_kw_type *kw, py::object parent) {
     return ResdataKW().attr("createCReference")(
         reinterpret_cast<std::uintptr_t>(kw), parent);
 }
+
+/* The keyword type matching the element type of @array. */
+rd_data_type array_data_type(const py::array &array) {
+    if (array.dtype().is(py::dtype::of<int32_t>()))
+        return RD_INT;
+    if (array.dtype().is(py::dtype::of<float>()))
+        return RD_FLOAT;
+    if (array.dtype().is(py::dtype::of<double>()))
+        return RD_DOUBLE;
+    if (array.dtype().is(py::dtype::of<bool>()))
+        return RD_BOOL;
+    throw py::type_error(
+        fmt::format("Unsupported array type: {}",
+                    py::str(array.dtype()).cast<std::string>()));
+}
 } // namespace
 
 template <class... Ts> struct overload : Ts... {
@@ -179,6 +195,70 @@ PYBIND11_MODULE(rd_file_view, m) {
         .def("num_keywords", &rd::FileView::num_named_kw, py::arg("kw"))
         .def("unique_size", &rd::FileView::num_distinct_kw)
         .def("unique_kw", &rd::FileView::get_distinct_kw)
+        .def(
+            "preload",
+            [](rd::FileView &self, std::optional<std::vector<std::string>> kws,
+               size_t threads) {
+                if (kws)
+                    self.preload(*kws, threads);
+                else
+                    self.preload_all(threads);
+            },
+            py::arg("kws") = py::none(), py::arg("threads") = 0,
+            py::call_guard<py::gil_scoped_release>(),
+            "Loads all the occurrences of the keywords in kws, or all the\n"
+            "keywords in the view when kws is None, using threads worker\n"
+            "threads (0 uses one per CPU).\n"
+            "\n"
+            "The keywords are read in file order, and later lookups of the\n"
+            "keywords are served from memory:\n"
+            "\n"
+            "   view = restart_file.restart_view(report_step=10)\n"
+            "   view.preload([\"PRESSURE\", \"SWAT\", \"SGAS\"])\n"
+            "\n"
+            "Names which are not in the view are ignored.\n")
+        .def(
+            "read_into",
+            [](rd::FileView &self, std::string kw, py::int_ index,
+               py::array array) {
+                if (!self.has_kw(kw))
+                    throw py::key_error(fmt::format("No such keyword: {}", kw));
+                if (index < py::int_(0) ||
+                    index >= py::int_(self.num_named_kw(kw)))
+                    throw py::index_error(fmt::format(
+                        "Index of read_into for {} out of range: {}", kw,
+                        py::str(index).cast<std::string>()));
+                auto file_kw = self.get_file_kw(kw, index.cast<size_t>());
+
+                rd_data_type target_type = array_data_type(array);
+
+                if (!(array.flags() & py::array::c_style) ||
+                    !array.writeable())
+                    throw py::value_error(
+                        "The array must be writeable and C contiguous");
+                if (array.size() != file_kw.get_size())
+                    throw py::value_error(fmt::format(
+                        "The array has {} elements, {} has {}", array.size(),
+                        kw, file_kw.get_size()));
+
+                void *target = array.mutable_data();
+                py::gil_scoped_release release;
+                self.read_into(kw, index.cast<size_t>(), target, target_type);
+            },
+            py::arg("kw"), py::arg("index"), py::arg("array"),
+            "Reads the data of occurrence index of kw into array, a\n"
+            "preallocated numpy array with one element for each element of\n"
+            "the keyword, without creating a ResdataKW:\n"
+            "\n"
+            "   pressure = numpy.empty(num_active, dtype=numpy.float64)\n"
+            "   view.read_into(\"PRESSURE\", 0, pressure)\n"
+            "\n"
+            "The dtype of array must match the type of the keyword, except\n"
+            "that float keywords may also be read into float64 arrays.\n"
+            "\n"
+            "Raises KeyError if kw is not in the view, IndexError if index\n"
+            "is out of range, and TypeError or ValueError if array does\n"
+            "not fit the keyword.\n")
         .def(
             "block_view2",
             [](rd::FileView *self, std::optional<std::string> start_kw,
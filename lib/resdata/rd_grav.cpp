@@ -12,6 +12,7 @@
 #include <string>
 
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_view.hpp>
 #include <resdata/rd_util.hpp>
 #include <resdata/rd_file.hpp>
 #include <resdata/rd_file_view.hpp>
@@ -226,6 +227,17 @@ static rd_version_enum get_simulator_version(const rd::File *file) {
     }
 }
 
+/*
+  The fluid mass is computed with plain loops over the keywords, which
+  must therefore hold at least one element for each active cell.
+*/
+static void rd_grav_assert_active_size(const rd_kw_type *kw, int size) {
+    if (rd_kw_get_size(kw) < size)
+        throw std::invalid_argument(
+            fmt::format("{} has {} elements, expected {}", rd_kw_get_header(kw),
+                        rd_kw_get_size(kw), size));
+}
+
 static rd_grav_phase_type *rd_grav_phase_alloc(rd_grav_type *rd_grav,
                                                rd_grav_survey_type *survey,
                                                rd_phase_enum phase,
@@ -235,6 +247,8 @@ static rd_grav_phase_type *rd_grav_phase_alloc(rd_grav_type *rd_grav,
     const rd::File *init_file = rd_grav->init_file;
     const rd::rd_grid_cache *grid_cache = rd_grav->grid_cache;
     const char *sat_kw_name = rd_get_phase_name(phase);
+    /* The density is used together with the other restart keywords */
+    rd::KWScope scope = restart_file->scope();
     {
         rd_grav_phase_type *grav_phase = new rd_grav_phase_type();
         const int size = grid_cache->size();
@@ -261,14 +275,22 @@ static rd_grav_phase_type *rd_grav_phase_alloc(rd_grav_type *rd_grav,
             else
                 fip_kw = restart_file->get_kw(FIPWAT_KW, 0);
 
-            for (int iactive = 0; iactive < size; iactive++) {
-                double fip = rd_kw_iget_as_double(fip_kw, iactive);
-                int pvtnum = rd_kw_iget_int(pvtnum_kw, iactive);
-                if (std_density.size() <= pvtnum) {
-                    rd_grav_phase_free(grav_phase);
-                    return NULL;
+            rd_grav_assert_active_size(fip_kw, size);
+            rd_grav_assert_active_size(pvtnum_kw, size);
+            rd::KWView<const int> pvtnum(pvtnum_kw);
+            bool valid_pvtnum = rd::visit_kw(fip_kw, [&](auto fip) {
+                for (int iactive = 0; iactive < size; iactive++) {
+                    auto region = static_cast<size_t>(pvtnum[iactive]);
+                    if (std_density.size() <= region)
+                        return false;
+                    grav_phase->fluid_mass[iactive] =
+                        fip[iactive] * std_density[region];
                 }
-                grav_phase->fluid_mass[iactive] = fip * std_density[pvtnum];
+                return true;
+            });
+            if (!valid_pvtnum) {
+                rd_grav_phase_free(grav_phase);
+                return NULL;
             }
         } else {
             rd_version_enum rd_version = get_simulator_version(init_file);
@@ -284,14 +306,16 @@ static rd_grav_phase_type *rd_grav_phase_alloc(rd_grav_type *rd_grav,
                 else
                     rfip_kw = restart_file->get_kw(RFIPWAT_KW, 0);
 
-                {
-                    int iactive;
-                    for (iactive = 0; iactive < size; iactive++) {
-                        double rho = rd_kw_iget_as_double(den_kw, iactive);
-                        double rfip = rd_kw_iget_as_double(rfip_kw, iactive);
-                        grav_phase->fluid_mass[iactive] = rho * rfip;
-                    }
-                }
+                rd_grav_assert_active_size(den_kw, size);
+                rd_grav_assert_active_size(rfip_kw, size);
+                rd::visit_kw(den_kw, [&](auto rho) {
+                    rd::visit_kw(rfip_kw, [&](auto rfip) {
+                        for (int iactive = 0; iactive < size; iactive++)
+                            grav_phase->fluid_mass[iactive] =
+                                static_cast<double>(rho[iactive]) *
+                                rfip[iactive];
+                    });
+                });
             } else {
                 /* (calc_type == GRAV_CALC_RPORV) || (calc_type == GRAV_CALC_PORMOD) */
                 rd_kw_type *sat_kw;
@@ -313,15 +337,16 @@ static rd_grav_phase_type *rd_grav_phase_alloc(rd_grav_type *rd_grav,
                     private_sat_kw = true;
                 }
 
-                {
-                    int iactive;
-                    for (iactive = 0; iactive < size; iactive++) {
-                        double rho = rd_kw_iget_as_double(den_kw, iactive);
-                        double sat = rd_kw_iget_as_double(sat_kw, iactive);
-                        grav_phase->fluid_mass[iactive] =
-                            rho * sat * survey->porv[iactive];
-                    }
-                }
+                rd_grav_assert_active_size(den_kw, size);
+                rd_grav_assert_active_size(sat_kw, size);
+                rd::visit_kw(den_kw, [&](auto rho) {
+                    rd::visit_kw(sat_kw, [&](auto sat) {
+                        for (int iactive = 0; iactive < size; iactive++)
+                            grav_phase->fluid_mass[iactive] =
+                                static_cast<double>(rho[iactive]) *
+                                sat[iactive] * survey->porv[iactive];
+                    });
+                });
 
                 if (private_sat_kw)
                     rd_kw_free(sat_kw);
@@ -32,6 +32,7 @@
 #include <resdata/rd_kw_grdecl.hpp>
 #include <resdata/rd_file.hpp>
 #include <resdata/rd_kw_magic.hpp>
+#include <resdata/rd_kw_view.hpp>
 #include <resdata/rd_endian_flip.hpp>
 #include <resdata/rd_coarse_cell.hpp>
 #include <resdata/rd_grid.hpp>
@@ -2523,6 +2524,8 @@ static rd_grid_ptr rd_grid_alloc_EGRID_all_grids(const char *grid_file,
     {
         auto rd_file = rd::File::open(std::string(grid_file));
         if (rd_file) {
+            // The grid keywords are loaded roughly in file order
+            rd_file->advise(ERT::FortIO::AccessHint::SEQUENTIAL);
             size_t num_grid = rd_file->num_named_kw(GRIDHEAD_KW);
             auto main_grid = rd_grid_alloc_EGRID__(nullptr, rd_file.get(), 0,
                                                    apply_mapaxes, ext_actnum);
@@ -4286,7 +4289,9 @@ double rd_grid_get_property(const rd_grid_type *rd_grid,
             rd_grid_get_property_index__(rd_grid, rd_kw, i, j, k);
 
         if (lookup_index >= 0)
-            return rd_kw_iget_as_double(rd_kw, lookup_index);
+            return rd::visit_kw(rd_kw, [lookup_index](auto kw_data) {
+                return static_cast<double>(kw_data[lookup_index]);
+            });
         else
             return -1; /* Tried to lookup an inactive cell. */
 
@@ -4329,18 +4334,15 @@ void rd_grid_get_column_property(const rd_grid_type *rd_grid,
                 rd_grid->size, rd_grid->total_active, rd_kw_get_size(rd_kw)));
 
         double_vector_reset(column);
-        for (int k = 0; k < rd_grid->nz; k++) {
-            if (use_global_index) {
-                int global_index = rd_grid_get_global_index3(rd_grid, i, j, k);
-                double_vector_iset(column, k,
-                                   rd_kw_iget_as_double(rd_kw, global_index));
-            } else {
-                int active_index = rd_grid_get_active_index3(rd_grid, i, j, k);
-                if (active_index >= 0)
-                    double_vector_iset(
-                        column, k, rd_kw_iget_as_double(rd_kw, active_index));
+        rd::visit_kw(rd_kw, [&](auto kw_data) {
+            for (int k = 0; k < rd_grid->nz; k++) {
+                int index = use_global_index
+                                ? rd_grid_get_global_index3(rd_grid, i, j, k)
+                                : rd_grid_get_active_index3(rd_grid, i, j, k);
+                if (index >= 0)
+                    double_vector_iset(column, k, kw_data[index]);
             }
-        }
+        });
     } else {
         std::string type_name = rd_type_name(data_type);
         throw std::invalid_argument(fmt::format(
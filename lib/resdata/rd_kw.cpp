@@ -2,8 +2,15 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <charconv>
+#include <ios>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -12,10 +19,13 @@
 
 #include <resdata/rd_kw_magic.hpp>
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_allocator.hpp>
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_endian_flip.hpp>
 #include <resdata/rd_type.hpp>
 
+#include <detail/resdata/rd_kw_kernels.hpp>
+
 #define RD_KW_TYPE_ID 6111098
 
 struct rd_kw_struct {
@@ -27,6 +37,10 @@ struct rd_kw_struct {
     char *header;     /* Header which is trimmed to no-space. */
     char *data;       /* The actual data vector. */
     bool shared_data; /* Whether this keyword has shared data or not. */
+    /* The allocator of data, or NULL if data is to be released with free(),
+       see rd_kw_set_data_ptr(). */
+    rd::KWAllocator *allocator;
+    size_t data_bytes; /* The size data was allocated with. */
 };
 
 UTIL_IS_INSTANCE_FUNCTION(rd_kw, RD_KW_TYPE_ID)
@@ -39,6 +53,9 @@ UTIL_IS_INSTANCE_FUNCTION(rd_kw, RD_KW_TYPE_ID)
 #define BLOCKSIZE_NUMERIC 1000
 #define BLOCKSIZE_CHAR 105
 
+/* Upper limit on the scratch buffer used when writing unformatted data. */
+#define RD_KW_FWRITE_CHUNK_SIZE (4 << 20)
+
 /* When writing formatted data, the data comes in columns, with a
    certain number of elements in each row, i.e. four columns for float
    data:
@@ -61,37 +78,27 @@ UTIL_IS_INSTANCE_FUNCTION(rd_kw, RD_KW_TYPE_ID)
 /* Format string used when writing a formatted header. */
 #define WRITE_HEADER_FMT " '%-8s' %11d '%-4s'\n"
 
-/* Format string used when reading and writing formatted
-   files. Observe the following about these format strings:
+/* Layout of the elements in formatted files:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
+      char      " '%-8s'"
+      string    " '%-{n}s'"  where n is the string length
+      int       " %11d"
+      float     "  %11.8fE%+03d"
+      double    "  %17.14fD%+03d"
+      bool      "  %c"
 
-    2. For both double and float the write format contains two '%'
-       characters - that is because the values are split in a prefix
-       and a power prior to writing - see the function
-       __fprintf_scientific().
+    1. For both double and float the value is split in a prefix and a
+       power prior to writing - see scientific_split().
 
-    3. The logical type involves converting back and forth between 'T'
-       and 'F' and internal logical representation. The format strings
-       are therefore for reading/writing a character.
+    2. The logical type involves converting back and forth between 'T'
+       and 'F' and internal logical representation.
 
+   Formatted files are written with the FormattedWriter and read with the
+   FormattedScanner below.
 */
 
-#define READ_FMT_CHAR "%8c"
-#define READ_FMT_FLOAT "%gE"
-#define READ_FMT_INT "%d"
-#define READ_FMT_MESS "%8c"
-#define READ_FMT_BOOL "  %c"
-#define READ_FMT_DOUBLE "%lgD%d"
-
-#define WRITE_FMT_CHAR " '%-8s'"
-#define WRITE_FMT_INT " %11d"
 #define WRITE_FMT_FLOAT "  %11.8fE%+03d"
 #define WRITE_FMT_DOUBLE "  %17.14fD%+03d"
-#define WRITE_FMT_MESS "%s"
-#define WRITE_FMT_BOOL "  %c"
 
 /* The boolean type is not a native type which can be uniquely
    identified between Fortran, C, formatted and unformatted
@@ -121,58 +128,6 @@ UTIL_IS_INSTANCE_FUNCTION(rd_kw, RD_KW_TYPE_ID)
 rd_type_enum rd_kw_get_type(const rd_kw_type *);
 void rd_kw_set_data_type(rd_kw_type *rd_kw, rd_data_type data_type);
 
-static std::string read_fmt_string(const rd_data_type rd_type) {
-    return fmt::format("%{}c", rd_type_get_sizeof_iotype(rd_type));
-}
-
-static std::string read_fmt(const rd_data_type data_type) {
-    switch (rd_type_get_type(data_type)) {
-    case (RD_CHAR_TYPE):
-        return READ_FMT_CHAR;
-    case (RD_INT_TYPE):
-        return READ_FMT_INT;
-    case (RD_FLOAT_TYPE):
-        return READ_FMT_FLOAT;
-    case (RD_DOUBLE_TYPE):
-        return READ_FMT_DOUBLE;
-    case (RD_BOOL_TYPE):
-        return READ_FMT_BOOL;
-    case (RD_MESS_TYPE):
-        return READ_FMT_MESS;
-    case (RD_STRING_TYPE):
-        return read_fmt_string(data_type);
-    default:
-        throw std::invalid_argument(
-            fmt::format("invalid rd_type: {}", rd_type_name(data_type)));
-    }
-}
-
-static std::string write_fmt_string(const rd_data_type rd_type) {
-    return fmt::format(" '%-{}s'", rd_type_get_sizeof_iotype(rd_type));
-}
-
-static std::string write_fmt(const rd_data_type data_type) {
-    switch (rd_type_get_type(data_type)) {
-    case (RD_CHAR_TYPE):
-        return WRITE_FMT_CHAR;
-    case (RD_INT_TYPE):
-        return WRITE_FMT_INT;
-    case (RD_FLOAT_TYPE):
-        return WRITE_FMT_FLOAT;
-    case (RD_DOUBLE_TYPE):
-        return WRITE_FMT_DOUBLE;
-    case (RD_BOOL_TYPE):
-        return WRITE_FMT_BOOL;
-    case (RD_MESS_TYPE):
-        return WRITE_FMT_MESS;
-    case (RD_STRING_TYPE):
-        return write_fmt_string(data_type);
-    default:
-        throw std::invalid_argument(
-            fmt::format("invalid rd_type: {}", rd_type_name(data_type)));
-    }
-}
-
 static int get_blocksize(rd_data_type data_type) {
     if (rd_type_is_alpha(data_type))
         return BLOCKSIZE_CHAR;
@@ -210,31 +165,35 @@ static void rd_kw_assert_index(const rd_kw_type *rd_kw, int index,
                         rd_kw->header, index, rd_kw->size));
 }
 
-static char *rd_kw_alloc_output_buffer(const rd_kw_type *rd_kw) {
+/**
+   Encodes @count elements of @rd_kw, starting at element @first, in the
+   on-disk representation into @buffer, which must have room for @count
+   elements of the io type.
+*/
+static void rd_kw_encode_output(const rd_kw_type *rd_kw, int first, int count,
+                                char *buffer) {
     size_t sizeof_iotype = rd_type_get_sizeof_iotype(rd_kw->data_type);
-    size_t buffer_size = rd_kw->size * sizeof_iotype;
-    char *buffer = (char *)util_malloc(buffer_size);
 
     if (rd_type_is_bool(rd_kw->data_type)) {
         int *int_data = (int *)buffer;
-        bool *bool_data = (bool *)rd_kw->data;
+        const bool *bool_data = (const bool *)rd_kw->data + first;
 
-        for (int i = 0; i < rd_kw->size; i++)
+        for (int i = 0; i < count; i++)
             if (bool_data[i])
                 int_data[i] = RD_BOOL_TRUE_INT;
             else
                 int_data[i] = RD_BOOL_FALSE_INT;
 
-        util_endian_flip_vector(buffer, sizeof_iotype, rd_kw->size);
-        return buffer;
+        util_endian_flip_vector(buffer, sizeof_iotype, count);
+        return;
     }
 
     if (rd_type_is_char(rd_kw->data_type) ||
         rd_type_is_string(rd_kw->data_type)) {
         size_t sizeof_ctype = rd_type_get_sizeof_ctype(rd_kw->data_type);
-        for (int i = 0; i < rd_kw->size; i++) {
+        for (int i = 0; i < count; i++) {
             size_t buffer_offset = i * sizeof_iotype;
-            size_t data_offset = i * sizeof_ctype;
+            size_t data_offset = (first + i) * sizeof_ctype;
             size_t string_length = strlen(&rd_kw->data[data_offset]);
 
             for (size_t i = 0; i < string_length; i++)
@@ -245,18 +204,17 @@ static char *rd_kw_alloc_output_buffer(const rd_kw_type *rd_kw) {
                 buffer[buffer_offset + i] = ' ';
         }
 
-        return buffer;
+        return;
     }
 
     if (rd_type_is_mess(rd_kw->data_type))
-        return buffer;
+        return;
 
+    size_t buffer_size = count * sizeof_iotype;
     if (rd_kw->data && buffer_size > 0) {
-        memcpy(buffer, rd_kw->data, buffer_size);
-        util_endian_flip_vector(buffer, sizeof_iotype, rd_kw->size);
+        memcpy(buffer, rd_kw->data + first * sizeof_iotype, buffer_size);
+        util_endian_flip_vector(buffer, sizeof_iotype, count);
     }
-
-    return buffer;
 }
 
 static char *rd_kw_alloc_input_buffer(const rd_kw_type *rd_kw) {
@@ -277,25 +235,30 @@ static char *rd_kw_alloc_input_buffer(const rd_kw_type *rd_kw) {
     return buffer;
 }
 
-static void rd_kw_load_from_input_buffer(rd_kw_type *rd_kw, char *buffer) {
+/**
+   Decodes @count elements in on-disk representation from @src into the
+   data storage of @rd_kw, starting at element @first. The source buffer is
+   not modified, so this can be used both with a private input buffer and
+   with a read only memory mapping of the file.
+*/
+static void rd_kw_load_elements(rd_kw_type *rd_kw, int first, int count,
+                                const char *src) {
     size_t sizeof_iotype = rd_type_get_sizeof_iotype(rd_kw->data_type);
     size_t sizeof_ctype = rd_type_get_sizeof_ctype(rd_kw->data_type);
-    size_t buffer_size = rd_kw->size * sizeof_iotype;
-    if (RD_ENDIAN_FLIP) {
-        if (rd_type_is_numeric(rd_kw->data_type) ||
-            rd_type_is_bool(rd_kw->data_type))
-            util_endian_flip_vector(buffer, sizeof_iotype, rd_kw->size);
-    }
 
     /*
     Special case bool: Return Eclipse integer representation of bool to native bool.
   */
     if (rd_type_is_bool(rd_kw->data_type)) {
-        int *int_data = (int *)buffer;
-        bool *bool_data = (bool *)rd_kw->data;
+        bool *bool_data = (bool *)rd_kw->data + first;
+
+        for (int i = 0; i < count; i++) {
+            int int_value;
+            memcpy(&int_value, &src[i * sizeof_iotype], sizeof int_value);
+            if (RD_ENDIAN_FLIP)
+                util_endian_flip_vector(&int_value, sizeof int_value, 1);
 
-        for (int i = 0; i < rd_kw->size; i++) {
-            if (int_data[i] == RD_BOOL_TRUE_INT)
+            if (int_value == RD_BOOL_TRUE_INT)
                 bool_data[i] = true;
             else
                 bool_data[i] = false;
@@ -311,12 +274,12 @@ static void rd_kw_load_from_input_buffer(rd_kw_type *rd_kw, char *buffer) {
     if (rd_type_is_char(rd_kw->data_type) ||
         rd_type_is_string(rd_kw->data_type)) {
         const char null_char = '\0';
-        for (int i = 0; i < rd_kw->size; i++) {
+        char *data = &rd_kw->data[first * sizeof_ctype];
+        for (int i = 0; i < count; i++) {
             size_t buffer_offset = i * sizeof_iotype;
             size_t data_offset = i * sizeof_ctype;
-            memcpy(&rd_kw->data[data_offset], &buffer[buffer_offset],
-                   sizeof_iotype);
-            rd_kw->data[data_offset + sizeof_iotype] = null_char;
+            memcpy(&data[data_offset], &src[buffer_offset], sizeof_iotype);
+            data[data_offset + sizeof_iotype] = null_char;
         }
         return;
     }
@@ -327,7 +290,79 @@ static void rd_kw_load_from_input_buffer(rd_kw_type *rd_kw, char *buffer) {
     /*
     Plain int, double, float data - that can be copied straight over to the ->data field.
   */
-    memcpy(rd_kw->data, buffer, buffer_size);
+    char *data = &rd_kw->data[first * sizeof_ctype];
+    memcpy(data, src, count * sizeof_iotype);
+    if (RD_ENDIAN_FLIP)
+        util_endian_flip_vector(data, sizeof_iotype, count);
+}
+
+static void rd_kw_load_from_input_buffer(rd_kw_type *rd_kw,
+                                         const char *buffer) {
+    rd_kw_load_elements(rd_kw, 0, rd_kw->size, buffer);
+}
+
+/**
+   Calls @load(index, count, record) for the data records of a keyword
+   of @element_count elements of @data_type in the @size bytes at @data,
+   starting at @offset; record holds @count elements in on-disk
+   representation, to be stored from element @index. On success @offset
+   is updated to point past the last record of the keyword.
+*/
+template <typename Load>
+static bool rd_kw_for_each_record(const ERT::FortIO &fortio,
+                                  rd_data_type data_type, int element_count,
+                                  const char *data, offset_type size,
+                                  offset_type &offset, Load load) {
+    const int sizeof_iotype = rd_type_get_sizeof_iotype(data_type);
+    int index = 0;
+
+    while (index < element_count) {
+        int record_size;
+        const char *record =
+            fortio.buffer_record(data, size, offset, record_size);
+        if (record == nullptr)
+            return false;
+
+        if (record_size % sizeof_iotype != 0)
+            return false;
+
+        int count = record_size / sizeof_iotype;
+        if (count > element_count - index)
+            return false;
+
+        load(index, count, record);
+        index += count;
+    }
+    return true;
+}
+
+/**
+   Decodes the data records of @rd_kw from the @size bytes at @data,
+   starting at @offset, straight into the rd_kw storage. On success
+   @offset is updated to point past the last record of the keyword.
+*/
+static bool rd_kw_load_records(rd_kw_type *rd_kw, const ERT::FortIO &fortio,
+                               const char *data, offset_type size,
+                               offset_type &offset) {
+    return rd_kw_for_each_record(
+        fortio, rd_kw->data_type, rd_kw->size, data, size, offset,
+        [rd_kw](int index, int count, const char *record) {
+            rd_kw_load_elements(rd_kw, index, count, record);
+        });
+}
+
+/**
+   Reads the data section of @rd_kw from a memory mapped fortio instance,
+   without any intermediate input buffer. On success the fortio stream is
+   positioned after the last record of the keyword.
+*/
+static bool rd_kw_fread_mapped_data(rd_kw_type *rd_kw, ERT::FortIO &fortio) {
+    offset_type offset = fortio.ftell();
+    if (!rd_kw_load_records(rd_kw, fortio, fortio.mapped_data(),
+                            fortio.mapped_size(), offset))
+        return false;
+
+    return fortio.fseek(offset, SEEK_SET);
 }
 
 static const char *rd_kw_get_header8(const rd_kw_type *rd_kw) {
@@ -500,19 +535,24 @@ static void rd_kw_initialize(rd_kw_type *rd_kw, const char *header, int size,
     rd_kw->size = size;
 }
 
-static size_t rd_kw_fortio_data_size(const rd_kw_type *rd_kw) {
-    if (rd_kw->size < 0)
+static size_t rd_kw_fortio_data_size__(rd_data_type data_type,
+                                       int element_count) {
+    if (element_count < 0)
         throw std::invalid_argument(
-            fmt::format("rd_kw->size was negative: {}", rd_kw->size));
+            fmt::format("rd_kw->size was negative: {}", element_count));
 
-    const int blocksize = get_blocksize(rd_kw->data_type);
+    const int blocksize = get_blocksize(data_type);
     const int num_blocks =
-        rd_kw->size / blocksize + (rd_kw->size % blocksize == 0 ? 0 : 1);
+        element_count / blocksize + (element_count % blocksize == 0 ? 0 : 1);
 
     return static_cast<size_t>(num_blocks) *
                (4 + 4) + // Fortran fluff for each block
-           static_cast<size_t>(rd_kw->size) *
-               rd_type_get_sizeof_iotype(rd_kw->data_type); // Actual data
+           static_cast<size_t>(element_count) *
+               rd_type_get_sizeof_iotype(data_type); // Actual data
+}
+
+static size_t rd_kw_fortio_data_size(const rd_kw_type *rd_kw) {
+    return rd_kw_fortio_data_size__(rd_kw->data_type, rd_kw->size);
 }
 
 /**
@@ -528,7 +568,33 @@ size_t rd_kw_fortio_size(const rd_kw_type *rd_kw) {
 }
 
 /**
-   This is where the storage buffer of the rd_kw is allocated.
+   As rd_kw_fortio_size(), for a keyword of @element_count elements of
+   type @data_type.
+*/
+size_t rd_kw_fortio_size__(rd_data_type data_type, int element_count) {
+    return RD_KW_HEADER_FORTIO_SIZE +
+           rd_kw_fortio_data_size__(data_type, element_count);
+}
+
+/**
+   Gives the storage buffer back to the allocator it came from.
+*/
+static void rd_kw_free_data(rd_kw_type *rd_kw) {
+    if (!rd_kw->shared_data && rd_kw->data != NULL) {
+        if (rd_kw->allocator)
+            rd_kw->allocator->deallocate(rd_kw->data, rd_kw->data_bytes);
+        else
+            free(rd_kw->data);
+    }
+
+    rd_kw->data = NULL;
+    rd_kw->allocator = NULL;
+    rd_kw->data_bytes = 0;
+}
+
+/**
+   This is where the storage buffer of the rd_kw is allocated, from
+   rd::current_kw_allocator().
 */
 static void rd_kw_alloc_data(rd_kw_type *rd_kw) {
     if (rd_kw->shared_data)
@@ -536,18 +602,23 @@ static void rd_kw_alloc_data(rd_kw_type *rd_kw) {
             "trying to allocate data for rd_kw object which has been declared "
             "with shared storage");
 
-    {
-
-        if (rd_kw->size < 0)
-            throw std::invalid_argument(
-                fmt::format("rd_kw size was negative: {}", rd_kw->size));
-        size_t byte_size = static_cast<size_t>(rd_kw->size) *
-                           rd_type_get_sizeof_ctype(rd_kw->data_type);
-        rd_kw->data = (char *)util_realloc(rd_kw->data, byte_size);
-        if (rd_kw->data) {
-            memset(rd_kw->data, 0, byte_size);
+    if (rd_kw->size < 0)
+        throw std::invalid_argument(
+            fmt::format("rd_kw size was negative: {}", rd_kw->size));
+    size_t byte_size = static_cast<size_t>(rd_kw->size) *
+                       rd_type_get_sizeof_ctype(rd_kw->data_type);
+    if (rd_kw->data == NULL || rd_kw->data_bytes != byte_size) {
+        rd_kw_free_data(rd_kw);
+        if (byte_size > 0) {
+            rd::KWAllocator &allocator = rd::current_kw_allocator();
+            rd_kw->data = static_cast<char *>(allocator.allocate(byte_size));
+            rd_kw->allocator = &allocator;
+            rd_kw->data_bytes = byte_size;
         }
     }
+    if (rd_kw->data) {
+        memset(rd_kw->data, 0, byte_size);
+    }
 }
 
 /**
@@ -587,6 +658,8 @@ rd_kw_type *rd_kw_alloc_empty() {
     rd_kw->header8 = NULL;
     rd_kw->data = NULL;
     rd_kw->shared_data = false;
+    rd_kw->allocator = NULL;
+    rd_kw->data_bytes = 0;
     rd_kw->size = 0;
 
     UTIL_TYPE_ID_INIT(rd_kw, RD_KW_TYPE_ID);
@@ -594,12 +667,6 @@ rd_kw_type *rd_kw_alloc_empty() {
     return rd_kw;
 }
 
-static void rd_kw_free_data(rd_kw_type *rd_kw) {
-    if (!rd_kw->shared_data)
-        free(rd_kw->data);
-
-    rd_kw->data = NULL;
-}
 
 void rd_kw_free(rd_kw_type *rd_kw) {
     free(rd_kw->header);
@@ -714,10 +781,23 @@ void rd_kw_resize(rd_kw_type *rd_kw, int new_size) {
         size_t new_byte_size = static_cast<size_t>(new_size) *
                                rd_type_get_sizeof_ctype(rd_kw->data_type);
 
-        rd_kw->data = (char *)util_realloc(rd_kw->data, new_byte_size);
-        if (new_byte_size > old_byte_size) {
-            size_t offset = old_byte_size;
-            memset(&rd_kw->data[offset], 0, new_byte_size - old_byte_size);
+        /* The new buffer comes from the allocator of the old one. */
+        rd::KWAllocator *allocator = rd_kw->allocator;
+        if (rd_kw->data == NULL || allocator == NULL)
+            allocator = &rd::current_kw_allocator();
+        char *new_data = NULL;
+        if (new_byte_size > 0) {
+            new_data = static_cast<char *>(allocator->allocate(new_byte_size));
+            size_t copy_size = std::min(old_byte_size, new_byte_size);
+            if (copy_size > 0)
+                memcpy(new_data, rd_kw->data, copy_size);
+            memset(&new_data[copy_size], 0, new_byte_size - copy_size);
+        }
+        rd_kw_free_data(rd_kw);
+        rd_kw->data = new_data;
+        if (new_data) {
+            rd_kw->allocator = allocator;
+            rd_kw->data_bytes = new_byte_size;
         }
         rd_kw->size = new_size;
     }
@@ -1072,115 +1152,296 @@ static bool rd_kw_fscanf_qstring(char *s, const char *fmt, int len,
     return OK;
 }
 
+namespace {
+
+/* Upper limit on the chunks read by the FormattedScanner. */
+constexpr size_t formatted_chunk_size = 1 << 20;
+/* Longest number token in a formatted file. */
+constexpr size_t formatted_max_token = 64;
+
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  Reads the data section of formatted keywords in large chunks, and
+  tokenizes it in memory instead of calling fscanf() once per element.
+  Reading starts at the current position of the fortio stream, and
+  finish() positions the stream after the characters consumed.
 */
-/** Should be: NESTED */
-
-static double __fscanf_RD_double(FILE *stream, const char *fmt) {
-    int read_count, power;
-    double value, arg;
-    read_count = fscanf(stream, fmt, &arg, &power);
-    if (read_count == 2)
-        value = arg * pow(10, power);
-    else {
-        throw std::runtime_error("read failed");
-        value = -1;
+class FormattedScanner {
+public:
+    FormattedScanner(ERT::FortIO &fortio, size_t chunk_size)
+        : fortio(fortio), stream(fortio.get_FILE()), offset(fortio.ftell()),
+          buffer(std::clamp<size_t>(chunk_size, 4096, formatted_chunk_size)) {
+    }
+
+    /* Skips white space, returns false at the end of the file. */
+    bool skip_space() {
+        while (true) {
+            while (pos < end && is_space(buffer[pos]))
+                pos++;
+            if (pos < end)
+                return true;
+            if (!fill(1))
+                return false;
+        }
+    }
+
+    /* The characters up to the next white space. */
+    std::string_view token() {
+        fill(formatted_max_token);
+        size_t start = pos;
+        while (pos < end && !is_space(buffer[pos]))
+            pos++;
+        return {&buffer[start], pos - start};
     }
-    return value;
+
+    /* Skips past the next quote, returns false at the end of the file. */
+    bool skip_quote() {
+        while (true) {
+            while (pos < end && buffer[pos] != '\'')
+                pos++;
+            if (pos < end) {
+                pos++;
+                return true;
+            }
+            if (!fill(1))
+                return false;
+        }
+    }
+
+    /* The next @size characters, fewer at the end of the file. */
+    std::string_view chars(size_t size) {
+        fill(size);
+        size_t count = std::min(size, end - pos);
+        std::string_view value(&buffer[pos], count);
+        pos += count;
+        return value;
+    }
+
+    void finish() { fortio.fseek(offset + pos, SEEK_SET); }
+
+private:
+    ERT::FortIO &fortio;
+    FILE *stream;
+    offset_type offset; /* File offset of buffer[0] */
+    std::vector<char> buffer;
+    size_t pos = 0;
+    size_t end = 0;
+    bool at_eof = false;
+
+    static bool is_space(char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    /* Buffers at least @size characters after pos, unless the file ends
+       first. Returns false if there are no characters left. */
+    bool fill(size_t size) {
+        if (end - pos >= size)
+            return true;
+
+        std::memmove(buffer.data(), buffer.data() + pos, end - pos);
+        offset += pos;
+        end -= pos;
+        pos = 0;
+        if (buffer.size() < size)
+            buffer.resize(size);
+
+        while (end < size && !at_eof) {
+            size_t bytes_read =
+                fread(buffer.data() + end, 1, buffer.size() - end, stream);
+            if (bytes_read == 0)
+                at_eof = true;
+            end += bytes_read;
+        }
+        return end > 0;
+    }
+};
+
+template <typename T> bool parse_number(std::string_view token, T &value) {
+    if (!token.empty() && token[0] == '+')
+        token.remove_prefix(1);
+
+    const char *last = token.data() + token.size();
+#if defined(__cpp_lib_to_chars)
+    auto [ptr, ec] = std::from_chars(token.data(), last, value);
+    return ec == std::errc() && ptr == last;
+#else
+    if constexpr (std::is_integral_v<T>) {
+        auto [ptr, ec] = std::from_chars(token.data(), last, value);
+        return ec == std::errc() && ptr == last;
+    } else {
+        if (token.size() >= formatted_max_token)
+            return false;
+        char text[formatted_max_token];
+        memcpy(text, token.data(), token.size());
+        text[token.size()] = '\0';
+        char *text_end;
+        value = static_cast<T>(strtod(text, &text_end));
+        return text_end == text + token.size();
+    }
+#endif
+}
+
+/*
+  Parses a real number, where the exponent can be marked with 'D' as
+  written by Fortran. A double with a 'D' exponent is computed as
+  prefix * 10^power, which is how the formatted reader has always
+  combined the two parts.
+*/
+template <typename T> bool parse_real(std::string_view token, T &value) {
+    size_t exp_pos = token.find_first_of("Dd");
+    if (exp_pos == std::string_view::npos)
+        return parse_number(token, value);
+
+    double prefix;
+    int power;
+    if (!parse_number(token.substr(0, exp_pos), prefix) ||
+        !parse_number(token.substr(exp_pos + 1), power))
+        return false;
+
+    value = static_cast<T>(prefix * pow(10, power));
+    return true;
+}
+
+} // namespace
+
+/*
+  Reads one element of type @data_type from @scanner into @target, which
+  has the layout of the rd_kw storage. Returns false if the element could
+  not be parsed.
+*/
+static bool rd_kw_scan_element(FormattedScanner &scanner,
+                               rd_data_type data_type, char *target) {
+    switch (rd_type_get_type(data_type)) {
+    case (RD_CHAR_TYPE):
+    case (RD_MESS_TYPE):
+    case (RD_STRING_TYPE): {
+        size_t length = rd_type_get_sizeof_iotype(data_type);
+        if (!scanner.skip_quote())
+            return false;
+
+        std::string_view value = scanner.chars(length);
+        if (value.size() != length)
+            return false;
+        memcpy(target, value.data(), length);
+        target[length] = '\0';
+        /* The closing quote */
+        return scanner.chars(1).size() == 1;
+    }
+    case (RD_INT_TYPE): {
+        int value;
+        if (!scanner.skip_space() || !parse_number(scanner.token(), value))
+            return false;
+        memcpy(target, &value, sizeof value);
+        return true;
+    }
+    case (RD_FLOAT_TYPE): {
+        float value;
+        if (!scanner.skip_space() || !parse_real(scanner.token(), value))
+            return false;
+        memcpy(target, &value, sizeof value);
+        return true;
+    }
+    case (RD_DOUBLE_TYPE): {
+        double value;
+        if (!scanner.skip_space() || !parse_real(scanner.token(), value))
+            return false;
+        memcpy(target, &value, sizeof value);
+        return true;
+    }
+    case (RD_BOOL_TYPE): {
+        if (!scanner.skip_space())
+            return false;
+
+        std::string_view value = scanner.chars(1);
+        bool bool_value;
+        if (value[0] == BOOL_TRUE_CHAR)
+            bool_value = true;
+        else if (value[0] == BOOL_FALSE_CHAR)
+            bool_value = false;
+        else
+            throw std::runtime_error(
+                fmt::format("Logical value: [{}] not recogniced", value[0]));
+        memcpy(target, &bool_value, sizeof bool_value);
+        return true;
+    }
+    default:
+        throw std::runtime_error(
+            fmt::format("Internal error: internal eclipse_type: {} not "
+                        "recognized",
+                        rd_type_get_type(data_type)));
+    }
+}
+
+/* As rd_kw_scan_element(), without converting the element. */
+static bool rd_kw_skip_element(FormattedScanner &scanner,
+                               rd_data_type data_type) {
+    switch (rd_type_get_type(data_type)) {
+    case (RD_CHAR_TYPE):
+    case (RD_MESS_TYPE):
+    case (RD_STRING_TYPE): {
+        size_t length = rd_type_get_sizeof_iotype(data_type) + 1;
+        return scanner.skip_quote() && scanner.chars(length).size() == length;
+    }
+    case (RD_BOOL_TYPE):
+        return scanner.skip_space() && scanner.chars(1).size() == 1;
+    default:
+        return scanner.skip_space() && !scanner.token().empty();
+    }
+}
+
+/* An estimate of the size of @element_count formatted elements. */
+static size_t rd_kw_formatted_size(rd_data_type data_type,
+                                   int element_count) {
+    size_t width;
+    switch (rd_type_get_type(data_type)) {
+    case (RD_INT_TYPE):
+        width = 12;
+        break;
+    case (RD_FLOAT_TYPE):
+        width = 17;
+        break;
+    case (RD_DOUBLE_TYPE):
+        width = 23;
+        break;
+    case (RD_BOOL_TYPE):
+        width = 3;
+        break;
+    default:
+        width = rd_type_get_sizeof_iotype(data_type) + 3;
+    }
+    return width * element_count + width + formatted_max_token;
+}
+
+/*
+  Reads the formatted data of @rd_kw, and positions the stream after the
+  trailing newline of the keyword.
+*/
+static bool rd_kw_fread_formatted_data(rd_kw_type *rd_kw,
+                                       ERT::FortIO &fortio) {
+    FormattedScanner scanner(
+        fortio, rd_kw_formatted_size(rd_kw->data_type, rd_kw->size));
+    const int sizeof_ctype = rd_type_get_sizeof_ctype(rd_kw->data_type);
+    for (int index = 0; index < rd_kw->size; index++) {
+        if (!rd_kw_scan_element(scanner, rd_kw->data_type,
+                                &rd_kw->data[index * sizeof_ctype]))
+            throw std::runtime_error(
+                fmt::format("after reading {} values reading of keyword:{} "
+                            "from:{} failed",
+                            index, rd_kw->header8, fortio.filename_ref()));
+    }
+    scanner.finish();
+
+    /* Skip the trailing newline */
+    fortio.fseek(1, SEEK_CUR);
+    return true;
 }
 
 static bool rd_kw_fread_data(rd_kw_type *rd_kw, ERT::FortIO &fortio) {
     bool fmt_file = fortio.fmt_file();
     if (rd_kw->size > 0) {
-        const int blocksize = get_blocksize(rd_kw->data_type);
         if (fmt_file) {
-            const int blocks = rd_kw->size / blocksize +
-                               (rd_kw->size % blocksize == 0 ? 0 : 1);
-            const std::string read_format = read_fmt(rd_kw->data_type);
-            FILE *stream = fortio.get_FILE();
-            int offset = 0;
-            int index = 0;
-            int ib, ir;
-            for (ib = 0; ib < blocks; ib++) {
-                int read_elm = util_int_min((ib + 1) * blocksize, rd_kw->size) -
-                               ib * blocksize;
-                for (ir = 0; ir < read_elm; ir++) {
-                    switch (rd_kw_get_type(rd_kw)) {
-                    case (RD_CHAR_TYPE):
-                        rd_kw_fscanf_qstring(&rd_kw->data[offset],
-                                             read_format.c_str(), 8, stream);
-                        break;
-                    case (RD_STRING_TYPE):
-                        rd_kw_fscanf_qstring(&rd_kw->data[offset],
-                                             read_format.c_str(),
-                                             rd_type_get_sizeof_iotype(
-                                                 rd_kw_get_data_type(rd_kw)),
-                                             stream);
-                        break;
-                    case (RD_INT_TYPE): {
-                        int iread = fscanf(stream, read_format.c_str(),
-                                           (int *)&rd_kw->data[offset]);
-                        if (iread != 1)
-                            throw std::runtime_error(fmt::format(
-                                "after reading {} values reading of keyword:{} "
-                                "from:{} failed",
-                                offset /
-                                    rd_type_get_sizeof_ctype(rd_kw->data_type),
-                                rd_kw->header8, fortio.filename_ref()));
-                    } break;
-                    case (RD_FLOAT_TYPE): {
-                        int iread = fscanf(stream, read_format.c_str(),
-                                           (float *)&rd_kw->data[offset]);
-                        if (iread != 1) {
-                            throw std::runtime_error(fmt::format(
-                                "after reading {} values reading of keyword:{} "
-                                "from:{} failed",
-                                offset /
-                                    rd_type_get_sizeof_ctype(rd_kw->data_type),
-                                rd_kw->header8, fortio.filename_ref()));
-                        }
-                    } break;
-                    case (RD_DOUBLE_TYPE): {
-                        double value =
-                            __fscanf_RD_double(stream, read_format.c_str());
-                        rd_kw_iset(rd_kw, index, &value);
-                    } break;
-                    case (RD_BOOL_TYPE): {
-                        char bool_char;
-                        if (fscanf(stream, read_format.c_str(), &bool_char) ==
-                            1) {
-                            if (bool_char == BOOL_TRUE_CHAR)
-                                rd_kw_iset_bool(rd_kw, index, true);
-                            else if (bool_char == BOOL_FALSE_CHAR)
-                                rd_kw_iset_bool(rd_kw, index, false);
-                            else
-                                throw std::runtime_error(fmt::format(
-                                    "Logical value: [{}] not recogniced",
-                                    bool_char));
-                        } else
-                            throw std::runtime_error(
-                                "read failed - premature file end?");
-                    } break;
-                    case (RD_MESS_TYPE):
-                        rd_kw_fscanf_qstring(&rd_kw->data[offset],
-                                             read_format.c_str(), 8, stream);
-                        break;
-                    default:
-                        throw std::runtime_error(
-                            fmt::format("Internal error: internal "
-                                        "eclipse_type: {} not recognized",
-                                        rd_kw_get_type(rd_kw)));
-                    }
-                    offset += rd_type_get_sizeof_ctype(rd_kw->data_type);
-                    index++;
-                }
-            }
-
-            /* Skip the trailing newline */
-            fortio.fseek(1, SEEK_CUR);
-            return true;
+            return rd_kw_fread_formatted_data(rd_kw, fortio);
+        } else if (fortio.is_mapped()) {
+            return rd_kw_fread_mapped_data(rd_kw, fortio);
         } else {
             char *buffer = rd_kw_alloc_input_buffer(rd_kw);
             const int sizeof_iotype =
@@ -1199,57 +1460,173 @@ static bool rd_kw_fread_data(rd_kw_type *rd_kw, ERT::FortIO &fortio) {
         return true;
 }
 
+/**
+   Byte offset, relative to the start of the keyword data section, of
+   element @element_index in an unformatted file. Every block of
+   @block_size elements is a separate fortran record, i.e. it is preceded
+   by a 4 byte header and followed by a 4 byte tail.
+*/
+static offset_type rd_kw_element_data_offset(int element_index,
+                                             int sizeof_iotype,
+                                             int block_size) {
+    offset_type block_index = element_index / block_size;
+    offset_type headers = (block_index + 1) * 4;
+    offset_type trailers = block_index * 4;
+    return headers + trailers +
+           static_cast<offset_type>(element_index) * sizeof_iotype;
+}
+
 /**
    Reads a selection of elements (given by @index_map) from the data
    section of a single keyword. The @kw_offset argument is the byte
    offset of the start of the keyword (i.e. its header) in the file,
    as stored by rd_file_kw.
+
+   For unformatted files the requested elements are sorted on their
+   position in the file, and elements which are separated by at most
+   @max_gap bytes are merged into one contiguous range read; the bytes in
+   between, including the fortran record markers, are read and
+   discarded. The elements are then scattered back into @io_buffer in the
+   order given by @index_map.
 */
 void rd_kw_fread_indexed_data(ERT::FortIO &fortio, offset_type kw_offset,
                               rd_data_type data_type, int element_count,
                               const int_vector_type *index_map,
-                              char *io_buffer) {
+                              char *io_buffer, offset_type max_gap) {
     int sizeof_iotype = rd_type_get_sizeof_iotype(data_type);
 
     // For unformatted (binary) files the individual elements have a fixed
     // on-disk size, so we can seek directly to each requested element. For
     // formatted (ASCII) files the elements have a variable text width and
-    // direct seeking is not possible; in that case we read the whole
-    // keyword and extract the requested elements afterwards.
+    // direct seeking is not possible; in that case we scan the elements up
+    // to the last requested one, and only convert the requested elements.
     if (fortio.fmt_file()) {
         fortio.fseek(kw_offset, SEEK_SET);
-        rd_kw_ptr rd_kw(rd_kw_fread_alloc(fortio), rd_kw_free);
-        if (rd_kw == NULL)
+        rd_kw_ptr rd_kw = make_rd_kw();
+        if (rd_kw_fread_header(rd_kw.get(), fortio) != RD_KW_READ_OK)
             throw std::runtime_error(fmt::format(
                 "failed to load keyword at offset:{}", (long)kw_offset));
 
-        for (int index = 0; index < int_vector_size(index_map); index++) {
+        const int num_elements = int_vector_size(index_map);
+        std::vector<int> order(num_elements);
+        for (int index = 0; index < num_elements; index++) {
             int element_index = int_vector_iget(index_map, index);
-            memcpy(&io_buffer[index * sizeof_iotype],
-                   rd_kw_iget_ptr(rd_kw.get(), element_index), sizeof_iotype);
+            if (element_index < 0 || element_index >= rd_kw->size)
+                throw std::invalid_argument(
+                    fmt::format("Element index is out of range 0 <= {} < {}",
+                                element_index, rd_kw->size));
+            order[index] = index;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return int_vector_iget(index_map, a) <
+                   int_vector_iget(index_map, b);
+        });
+
+        FormattedScanner scanner(
+            fortio, rd_kw_formatted_size(rd_kw->data_type, rd_kw->size));
+        std::vector<char> element(
+            std::max<size_t>(rd_type_get_sizeof_ctype(rd_kw->data_type),
+                             sizeof_iotype));
+        int next_element = 0;
+        for (int index : order) {
+            int element_index = int_vector_iget(index_map, index);
+            for (; next_element <= element_index; next_element++) {
+                bool scan_ok =
+                    next_element < element_index
+                        ? rd_kw_skip_element(scanner, rd_kw->data_type)
+                        : rd_kw_scan_element(scanner, rd_kw->data_type,
+                                             element.data());
+                if (!scan_ok)
+                    throw std::runtime_error(fmt::format(
+                        "after reading {} values reading of keyword:{} "
+                        "from:{} failed",
+                        next_element, rd_kw->header8, fortio.filename_ref()));
+            }
+            memcpy(&io_buffer[index * sizeof_iotype], element.data(),
+                   sizeof_iotype);
         }
+        scanner.finish();
     } else {
         const int block_size = get_blocksize(data_type);
-        FILE *stream = fortio.get_FILE();
+        const int num_elements = int_vector_size(index_map);
         offset_type data_offset = kw_offset + RD_KW_HEADER_FORTIO_SIZE;
 
-        for (int index = 0; index < int_vector_size(index_map); index++) {
+        std::vector<int> order(num_elements);
+        for (int index = 0; index < num_elements; index++) {
             int element_index = int_vector_iget(index_map, index);
 
             if (element_index < 0 || element_index >= element_count)
                 throw std::invalid_argument(
                     fmt::format("Element index is out of range 0 <= {} < {}",
                                 element_index, element_count));
+            order[index] = index;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return int_vector_iget(index_map, a) <
+                   int_vector_iget(index_map, b);
+        });
+
+        std::vector<char> range_buffer;
+        int range_start = 0;
+        while (range_start < num_elements) {
+            offset_type first_offset = rd_kw_element_data_offset(
+                int_vector_iget(index_map, order[range_start]), sizeof_iotype,
+                block_size);
+            offset_type last_offset = first_offset;
+
+            int range_end = range_start + 1;
+            while (range_end < num_elements) {
+                offset_type next_offset = rd_kw_element_data_offset(
+                    int_vector_iget(index_map, order[range_end]),
+                    sizeof_iotype, block_size);
+                if (next_offset - (last_offset + sizeof_iotype) > max_gap)
+                    break;
+                last_offset = next_offset;
+                range_end++;
+            }
 
-            fortio.data_fseek(data_offset, element_index, sizeof_iotype,
-                              element_count, block_size);
-            util_fread(&io_buffer[index * sizeof_iotype], sizeof_iotype, 1,
-                       stream, __func__);
+            size_t range_size = last_offset - first_offset + sizeof_iotype;
+            const char *range = nullptr;
+            if (fortio.is_mapped() &&
+                data_offset + last_offset + sizeof_iotype <=
+                    fortio.mapped_size()) {
+                range = fortio.mapped_data() + data_offset + first_offset;
+            } else if (fortio.access_hint() ==
+                           ERT::FortIO::AccessHint::STRIDED &&
+                       fortio.can_pread()) {
+                /* A strided reader would refill the whole stdio buffer
+                   for each of the small ranges */
+                range_buffer.resize(range_size);
+                if (!fortio.pread(data_offset + first_offset,
+                                  range_buffer.data(), range_size))
+                    throw std::runtime_error(fmt::format(
+                        "failed to read {} bytes at offset:{} in {}",
+                        range_size, data_offset + first_offset,
+                        fortio.filename()));
+                range = range_buffer.data();
+            } else {
+                range_buffer.resize(range_size);
+                if (!fortio.fseek(data_offset + first_offset, SEEK_SET))
+                    throw std::runtime_error(fmt::format(
+                        "failed to seek to offset:{} in {}",
+                        data_offset + first_offset, fortio.filename()));
+                util_fread(range_buffer.data(), 1, range_size,
+                           fortio.get_FILE(), __func__);
+                range = range_buffer.data();
+            }
+
+            for (int index = range_start; index < range_end; index++) {
+                offset_type element_offset = rd_kw_element_data_offset(
+                    int_vector_iget(index_map, order[index]), sizeof_iotype,
+                    block_size);
+                memcpy(&io_buffer[order[index] * sizeof_iotype],
+                       &range[element_offset - first_offset], sizeof_iotype);
+            }
+            range_start = range_end;
         }
 
         if (RD_ENDIAN_FLIP)
-            util_endian_flip_vector(io_buffer, sizeof_iotype,
-                                    int_vector_size(index_map));
+            util_endian_flip_vector(io_buffer, sizeof_iotype, num_elements);
     }
 }
 
@@ -1272,11 +1649,18 @@ bool rd_kw_fskip_data__(rd_data_type data_type, const int element_count,
 
     bool fmt_file = fortio.fmt_file();
     if (fmt_file) {
-        /* Formatted skipping actually involves reading the data - nice ??? */
-        rd_kw_ptr tmp_kw = make_rd_kw();
-        rd_kw_initialize(tmp_kw.get(), "WORK", element_count, data_type);
-        rd_kw_alloc_data(tmp_kw.get());
-        rd_kw_fread_data(tmp_kw.get(), fortio);
+        /* Formatted skipping involves scanning the data, but the elements
+           are not converted */
+        FormattedScanner scanner(
+            fortio, rd_kw_formatted_size(data_type, element_count));
+        for (int index = 0; index < element_count; index++) {
+            if (!rd_kw_skip_element(scanner, data_type))
+                return false;
+        }
+        scanner.finish();
+
+        /* Skip the trailing newline */
+        fortio.fseek(1, SEEK_CUR);
     } else {
         const int blocksize = get_blocksize(data_type);
         const int block_count =
@@ -1311,6 +1695,22 @@ void rd_kw_fskip_header(ERT::FortIO &fortio) {
         fortio.fskip_record();
 }
 
+/**
+   Splits the data of an unformatted header record into the header name,
+   the number of elements and the type name.
+*/
+static void rd_kw_parse_header_record(const char *buffer, char *header,
+                                      int &size, char *rd_type_str) {
+    memcpy(header, &buffer[0], RD_STRING8_LENGTH);
+    memcpy(&size, &buffer[RD_STRING8_LENGTH], sizeof size);
+
+    memcpy(rd_type_str, &buffer[RD_STRING8_LENGTH + sizeof(size)],
+           RD_TYPE_LENGTH);
+
+    if (RD_ENDIAN_FLIP)
+        util_endian_flip_vector(&size, sizeof size, 1);
+}
+
 rd_read_status_enum rd_kw_fread_header(rd_kw_type *rd_kw, ERT::FortIO &fortio) {
     const char null_char = '\0';
     FILE *stream = fortio.get_FILE();
@@ -1335,29 +1735,33 @@ rd_read_status_enum rd_kw_fread_header(rd_kw_type *rd_kw, ERT::FortIO &fortio) {
     } else {
         header[RD_STRING8_LENGTH] = null_char;
         rd_type_str[RD_TYPE_LENGTH] = null_char;
-        record_size = fortio.init_read();
-
-        if (record_size <= 0)
-            return RD_KW_READ_FAIL;
 
         char buffer[RD_KW_HEADER_DATA_SIZE];
-        size_t read_bytes = fread(buffer, 1, RD_KW_HEADER_DATA_SIZE, stream);
+        if (fortio.is_mapped()) {
+            offset_type offset = fortio.ftell();
+            const char *record = fortio.mapped_record(offset, record_size);
+            if (record == nullptr || record_size != RD_KW_HEADER_DATA_SIZE)
+                return RD_KW_READ_FAIL;
+
+            memcpy(buffer, record, RD_KW_HEADER_DATA_SIZE);
+            fortio.fseek(offset, SEEK_SET);
+        } else {
+            record_size = fortio.init_read();
 
-        if (read_bytes != RD_KW_HEADER_DATA_SIZE)
-            return RD_KW_READ_FAIL;
+            if (record_size <= 0)
+                return RD_KW_READ_FAIL;
 
-        memcpy(header, &buffer[0], RD_STRING8_LENGTH);
-        void *ptr = &buffer[RD_STRING8_LENGTH];
-        size = *((int *)ptr);
+            size_t read_bytes =
+                fread(buffer, 1, RD_KW_HEADER_DATA_SIZE, stream);
 
-        memcpy(rd_type_str, &buffer[RD_STRING8_LENGTH + sizeof(size)],
-               RD_TYPE_LENGTH);
+            if (read_bytes != RD_KW_HEADER_DATA_SIZE)
+                return RD_KW_READ_FAIL;
 
-        if (!fortio.complete_read(record_size))
-            return RD_KW_READ_FAIL;
+            if (!fortio.complete_read(record_size))
+                return RD_KW_READ_FAIL;
+        }
 
-        if (RD_ENDIAN_FLIP)
-            util_endian_flip_vector(&size, sizeof size, 1);
+        rd_kw_parse_header_record(buffer, header, size, rd_type_str);
     }
 
     rd_data_type data_type = rd_type_create_from_name(rd_type_str);
@@ -1417,8 +1821,7 @@ bool rd_kw_fseek_kw(const char *kw, bool rewind, bool abort_on_error,
 }
 
 void rd_kw_set_data_ptr(rd_kw_type *rd_kw, void *data) {
-    if (!rd_kw->shared_data)
-        free(rd_kw->data);
+    rd_kw_free_data(rd_kw);
     rd_kw->data = (char *)data;
 }
 
@@ -1455,6 +1858,281 @@ rd_kw_type *rd_kw_fread_alloc(ERT::FortIO &fortio) {
     return rd_kw.release();
 }
 
+/**
+   Reads the keyword starting at @offset with positional reads, see
+   ERT::FortIO::pread(); neither the position nor the state of the fortio
+   stream is used or changed, so several threads can read keywords from
+   the same fortio instance concurrently.
+
+   Returns nullptr if @fortio does not support positional reads, or if the
+   keyword could not be read; the caller can then fall back to the
+   ordinary stream based functions.
+*/
+rd_kw_type *rd_kw_pread_alloc(const ERT::FortIO &fortio, offset_type offset) {
+    if (!fortio.can_pread())
+        return nullptr;
+
+    char header_record[RD_KW_HEADER_FORTIO_SIZE];
+    if (!fortio.pread(offset, header_record, sizeof header_record))
+        return nullptr;
+
+    offset_type record_offset = 0;
+    int record_size;
+    const char *buffer = fortio.buffer_record(
+        header_record, sizeof header_record, record_offset, record_size);
+    if (buffer == nullptr || record_size != RD_KW_HEADER_DATA_SIZE)
+        return nullptr;
+
+    char header[RD_STRING8_LENGTH + 1] = {0};
+    char rd_type_str[RD_TYPE_LENGTH + 1] = {0};
+    int size;
+    rd_kw_parse_header_record(buffer, header, size, rd_type_str);
+    if (size < 0)
+        return nullptr;
+
+    rd_kw_ptr rd_kw = make_rd_kw();
+    rd_kw_initialize(rd_kw.get(), header, size,
+                     rd_type_create_from_name(rd_type_str));
+    rd_kw_alloc_data(rd_kw.get());
+
+    offset_type data_offset = offset + record_offset;
+    bool read_ok;
+    if (fortio.is_mapped()) {
+        read_ok = rd_kw_load_records(rd_kw.get(), fortio, fortio.mapped_data(),
+                                     fortio.mapped_size(), data_offset);
+    } else {
+        /*
+          Assumes the records are blocked as written by rd_kw_fwrite(); for
+          other block sizes the records do not fit the buffer, and the read
+          fails.
+        */
+        std::vector<char> data(rd_kw_fortio_data_size(rd_kw.get()));
+        offset_type buffer_offset = 0;
+        read_ok = fortio.pread(data_offset, data.data(), data.size()) &&
+                  rd_kw_load_records(rd_kw.get(), fortio, data.data(),
+                                     data.size(), buffer_offset);
+    }
+
+    if (!read_ok)
+        return nullptr;
+
+    return rd_kw.release();
+}
+
+/*
+  The functions below read the data of a keyword into a buffer of the
+  caller, of the type of the keyword or, for float keywords, of doubles,
+  without creating an rd_kw. When the types are equal the data is read
+  straight into the buffer where possible and byte flipped in place.
+*/
+
+static void rd_kw_assert_read_into_type(rd_data_type data_type,
+                                        rd_data_type target_type) {
+    bool supported = (rd_type_is_numeric(data_type) ||
+                      rd_type_is_bool(data_type)) &&
+                     rd_type_is_equal(data_type, target_type);
+    if (rd_type_is_float(data_type) && rd_type_is_double(target_type))
+        supported = true;
+
+    if (!supported)
+        throw std::invalid_argument(fmt::format(
+            "can not read keyword data of type {} into {}",
+            rd_type_name(data_type), rd_type_name(target_type)));
+}
+
+/**
+   Decodes @count elements of @data_type in on-disk representation at
+   @src into element @first of @target, see rd_kw_assert_read_into_type().
+   @src may be the memory of the decoded elements when the types are
+   equal.
+*/
+static void rd_kw_decode_into(rd_data_type data_type, const char *src,
+                              int count, rd_data_type target_type,
+                              char *target, int first) {
+    if (rd_type_is_bool(data_type)) {
+        bool *bool_data = reinterpret_cast<bool *>(target) + first;
+        for (int i = 0; i < count; i++) {
+            int int_value;
+            memcpy(&int_value, &src[i * sizeof int_value], sizeof int_value);
+            if (RD_ENDIAN_FLIP)
+                util_endian_flip_vector(&int_value, sizeof int_value, 1);
+            bool_data[i] = (int_value == RD_BOOL_TRUE_INT);
+        }
+        return;
+    }
+
+    if (rd_type_is_float(data_type) && rd_type_is_double(target_type)) {
+        double *double_data = reinterpret_cast<double *>(target) + first;
+        if (RD_ENDIAN_FLIP)
+            util_endian_flip_widen_float(src, double_data, count);
+        else
+            for (int i = 0; i < count; i++) {
+                float value;
+                memcpy(&value, &src[i * sizeof value], sizeof value);
+                double_data[i] = value;
+            }
+        return;
+    }
+
+    const size_t sizeof_ctype = rd_type_get_sizeof_ctype(data_type);
+    char *data = &target[first * sizeof_ctype];
+    if (data != src)
+        memmove(data, src, count * sizeof_ctype);
+    if (RD_ENDIAN_FLIP)
+        util_endian_flip_vector(data, sizeof_ctype, count);
+}
+
+static bool rd_kw_read_into_inplace(rd_data_type data_type,
+                                    rd_data_type target_type) {
+    return rd_type_is_equal(data_type, target_type) &&
+           !rd_type_is_bool(data_type);
+}
+
+/**
+   Copies the data of the loaded @rd_kw into @target, which holds
+   rd_kw_get_size() elements of @target_type.
+*/
+void rd_kw_get_data_into(const rd_kw_type *rd_kw, void *target,
+                         rd_data_type target_type) {
+    rd_kw_assert_read_into_type(rd_kw->data_type, target_type);
+    if (rd_type_is_equal(rd_kw->data_type, target_type)) {
+        rd_kw_get_memcpy_data(rd_kw, target);
+        return;
+    }
+
+    const float *src = reinterpret_cast<const float *>(rd_kw->data);
+    double *double_data = static_cast<double *>(target);
+    for (int i = 0; i < rd_kw->size; i++)
+        double_data[i] = src[i];
+}
+
+/**
+   Reads the data of the keyword of @element_count elements of @data_type
+   starting at @kw_offset into @target, which holds @element_count
+   elements of @target_type. The type is checked as for
+   rd_kw_get_data_into(), and std::invalid_argument is thrown for other
+   combinations.
+
+   Reads with the stream of @fortio, and throws std::runtime_error if the
+   keyword can not be read.
+*/
+void rd_kw_fread_data_into(ERT::FortIO &fortio, offset_type kw_offset,
+                           rd_data_type data_type, int element_count,
+                           void *target, rd_data_type target_type) {
+    rd_kw_assert_read_into_type(data_type, target_type);
+    if (element_count <= 0)
+        return;
+
+    char *target_data = static_cast<char *>(target);
+    bool read_ok;
+    if (fortio.fmt_file()) {
+        if (!fortio.fseek(kw_offset, SEEK_SET))
+            throw std::runtime_error(
+                fmt::format("failed to seek to offset:{} in {}", kw_offset,
+                            fortio.filename_ref()));
+        rd_kw_fskip_header(fortio);
+
+        FormattedScanner scanner(
+            fortio, rd_kw_formatted_size(data_type, element_count));
+        const size_t sizeof_target = rd_type_get_sizeof_ctype(target_type);
+        double element;
+        read_ok = true;
+        for (int index = 0; read_ok && index < element_count; index++) {
+            read_ok = rd_kw_scan_element(scanner, data_type,
+                                         reinterpret_cast<char *>(&element));
+            if (!read_ok)
+                continue;
+            if (rd_type_is_equal(data_type, target_type))
+                memcpy(&target_data[index * sizeof_target], &element,
+                       sizeof_target);
+            else {
+                float value;
+                memcpy(&value, &element, sizeof value);
+                reinterpret_cast<double *>(target)[index] = value;
+            }
+        }
+        if (read_ok)
+            scanner.finish();
+    } else if (fortio.is_mapped()) {
+        offset_type offset = kw_offset + RD_KW_HEADER_FORTIO_SIZE;
+        read_ok = rd_kw_for_each_record(
+            fortio, data_type, element_count, fortio.mapped_data(),
+            fortio.mapped_size(), offset,
+            [&](int index, int count, const char *record) {
+                rd_kw_decode_into(data_type, record, count, target_type,
+                                  target_data, index);
+            });
+    } else {
+        const size_t data_size = static_cast<size_t>(element_count) *
+                                 rd_type_get_sizeof_iotype(data_type);
+        std::vector<char> buffer;
+        char *input = target_data;
+        if (!rd_kw_read_into_inplace(data_type, target_type)) {
+            buffer.resize(data_size);
+            input = buffer.data();
+        }
+
+        read_ok = fortio.fseek(kw_offset, SEEK_SET) &&
+                  fortio.fskip_record() == RD_KW_HEADER_DATA_SIZE &&
+                  fortio.fread_buffer(input, data_size);
+        if (read_ok)
+            rd_kw_decode_into(data_type, input, element_count, target_type,
+                              target_data, 0);
+    }
+
+    if (!read_ok)
+        throw std::runtime_error(
+            fmt::format("failed to read the keyword at offset:{} in {}",
+                        kw_offset, fortio.filename_ref()));
+}
+
+/**
+   As rd_kw_fread_data_into(), with positional reads like
+   rd_kw_pread_alloc(). Returns false if @fortio does not support
+   positional reads, or if the keyword could not be read that way.
+*/
+bool rd_kw_pread_data_into(const ERT::FortIO &fortio, offset_type kw_offset,
+                           rd_data_type data_type, int element_count,
+                           void *target, rd_data_type target_type) {
+    rd_kw_assert_read_into_type(data_type, target_type);
+    if (!fortio.can_pread())
+        return false;
+    if (element_count <= 0)
+        return true;
+
+    char *target_data = static_cast<char *>(target);
+    auto decode = [&](int index, int count, const char *record) {
+        rd_kw_decode_into(data_type, record, count, target_type, target_data,
+                          index);
+    };
+    offset_type data_offset = kw_offset + RD_KW_HEADER_FORTIO_SIZE;
+    if (fortio.is_mapped())
+        return rd_kw_for_each_record(fortio, data_type, element_count,
+                                     fortio.mapped_data(),
+                                     fortio.mapped_size(), data_offset, decode);
+
+    /* Assumes the records are blocked as written by rd_kw_fwrite(), as
+       rd_kw_pread_alloc() */
+    if (rd_kw_read_into_inplace(data_type, target_type)) {
+        const int sizeof_iotype = rd_type_get_sizeof_iotype(data_type);
+        if (!fortio.pread_records(
+                data_offset, target_data,
+                static_cast<size_t>(element_count) * sizeof_iotype,
+                get_blocksize(data_type) * sizeof_iotype))
+            return false;
+        rd_kw_decode_into(data_type, target_data, element_count, target_type,
+                          target_data, 0);
+        return true;
+    }
+
+    std::vector<char> data(rd_kw_fortio_data_size__(data_type, element_count));
+    offset_type buffer_offset = 0;
+    return fortio.pread(data_offset, data.data(), data.size()) &&
+           rd_kw_for_each_record(fortio, data_type, element_count,
+                                 data.data(), data.size(), buffer_offset,
+                                 decode);
+}
+
 void rd_kw_fskip(ERT::FortIO &fortio) {
     rd_kw_type *tmp_kw;
     tmp_kw = rd_kw_fread_alloc(fortio);
@@ -1463,133 +2141,264 @@ void rd_kw_fskip(ERT::FortIO &fortio) {
 
 static void rd_kw_fwrite_data_unformatted(const rd_kw_type *rd_kw,
                                           ERT::FortIO &fortio) {
-    char *iobuffer = rd_kw_alloc_output_buffer(rd_kw);
-    int sizeof_iotype = rd_type_get_sizeof_iotype(rd_kw->data_type);
-    {
-        const int blocksize = get_blocksize(rd_kw->data_type);
-        const int num_blocks =
-            rd_kw->size / blocksize + (rd_kw->size % blocksize == 0 ? 0 : 1);
-        int block_nr;
-
-        for (block_nr = 0; block_nr < num_blocks; block_nr++) {
-            int this_blocksize =
-                util_int_min((block_nr + 1) * blocksize, rd_kw->size) -
-                block_nr * blocksize;
-            int record_size =
-                this_blocksize *
-                sizeof_iotype; /* The total size in bytes of the record written by the fortio layer. */
-            fortio.fwrite_record(
-                &iobuffer[block_nr * blocksize * sizeof_iotype], record_size);
-        }
+    const int sizeof_iotype = rd_type_get_sizeof_iotype(rd_kw->data_type);
+    const int blocksize = get_blocksize(rd_kw->data_type);
+    const int record_size = blocksize * sizeof_iotype;
+
+    if (record_size == 0) {
+        // Message keywords have no data, only an empty record per block
+        for (int first = 0; first < rd_kw->size; first += blocksize)
+            fortio.fwrite_record(nullptr, 0);
+        return;
     }
-    free(iobuffer);
+
+    /*
+      The data is encoded into a bounded scratch buffer holding a whole
+      number of records, which is written before the next chunk is
+      encoded.
+    */
+    const int chunk_size =
+        std::max<int>(1, RD_KW_FWRITE_CHUNK_SIZE / record_size) * blocksize;
+    std::vector<char> scratch(
+        static_cast<size_t>(std::min(chunk_size, rd_kw->size)) *
+        sizeof_iotype);
+    for (int first = 0; first < rd_kw->size; first += chunk_size) {
+        const int count = std::min(chunk_size, rd_kw->size - first);
+        rd_kw_encode_output(rd_kw, first, count, scratch.data());
+        fortio.fwrite_records(scratch.data(),
+                              static_cast<size_t>(count) * sizeof_iotype,
+                              record_size);
+    }
+}
+
+namespace {
+
+/*
+  ECLIPSE expects the following formatting for float and double values:
+
+     0.ddddddddE+03       (float)
+     0.ddddddddddddddD+03 (double)
+
+  which printf() can not produce directly, the radix part must start with
+  0 and doubles use 'D' to start the exponent. The value is therefore
+  split in a prefix and a power of ten, see scientific_split(), and the
+  two parts are written separately.
+*/
+
+constexpr int scientific_min_power = -330;
+constexpr int scientific_max_power = 310;
+
+/*
+  pow(10, power) for all the powers a finite double can be split with.
+  The table is filled with pow() itself so the prefixes are bit-identical
+  to dividing by pow(10.0, power).
+*/
+const double *scientific_powers() {
+    static const std::vector<double> powers = [] {
+        std::vector<double> table;
+        for (int power = scientific_min_power; power <= scientific_max_power;
+             power++)
+            table.push_back(pow(10.0, power));
+        return table;
+    }();
+    return powers.data() - scientific_min_power;
 }
 
-/**
-     The point of this awkward function is that I have not managed to
-     use C fprintf() syntax to reproduce the ECLIPSE
-     formatting. ECLIPSE expects the following formatting for float
-     and double values:
+/*
+  The power is ceil(log10(|x|)). Away from the powers of ten this is the
+  smallest power with |x| <= 10^power, which is found in the table. Close
+  to a power of ten the rounding of log10() decides, and it is called.
+*/
+int scientific_power(double abs_x) {
+    constexpr double margin = 1e-12;
+    const double *powers = scientific_powers();
+    int exponent;
+    frexp(abs_x, &exponent);
+    int power = static_cast<int>(ceil(exponent * 0.30102999566398120));
+    if (power > -300 && power < 300) {
+        while (abs_x <= powers[power - 1])
+            power--;
+        while (abs_x > powers[power])
+            power++;
+        if (abs_x < powers[power] * (1 - margin) &&
+            abs_x > powers[power - 1] * (1 + margin))
+            return power;
+    }
+    return static_cast<int>(ceil(log10(abs_x)));
+}
 
-        0.ddddddddE+03       (float)
-        0.ddddddddddddddD+03 (double)
+/*
+  Splits the finite @x in a prefix in [0.1, 1) and a power of ten. This
+  must match the computation of the original writer exactly, including
+  the rounding of the division, so the printed digits are unchanged.
+*/
+void scientific_split(double x, double &prefix, int &power) {
+    if (x == 0.0) {
+        prefix = 0.0;
+        power = 0;
+        return;
+    }
 
-     The problem with printf have been:
+    power = scientific_power(fabs(x));
+    prefix = x / scientific_powers()[power];
+    if (fabs(prefix) == 1.0) {
+        prefix *= 0.10;
+        power += 1;
+    }
+}
 
-        1. To force the radix part to start with 0.
-        2. To use 'D' as the exponent start for double values.
+/*
+  Formats the data section of formatted keywords into a buffer which is
+  written to the stream in large chunks, instead of calling fprintf()
+  once per element.
+*/
+class FormattedWriter {
+public:
+    explicit FormattedWriter(ERT::FortIO &fortio)
+        : stream(fortio.get_FILE()) {
+        buffer.reserve(formatted_chunk_size + formatted_max_token);
+    }
 
-     If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
-     the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
-     updated accordingly.
-  */
+    void put_char(const char *s, size_t width) {
+        buffer.append(" '");
+        size_t length = strlen(s);
+        buffer.append(s, length);
+        if (length < width)
+            buffer.append(width - length, ' ');
+        buffer.push_back('\'');
+    }
+
+    void put_int(int value) {
+        buffer.push_back(' ');
+        char text[16];
+        auto result = std::to_chars(text, text + sizeof text, value);
+        put_right(text, result.ptr - text, 11);
+    }
+
+    void put_bool(bool value) {
+        buffer.append("  ");
+        buffer.push_back(value ? BOOL_TRUE_CHAR : BOOL_FALSE_CHAR);
+    }
+
+    void put_float(float value) { put_scientific(value, 8, 11, 'E'); }
+
+    void put_double(double value) { put_scientific(value, 14, 17, 'D'); }
 
-static void __fprintf_scientific(FILE *stream, const char *fmt, double x) {
-    double pow_x = ceil(log10(fabs(x)));
-    double arg_x = x / pow(10.0, pow_x);
-    if (x != 0.0) {
-        if (fabs(arg_x) == 1.0) {
-            arg_x *= 0.10;
-            pow_x += 1;
+    void end_line() {
+        buffer.push_back('\n');
+        if (buffer.size() >= formatted_chunk_size)
+            flush();
+    }
+
+    void flush() {
+        if (!buffer.empty() &&
+            fwrite(buffer.data(), 1, buffer.size(), stream) != buffer.size())
+            throw std::ios_base::failure(
+                "Writing formatted keyword data failed");
+        buffer.clear();
+    }
+
+private:
+    FILE *stream;
+    std::string buffer;
+
+    void put_right(const char *text, size_t length, size_t width) {
+        if (length < width)
+            buffer.append(width - length, ' ');
+        buffer.append(text, length);
+    }
+
+    void put_scientific(double x, int precision, int width, char marker) {
+        char text[formatted_max_token];
+        if (!std::isfinite(x)) {
+            // Rare enough to go through printf as the original writer did
+            double prefix = x / pow(10.0, ceil(log10(fabs(x))));
+            int length = snprintf(
+                text, sizeof text,
+                marker == 'E' ? WRITE_FMT_FLOAT : WRITE_FMT_DOUBLE, prefix,
+                (int)ceil(log10(fabs(x))));
+            buffer.append(text, std::clamp<int>(length, 0, sizeof text - 1));
+            return;
         }
-    } else {
-        arg_x = 0.0;
-        pow_x = 0.0;
+
+        double prefix;
+        int power;
+        scientific_split(x, prefix, power);
+
+        buffer.append("  ");
+#if defined(__cpp_lib_to_chars)
+        auto result = std::to_chars(text, text + sizeof text, prefix,
+                                    std::chars_format::fixed, precision);
+        put_right(text, result.ptr - text, width);
+#else
+        int length = snprintf(text, sizeof text, "%*.*f", width, precision,
+                              prefix);
+        buffer.append(text, length);
+#endif
+        buffer.push_back(marker);
+        buffer.push_back(power < 0 ? '-' : '+');
+        unsigned abs_power = std::abs(power);
+        if (abs_power < 10)
+            buffer.push_back('0');
+        auto result_power =
+            std::to_chars(text, text + sizeof text, abs_power);
+        buffer.append(text, result_power.ptr - text);
     }
-    fprintf(stream, fmt, arg_x, (int)pow_x);
-}
+};
+
+} // namespace
 
 static void rd_kw_fwrite_data_formatted(rd_kw_type *rd_kw,
                                         ERT::FortIO &fortio) {
-
-    {
-
-        FILE *stream = fortio.get_FILE();
-        const int blocksize = get_blocksize(rd_kw->data_type);
-        const int columns = get_columns(rd_kw->data_type);
-        const std::string write_format = write_fmt(rd_kw->data_type);
-        const int num_blocks =
-            rd_kw->size / blocksize + (rd_kw->size % blocksize == 0 ? 0 : 1);
-        int block_nr;
-
-        for (block_nr = 0; block_nr < num_blocks; block_nr++) {
-            int this_blocksize =
-                util_int_min((block_nr + 1) * blocksize, rd_kw->size) -
-                block_nr * blocksize;
-            int num_lines = this_blocksize / columns +
-                            (this_blocksize % columns == 0 ? 0 : 1);
-            int line_nr;
-            for (line_nr = 0; line_nr < num_lines; line_nr++) {
-                int num_columns =
-                    util_int_min((line_nr + 1) * columns, this_blocksize) -
-                    columns * line_nr;
-                int col_nr;
-                for (col_nr = 0; col_nr < num_columns; col_nr++) {
-                    int data_index =
-                        block_nr * blocksize + line_nr * columns + col_nr;
-                    void *data_ptr = rd_kw_iget_ptr_static(rd_kw, data_index);
-                    switch (rd_kw_get_type(rd_kw)) {
-                    case (RD_CHAR_TYPE):
-                        fprintf(stream, write_format.c_str(), data_ptr);
-                        break;
-                    case (RD_STRING_TYPE):
-                        fprintf(stream, write_format.c_str(), data_ptr);
-                        break;
-                    case (RD_INT_TYPE): {
-                        int int_value = ((int *)data_ptr)[0];
-                        fprintf(stream, write_format.c_str(), int_value);
-                    } break;
-                    case (RD_BOOL_TYPE): {
-                        bool bool_value = ((unsigned char *)data_ptr)[0] != 0;
-                        if (bool_value)
-                            fprintf(stream, write_format.c_str(),
-                                    BOOL_TRUE_CHAR);
-                        else
-                            fprintf(stream, write_format.c_str(),
-                                    BOOL_FALSE_CHAR);
-                    } break;
-                    case (RD_FLOAT_TYPE): {
-                        float float_value = ((float *)data_ptr)[0];
-                        __fprintf_scientific(stream, write_format.c_str(),
-                                             float_value);
-                    } break;
-                    case (RD_DOUBLE_TYPE): {
-                        double double_value = ((double *)data_ptr)[0];
-                        __fprintf_scientific(stream, write_format.c_str(),
-                                             double_value);
-                    } break;
-                    case (RD_MESS_TYPE):
-                        throw std::runtime_error(
-                            "Internal inconsistency : message type keywords "
-                            "should not have data");
-                        break;
-                    }
+    const int blocksize = get_blocksize(rd_kw->data_type);
+    const int columns = get_columns(rd_kw->data_type);
+    const rd_type_enum type = rd_kw_get_type(rd_kw);
+    const size_t string_width = rd_type_get_sizeof_iotype(rd_kw->data_type);
+    FormattedWriter writer(fortio);
+
+    for (int block_start = 0; block_start < rd_kw->size;
+         block_start += blocksize) {
+        const int block_end = std::min(block_start + blocksize, rd_kw->size);
+        for (int line_start = block_start; line_start < block_end;
+             line_start += columns) {
+            const int line_end = std::min(line_start + columns, block_end);
+            for (int data_index = line_start; data_index < line_end;
+                 data_index++) {
+                const void *data_ptr =
+                    rd_kw_iget_ptr_static(rd_kw, data_index);
+                switch (type) {
+                case (RD_CHAR_TYPE):
+                    writer.put_char(static_cast<const char *>(data_ptr),
+                                    RD_STRING8_LENGTH);
+                    break;
+                case (RD_STRING_TYPE):
+                    writer.put_char(static_cast<const char *>(data_ptr),
+                                    string_width);
+                    break;
+                case (RD_INT_TYPE):
+                    writer.put_int(*static_cast<const int *>(data_ptr));
+                    break;
+                case (RD_BOOL_TYPE):
+                    writer.put_bool(
+                        *static_cast<const unsigned char *>(data_ptr) != 0);
+                    break;
+                case (RD_FLOAT_TYPE):
+                    writer.put_float(*static_cast<const float *>(data_ptr));
+                    break;
+                case (RD_DOUBLE_TYPE):
+                    writer.put_double(*static_cast<const double *>(data_ptr));
+                    break;
+                case (RD_MESS_TYPE):
+                    throw std::runtime_error(
+                        "Internal inconsistency : message type keywords "
+                        "should not have data");
+                    break;
                 }
-                fprintf(stream, "\n");
             }
+            writer.end_line();
         }
     }
+    writer.flush();
 }
 
 void rd_kw_fwrite_data(const rd_kw_type *_rd_kw, ERT::FortIO &fortio) {
@@ -1603,25 +2412,25 @@ void rd_kw_fwrite_data(const rd_kw_type *_rd_kw, ERT::FortIO &fortio) {
 }
 
 void rd_kw_fwrite_header(const rd_kw_type *rd_kw, ERT::FortIO &fortio) {
-    FILE *stream = fortio.get_FILE();
     bool fmt_file = fortio.fmt_file();
     std::string type_name = rd_type_name(rd_kw->data_type);
 
     if (fmt_file)
-        fprintf(stream, WRITE_HEADER_FMT, rd_kw->header8, rd_kw->size,
-                type_name.c_str());
+        fprintf(fortio.get_FILE(), WRITE_HEADER_FMT, rd_kw->header8,
+                rd_kw->size, type_name.c_str());
     else {
         int size = rd_kw->size;
         if (RD_ENDIAN_FLIP)
             util_endian_flip_vector(&size, sizeof size, 1);
 
-        fortio.init_write(RD_KW_HEADER_DATA_SIZE);
-
-        fwrite(rd_kw->header8, sizeof(char), RD_STRING8_LENGTH, stream);
-        fwrite(&size, sizeof(int), 1, stream);
-        fwrite(type_name.c_str(), sizeof(char), RD_TYPE_LENGTH, stream);
-
-        fortio.complete_write(RD_KW_HEADER_DATA_SIZE);
+        /* Written as one record, so that it can join the direct writes
+           of the data, see FortIO::set_direct_io(). */
+        char header[RD_KW_HEADER_DATA_SIZE];
+        memcpy(header, rd_kw->header8, RD_STRING8_LENGTH);
+        memcpy(&header[RD_STRING8_LENGTH], &size, sizeof size);
+        memcpy(&header[RD_STRING8_LENGTH + sizeof size], type_name.c_str(),
+               RD_TYPE_LENGTH);
+        fortio.fwrite_record(header, RD_KW_HEADER_DATA_SIZE);
     }
 }
 
@@ -1796,10 +2605,10 @@ void rd_kw_scalar_set_float_or_double(rd_kw_type *rd_kw, double value) {
                 "Keyword: {} is wrong type", rd_kw_get_header8(rd_kw)));       \
         {                                                                      \
             ctype *data = (ctype *)rd_kw_get_data_ref(rd_kw);                  \
-            int size = rd_kw_get_size(rd_kw);                                  \
-            int i;                                                             \
-            for (i = 0; i < size; i++)                                         \
-                data[i] *= scale_factor;                                       \
+            rd::kernels::unary(data, rd_kw_get_size(rd_kw),                    \
+                               [scale_factor](ctype value) -> ctype {          \
+                                   return value * scale_factor;                \
+                               });                                             \
         }                                                                      \
     }
 
@@ -1825,10 +2634,10 @@ void rd_kw_scale_float_or_double(rd_kw_type *rd_kw, double scale_factor) {
                 "Keyword: {} is wrong type", rd_kw_get_header8(rd_kw)));       \
         {                                                                      \
             ctype *data = (ctype *)rd_kw_get_data_ref(rd_kw);                  \
-            int size = rd_kw_get_size(rd_kw);                                  \
-            int i;                                                             \
-            for (i = 0; i < size; i++)                                         \
-                data[i] += shift_value;                                        \
+            rd::kernels::unary(data, rd_kw_get_size(rd_kw),                    \
+                               [shift_value](ctype value) -> ctype {           \
+                                   return value + shift_value;                 \
+                               });                                             \
         }                                                                      \
     }
 
@@ -1875,15 +2684,18 @@ void rd_kw_copy_indexed(rd_kw_type *target_kw, const int_vector_type *index_set,
     {
         char *target_data = (char *)rd_kw_get_data_ref(target_kw);
         const char *src_data = (const char *)rd_kw_get_data_ref(src_kw);
-        int sizeof_ctype = rd_type_get_sizeof_ctype(target_kw->data_type);
-        int set_size = int_vector_size(index_set);
-        const int *index_data = int_vector_get_const_ptr(index_set);
-        int i;
-        for (i = 0; i < set_size; i++) {
-            int index = index_data[i];
-            memcpy(&target_data[index * sizeof_ctype],
-                   &src_data[index * sizeof_ctype], sizeof_ctype);
-        }
+        size_t sizeof_ctype = rd_type_get_sizeof_ctype(target_kw->data_type);
+        rd::kernels::for_each_run(
+            int_vector_get_const_ptr(index_set), int_vector_size(index_set),
+            [&](size_t begin, size_t end) {
+                memmove(&target_data[begin * sizeof_ctype],
+                        &src_data[begin * sizeof_ctype],
+                        (end - begin) * sizeof_ctype);
+            },
+            [&](size_t index) {
+                memmove(&target_data[index * sizeof_ctype],
+                        &src_data[index * sizeof_ctype], sizeof_ctype);
+            });
     }
 }
 
@@ -1896,13 +2708,10 @@ void rd_kw_copy_indexed(rd_kw_type *target_kw, const int_vector_type *index_set,
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *add_data = (const ctype *)rd_kw_get_data_ref(add_kw); \
-            int set_size = int_vector_size(index_set);                         \
-            const int *index_data = int_vector_get_const_ptr(index_set);       \
-            int i;                                                             \
-            for (i = 0; i < set_size; i++) {                                   \
-                int index = index_data[i];                                     \
-                target_data[index] += add_data[index];                         \
-            }                                                                  \
+            rd::kernels::binary_indexed(                                       \
+                target_data, add_data, int_vector_get_const_ptr(index_set),    \
+                int_vector_size(index_set),                                    \
+                [](ctype a, ctype b) -> ctype { return a + b; });              \
         }                                                                      \
     }
 
@@ -1940,9 +2749,10 @@ void rd_kw_inplace_add_indexed(rd_kw_type *target_kw,
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *add_data = (const ctype *)rd_kw_get_data_ref(add_kw); \
-            int i;                                                             \
-            for (i = 0; i < target_kw->size; i++)                              \
-                target_data[i] += add_data[i];                                 \
+            rd::kernels::binary(target_data, add_data, target_kw->size,        \
+                                [](ctype a, ctype b) -> ctype {                \
+                                    return a + b;                              \
+                                });                                            \
         }                                                                      \
     }
 RD_KW_TYPED_INPLACE_ADD(int)
@@ -1978,9 +2788,10 @@ void rd_kw_inplace_add(rd_kw_type *target_kw, const rd_kw_type *add_kw) {
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *add_data = (const ctype *)rd_kw_get_data_ref(add_kw); \
-            int i;                                                             \
-            for (i = 0; i < target_kw->size; i++)                              \
-                target_data[i] += add_data[i] * add_data[i];                   \
+            rd::kernels::binary(target_data, add_data, target_kw->size,        \
+                                [](ctype a, ctype b) -> ctype {                \
+                                    return a + b * b;                          \
+                                });                                            \
         }                                                                      \
     }
 RD_KW_TYPED_INPLACE_ADD_SQUARED(int)
@@ -2017,9 +2828,10 @@ void rd_kw_inplace_add_squared(rd_kw_type *target_kw,
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *sub_data = (const ctype *)rd_kw_get_data_ref(sub_kw); \
-            int i;                                                             \
-            for (i = 0; i < target_kw->size; i++)                              \
-                target_data[i] -= sub_data[i];                                 \
+            rd::kernels::binary(target_data, sub_data, target_kw->size,        \
+                                [](ctype a, ctype b) -> ctype {                \
+                                    return a - b;                              \
+                                });                                            \
         }                                                                      \
     }
 RD_KW_TYPED_INPLACE_SUB(int)
@@ -2055,13 +2867,10 @@ void rd_kw_inplace_sub(rd_kw_type *target_kw, const rd_kw_type *sub_kw) {
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *sub_data = (const ctype *)rd_kw_get_data_ref(sub_kw); \
-            int set_size = int_vector_size(index_set);                         \
-            const int *index_data = int_vector_get_const_ptr(index_set);       \
-            int i;                                                             \
-            for (i = 0; i < set_size; i++) {                                   \
-                int index = index_data[i];                                     \
-                target_data[index] -= sub_data[index];                         \
-            }                                                                  \
+            rd::kernels::binary_indexed(                                       \
+                target_data, sub_data, int_vector_get_const_ptr(index_set),    \
+                int_vector_size(index_set),                                    \
+                [](ctype a, ctype b) -> ctype { return a - b; });              \
         }                                                                      \
     }
 
@@ -2094,9 +2903,9 @@ void rd_kw_inplace_sub_indexed(rd_kw_type *target_kw,
 #define RD_KW_TYPED_INPLACE_ABS(ctype, abs_func)                               \
     void rd_kw_inplace_abs_##ctype(rd_kw_type *kw) {                           \
         ctype *data = (ctype *)rd_kw_get_data_ref(kw);                         \
-        int i;                                                                 \
-        for (i = 0; i < kw->size; i++)                                         \
-            data[i] = abs_func(data[i]);                                       \
+        rd::kernels::unary(data, kw->size, [](ctype value) -> ctype {          \
+            return abs_func(value);                                            \
+        });                                                                    \
     }
 
 RD_KW_TYPED_INPLACE_ABS(int, abs)
@@ -2128,9 +2937,9 @@ static int sqrti(int x) { return round(sqrt(x)); }
 #define RD_KW_TYPED_INPLACE_SQRT(ctype, sqrt_func)                             \
     void rd_kw_inplace_sqrt_##ctype(rd_kw_type *kw) {                          \
         ctype *data = (ctype *)rd_kw_get_data_ref(kw);                         \
-        int i;                                                                 \
-        for (i = 0; i < kw->size; i++)                                         \
-            data[i] = sqrt_func(data[i]);                                      \
+        rd::kernels::unary(data, kw->size, [](ctype value) -> ctype {          \
+            return sqrt_func(value);                                           \
+        });                                                                    \
     }
 
 RD_KW_TYPED_INPLACE_SQRT(double, sqrt)
@@ -2165,9 +2974,10 @@ void rd_kw_inplace_sqrt(rd_kw_type *kw) {
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *mul_data = (const ctype *)rd_kw_get_data_ref(mul_kw); \
-            int i;                                                             \
-            for (i = 0; i < target_kw->size; i++)                              \
-                target_data[i] *= mul_data[i];                                 \
+            rd::kernels::binary(target_data, mul_data, target_kw->size,        \
+                                [](ctype a, ctype b) -> ctype {                \
+                                    return a * b;                              \
+                                });                                            \
         }                                                                      \
     }
 RD_KW_TYPED_INPLACE_MUL(int)
@@ -2203,13 +3013,10 @@ void rd_kw_inplace_mul(rd_kw_type *target_kw, const rd_kw_type *mul_kw) {
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *mul_data = (const ctype *)rd_kw_get_data_ref(mul_kw); \
-            int set_size = int_vector_size(index_set);                         \
-            const int *index_data = int_vector_get_const_ptr(index_set);       \
-            int i;                                                             \
-            for (i = 0; i < set_size; i++) {                                   \
-                int index = index_data[i];                                     \
-                target_data[index] *= mul_data[index];                         \
-            }                                                                  \
+            rd::kernels::binary_indexed(                                       \
+                target_data, mul_data, int_vector_get_const_ptr(index_set),    \
+                int_vector_size(index_set),                                    \
+                [](ctype a, ctype b) -> ctype { return a * b; });              \
         }                                                                      \
     }
 
@@ -2247,9 +3054,10 @@ void rd_kw_inplace_mul_indexed(rd_kw_type *target_kw,
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *div_data = (const ctype *)rd_kw_get_data_ref(div_kw); \
-            int i;                                                             \
-            for (i = 0; i < target_kw->size; i++)                              \
-                target_data[i] /= div_data[i];                                 \
+            rd::kernels::binary(target_data, div_data, target_kw->size,        \
+                                [](ctype a, ctype b) -> ctype {                \
+                                    return a / b;                              \
+                                });                                            \
         }                                                                      \
     }
 RD_KW_TYPED_INPLACE_DIV(int)
@@ -2285,13 +3093,10 @@ void rd_kw_inplace_div(rd_kw_type *target_kw, const rd_kw_type *div_kw) {
         {                                                                      \
             ctype *target_data = (ctype *)rd_kw_get_data_ref(target_kw);       \
             const ctype *div_data = (const ctype *)rd_kw_get_data_ref(div_kw); \
-            int set_size = int_vector_size(index_set);                         \
-            const int *index_data = int_vector_get_const_ptr(index_set);       \
-            int i;                                                             \
-            for (i = 0; i < set_size; i++) {                                   \
-                int index = index_data[i];                                     \
-                target_data[index] /= div_data[index];                         \
-            }                                                                  \
+            rd::kernels::binary_indexed(                                       \
+                target_data, div_data, int_vector_get_const_ptr(index_set),    \
+                int_vector_size(index_set),                                    \
+                [](ctype a, ctype b) -> ctype { return a / b; });              \
         }                                                                      \
     }
 
@@ -2340,12 +3145,10 @@ bool rd_kw_inplace_safe_div(rd_kw_type *target_kw, const rd_kw_type *divisor) {
 
 #define KW_MAX_MIN(type)                                                       \
     {                                                                          \
-        type *data = (type *)rd_kw_get_data_ref(rd_kw);                        \
-        type max = data[0];                                                    \
-        type min = data[0];                                                    \
-        int i;                                                                 \
-        for (i = 1; i < rd_kw_get_size(rd_kw); i++)                            \
-            util_update_##type##_max_min(data[i], &max, &min);                 \
+        const type *data = (const type *)rd_kw_get_data_ref(rd_kw);            \
+        type max;                                                              \
+        type min;                                                              \
+        rd::kernels::max_min(data, rd_kw_get_size(rd_kw), max, min);           \
         memcpy(_max, &max, rd_type_get_sizeof_ctype(rd_kw->data_type));        \
         memcpy(_min, &min, rd_type_get_sizeof_ctype(rd_kw->data_type));        \
     }
@@ -2409,11 +3212,9 @@ RD_KW_MIN(double)
 #define KW_SUM_INDEXED(type)                                                   \
     {                                                                          \
         const type *data = (const type *)rd_kw_get_data_ref(rd_kw);            \
-        type sum = 0;                                                          \
-        int size = int_vector_size(index_list);                                \
-        const int *index_ptr = int_vector_get_const_ptr(index_list);           \
-        for (int i = 0; i < size; i++)                                         \
-            sum += data[index_ptr[i]];                                         \
+        type sum = rd::kernels::sum_indexed(                                   \
+            data, int_vector_get_const_ptr(index_list),                        \
+            int_vector_size(index_list));                                      \
         memcpy(_sum, &sum, rd_type_get_sizeof_ctype(rd_kw->data_type));        \
     }
 
@@ -2448,9 +3249,7 @@ void rd_kw_element_sum_indexed(const rd_kw_type *rd_kw,
 #define KW_SUM(type)                                                           \
     {                                                                          \
         const type *data = (const type *)rd_kw_get_data_ref(rd_kw);            \
-        type sum = 0;                                                          \
-        for (int i = 0; i < rd_kw_get_size(rd_kw); i++)                        \
-            sum += data[i];                                                    \
+        type sum = rd::kernels::sum(data, rd_kw_get_size(rd_kw));              \
         memcpy(_sum, &sum, rd_type_get_sizeof_ctype(rd_kw->data_type));        \
     }
 
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "ert/util/build_config.hpp"
+
+#ifdef HAVE_MADVISE
+#include <sys/mman.h>
+#endif
+
+#include <resdata/rd_kw_allocator.hpp>
+
+namespace rd {
+
+void *KWAllocator::allocate(size_t bytes) {
+    void *ptr = do_allocate(bytes);
+    allocations++;
+    bytes_allocated += bytes;
+    size_t in_use = bytes_in_use += bytes;
+    size_t peak = peak_bytes_in_use;
+    while (in_use > peak &&
+           !peak_bytes_in_use.compare_exchange_weak(peak, in_use))
+        ;
+    return ptr;
+}
+
+void KWAllocator::deallocate(void *ptr, size_t bytes) {
+    deallocations++;
+    bytes_in_use -= bytes;
+    do_deallocate(ptr, bytes);
+}
+
+KWAllocationStats KWAllocator::stats() const {
+    KWAllocationStats stats;
+    stats.allocations = allocations;
+    stats.deallocations = deallocations;
+    stats.bytes_allocated = bytes_allocated;
+    stats.bytes_in_use = bytes_in_use;
+    stats.peak_bytes_in_use = peak_bytes_in_use;
+    stats.system_allocations = system_allocations;
+    return stats;
+}
+
+namespace {
+
+size_t round_up(size_t bytes, size_t multiple) {
+    return (bytes + multiple - 1) / multiple * multiple;
+}
+
+bool use_huge_pages(size_t bytes, size_t threshold) {
+    return threshold > 0 && bytes >= threshold;
+}
+
+} // namespace
+
+void *AlignedKWAllocator::do_allocate(size_t bytes) {
+    /* aligned_alloc() requires the size to be a multiple of the
+       alignment; a size of 0 gives a unique, minimal buffer. */
+    const bool huge = use_huge_pages(bytes, huge_pages_from);
+    const size_t align = huge ? huge_page_size : alignment;
+    void *ptr = std::aligned_alloc(align, round_up(std::max<size_t>(bytes, 1),
+                                                   align));
+    if (!ptr)
+        throw std::bad_alloc();
+    count_system_allocation();
+
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+    if (huge)
+        madvise(ptr, round_up(bytes, align), MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void AlignedKWAllocator::do_deallocate(void *ptr, size_t) { std::free(ptr); }
+
+namespace {
+
+thread_local KWAllocator *scoped_allocator = nullptr;
+
+} // namespace
+
+AlignedKWAllocator &default_kw_allocator() {
+    static AlignedKWAllocator allocator;
+    return allocator;
+}
+
+KWAllocator &current_kw_allocator() {
+    if (scoped_allocator)
+        return *scoped_allocator;
+    return default_kw_allocator();
+}
+
+ScopedKWAllocator::ScopedKWAllocator(KWAllocator &allocator)
+    : previous(scoped_allocator) {
+    scoped_allocator = &allocator;
+}
+
+ScopedKWAllocator::~ScopedKWAllocator() { scoped_allocator = previous; }
+
+std::shared_ptr<KWPool> KWPool::create(KWAllocator &upstream) {
+    return {new KWPool(upstream), [](KWPool *pool) { pool->release(); }};
+}
+
+std::shared_ptr<KWPool> KWPool::create() {
+    return create(default_kw_allocator());
+}
+
+KWPool::~KWPool() {
+    for (void *chunk : chunks)
+        upstream.deallocate(chunk, chunk_size);
+}
+
+void KWPool::release() {
+    if (--references == 0)
+        delete this;
+}
+
+size_t KWPool::size_class(size_t bytes) {
+    size_t index = 0;
+    size_t block_size = min_block_size;
+    while (block_size < bytes) {
+        block_size *= 2;
+        index++;
+    }
+    return index;
+}
+
+/* The blocks are aligned to the smaller of their size and
+   AlignedKWAllocator::alignment. */
+void *KWPool::carve(size_t block_size) {
+    const uintptr_t align =
+        std::min(block_size, AlignedKWAllocator::alignment);
+    auto aligned = [align](const char *ptr) {
+        return (reinterpret_cast<uintptr_t>(ptr) + align - 1) / align * align;
+    };
+
+    uintptr_t block = aligned(chunk_next);
+    if (!chunk_next ||
+        block + block_size > reinterpret_cast<uintptr_t>(chunk_end)) {
+        /* The tail of the previous chunk is left unused. */
+        chunks.reserve(chunks.size() + 1);
+        chunk_next = static_cast<char *>(upstream.allocate(chunk_size));
+        chunk_end = chunk_next + chunk_size;
+        chunks.push_back(chunk_next);
+        count_system_allocation();
+        block = aligned(chunk_next);
+    }
+    chunk_next = reinterpret_cast<char *>(block + block_size);
+    return reinterpret_cast<void *>(block);
+}
+
+void *KWPool::do_allocate(size_t bytes) {
+    void *block;
+    if (bytes > max_block_size)
+        block = upstream.allocate(bytes);
+    else {
+        const size_t index = size_class(bytes);
+        std::lock_guard<std::mutex> lock(mutex);
+        block = free_blocks[index];
+        if (block)
+            free_blocks[index] = *static_cast<void **>(block);
+        else
+            block = carve(min_block_size << index);
+    }
+    references++;
+    return block;
+}
+
+void KWPool::do_deallocate(void *ptr, size_t bytes) {
+    if (bytes > max_block_size)
+        upstream.deallocate(ptr, bytes);
+    else {
+        std::lock_guard<std::mutex> lock(mutex);
+        void *&head = free_blocks[size_class(bytes)];
+        *static_cast<void **>(ptr) = head;
+        head = ptr;
+    }
+    release();
+}
+
+} // namespace rd
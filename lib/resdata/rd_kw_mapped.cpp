@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <ert/util/util.hpp>
+
+#include <resdata/rd_endian_flip.hpp>
+#include <resdata/rd_kw_mapped.hpp>
+
+namespace rd {
+
+namespace {
+
+bool in_host_representation(rd_data_type data_type) {
+    return !RD_ENDIAN_FLIP &&
+           (rd_type_is_int(data_type) || rd_type_is_float(data_type) ||
+            rd_type_is_double(data_type));
+}
+
+/* Returns the header record of the keyword at @offset in the mapping. */
+const char *header_record(const ERT::FortIO &fortio, offset_type offset) {
+    if (!fortio.is_mapped())
+        throw std::invalid_argument(fmt::format(
+            "MappedKW: the file {} is not mapped", fortio.filename()));
+
+    int record_size;
+    const char *header = fortio.mapped_record(offset, record_size);
+    if (header == nullptr || record_size != RD_KW_HEADER_DATA_SIZE)
+        throw std::runtime_error(
+            fmt::format("MappedKW: no keyword header at offset {} in {}",
+                        offset, fortio.filename()));
+    return header;
+}
+
+rd_data_type header_data_type(const char *header) {
+    char type_name[RD_TYPE_LENGTH + 1] = {0};
+    memcpy(type_name, &header[RD_STRING8_LENGTH + sizeof(int)],
+           RD_TYPE_LENGTH);
+    return rd_type_create_from_name(type_name);
+}
+
+} // namespace
+
+MappedKW::MappedKW(const ERT::FortIO &fortio, offset_type offset)
+    : MappedKW(fortio, offset, header_record(fortio, offset)) {}
+
+MappedKW::MappedKW(const ERT::FortIO &fortio, offset_type offset,
+                   const char *header)
+    : m_fortio(fortio), m_offset(offset),
+      m_data_type(header_data_type(header)) {
+    char header8[RD_STRING8_LENGTH + 1] = {0};
+    memcpy(header8, header, RD_STRING8_LENGTH);
+    memcpy(&m_size, &header[RD_STRING8_LENGTH], sizeof m_size);
+    if (RD_ENDIAN_FLIP)
+        util_endian_flip_vector(&m_size, sizeof m_size, 1);
+
+    m_header = header8;
+    m_header.erase(m_header.find_last_not_of(' ') + 1);
+
+    int record_size;
+    offset_type record_offset = offset + RD_KW_HEADER_FORTIO_SIZE;
+    const int sizeof_iotype = rd_type_get_sizeof_iotype(m_data_type);
+    int first = 0;
+    while (sizeof_iotype > 0 && first < m_size) {
+        const char *data = fortio.mapped_record(record_offset, record_size);
+        if (data == nullptr || record_size % sizeof_iotype != 0 ||
+            record_size / sizeof_iotype > m_size - first)
+            throw std::runtime_error(fmt::format(
+                "MappedKW: incomplete data for keyword {} at offset {} in {}",
+                m_header, offset, fortio.filename()));
+
+        int count = record_size / sizeof_iotype;
+        m_records.push_back({first, count, data});
+        first += count;
+    }
+
+    /* Borrowing requires the element type to be aligned in the mapping;
+       a keyword header leaves the data at an arbitrary 4 byte boundary. */
+    if (m_records.size() == 1 && in_host_representation(m_data_type) &&
+        reinterpret_cast<std::uintptr_t>(m_records[0].data) % sizeof_iotype ==
+            0) {
+        m_kw.reset(rd_kw_alloc_new_shared(
+            header8, m_size, m_data_type,
+            const_cast<char *>(m_records[0].data)));
+        m_borrowed = true;
+    }
+}
+
+const rd_kw_type *MappedKW::get() const {
+    std::call_once(m_load_once, [this] {
+        if (m_kw)
+            return;
+
+        m_kw.reset(rd_kw_pread_alloc(m_fortio, m_offset));
+        if (!m_kw)
+            throw std::runtime_error(
+                fmt::format("MappedKW: failed to decode keyword {} in {}",
+                            m_header, m_fortio.filename()));
+    });
+    return m_kw.get();
+}
+
+} // namespace rd
@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <cstring>
+#include <type_traits>
 
 #include <ert/util/int_vector.hpp>
 #include <ert/util/util.hpp>
@@ -7,6 +8,7 @@
 #include <ert/geometry/geo_polygon.hpp>
 
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_view.hpp>
 #include <resdata/rd_grid.hpp>
 #include <resdata/rd_box.hpp>
 #include <resdata/rd_util.hpp>
@@ -201,26 +203,24 @@ void rd_region_reset(rd_region_type *rd_region) {
     rd_region_invalidate_index_list(rd_region);
 }
 
-static void rd_region_select_equal__(rd_region_type *region,
-                                     const rd_kw_type *rd_kw, int value,
-                                     bool select) {
-    bool global_kw;
-    rd_region_assert_kw(region, rd_kw, &global_kw);
-    if (!rd_type_is_int(rd_kw_get_data_type(rd_kw)))
-        util_abort("%s: sorry - select by equality is only supported for "
-                   "integer keywords \n",
-                   __func__);
-    const int *kw_data = rd_kw_get_int_ptr(rd_kw);
+/*
+  Sets the selection of the cells where @selected(index) holds, with
+  index running over the elements of a keyword of size nx*ny*nz when
+  @global_kw is true and of size nactive otherwise.
+*/
+template <typename Predicate>
+static void rd_region_select_if__(rd_region_type *region, bool global_kw,
+                                  bool select, Predicate selected) {
     if (global_kw) {
         for (int global_index = 0; global_index < region->grid_vol;
              global_index++) {
-            if (kw_data[global_index] == value)
+            if (selected(global_index))
                 region->active_mask[global_index] = select;
         }
     } else {
         for (int active_index = 0; active_index < region->grid_active;
              active_index++) {
-            if (kw_data[active_index] == value) {
+            if (selected(active_index)) {
                 int global_index = rd_grid_get_global_index1A(
                     region->parent_grid, active_index);
                 region->active_mask[global_index] = select;
@@ -230,6 +230,20 @@ static void rd_region_select_equal__(rd_region_type *region,
     rd_region_invalidate_index_list(region);
 }
 
+static void rd_region_select_equal__(rd_region_type *region,
+                                     const rd_kw_type *rd_kw, int value,
+                                     bool select) {
+    bool global_kw;
+    rd_region_assert_kw(region, rd_kw, &global_kw);
+    if (!rd_type_is_int(rd_kw_get_data_type(rd_kw)))
+        util_abort("%s: sorry - select by equality is only supported for "
+                   "integer keywords \n",
+                   __func__);
+    rd::KWView<const int> kw_data(rd_kw);
+    rd_region_select_if__(region, global_kw, select,
+                          [&](int index) { return kw_data[index] == value; });
+}
+
 void rd_region_select_equal(rd_region_type *region, const rd_kw_type *rd_kw,
                             int value) {
     rd_region_select_equal__(region, rd_kw, value, true);
@@ -249,23 +263,9 @@ static void rd_region_select_bool_equal__(rd_region_type *region,
         util_abort("%s: sorry - select by equality is only supported for "
                    "boolean keywords \n",
                    __func__);
-    if (global_kw) {
-        for (int global_index = 0; global_index < region->grid_vol;
-             global_index++) {
-            if (rd_kw_iget_bool(rd_kw, global_index) == value)
-                region->active_mask[global_index] = select;
-        }
-    } else {
-        for (int active_index = 0; active_index < region->grid_active;
-             active_index++) {
-            if (rd_kw_iget_bool(rd_kw, active_index) == value) {
-                int global_index = rd_grid_get_global_index1A(
-                    region->parent_grid, active_index);
-                region->active_mask[global_index] = select;
-            }
-        }
-    }
-    rd_region_invalidate_index_list(region);
+    rd::KWView<const bool> kw_data(rd_kw);
+    rd_region_select_if__(region, global_kw, select,
+                          [&](int index) { return kw_data[index] == value; });
 }
 
 void rd_region_select_true(rd_region_type *region, const rd_kw_type *rd_kw) {
@@ -286,28 +286,10 @@ static void rd_region_select_in_interval__(rd_region_type *region,
         util_abort("%s: sorry - select by in_interval is only supported for "
                    "float keywords \n",
                    __func__);
-    {
-        const float *kw_data = rd_kw_get_float_ptr(rd_kw);
-        if (global_kw) {
-            for (int global_index = 0; global_index < region->grid_vol;
-                 global_index++) {
-                if (kw_data[global_index] >= min_value &&
-                    kw_data[global_index] < max_value)
-                    region->active_mask[global_index] = select;
-            }
-        } else {
-            for (int active_index = 0; active_index < region->grid_active;
-                 active_index++) {
-                if (kw_data[active_index] >= min_value &&
-                    kw_data[active_index] < max_value) {
-                    int global_index = rd_grid_get_global_index1A(
-                        region->parent_grid, active_index);
-                    region->active_mask[global_index] = select;
-                }
-            }
-        }
-    }
-    rd_region_invalidate_index_list(region);
+    rd::KWView<const float> kw_data(rd_kw);
+    rd_region_select_if__(region, global_kw, select, [&](int index) {
+        return kw_data[index] >= min_value && kw_data[index] < max_value;
+    });
 }
 
 void rd_region_select_in_interval(rd_region_type *region,
@@ -322,12 +304,6 @@ void rd_region_deselect_in_interval(rd_region_type *region,
     rd_region_select_in_interval__(region, rd_kw, min_value, max_value, false);
 }
 
-/**
-   This is too large:
-
-   Float / Int / double *  Active / Global  *  More / Less ==> In total 12 code blocks written out ...
-*/
-
 /*
   NBNBNBNB: Select >= on float values and select > on integer!!!!!!
 */
@@ -342,104 +318,22 @@ static void rd_region_select_with_limit__(rd_region_type *region,
                    "float and integer keywords \n",
                    __func__);
 
-    if (rd_type_is_float(data_type)) {
-        const float *kw_data = rd_kw_get_float_ptr(rd_kw);
-        float float_limit = limit;
-        if (global_kw) {
-            for (int global_index = 0; global_index < region->grid_vol;
-                 global_index++) {
-                if (select_less) {
-                    if (kw_data[global_index] < float_limit)
-                        region->active_mask[global_index] = select;
-                } else {
-                    if (kw_data[global_index] >= float_limit)
-                        region->active_mask[global_index] = select;
-                }
-            }
-        } else {
-            for (int active_index = 0; active_index < region->grid_active;
-                 active_index++) {
-                if (select_less) {
-                    if (kw_data[active_index] < float_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                } else {
-                    if (kw_data[active_index] >= float_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                }
-            }
-        }
-    } else if (rd_type_is_int(data_type)) {
-        const int *kw_data = rd_kw_get_int_ptr(rd_kw);
-        int int_limit = (int)limit;
-        if (global_kw) {
-            for (int global_index = 0; global_index < region->grid_vol;
-                 global_index++) {
-                if (select_less) {
-                    if (kw_data[global_index] < int_limit)
-                        region->active_mask[global_index] = select;
-                } else {
-                    if (kw_data[global_index] > int_limit)
-                        region->active_mask[global_index] = select;
-                }
-            }
-        } else {
-            for (int active_index = 0; active_index < region->grid_active;
-                 active_index++) {
-                if (select_less) {
-                    if (kw_data[active_index] < int_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                } else {
-                    if (kw_data[active_index] > int_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                }
-            }
-        }
-    } else if (rd_type_is_double(data_type)) {
-        const double *kw_data = rd_kw_get_double_ptr(rd_kw);
-        double double_limit = (double)limit;
-        if (global_kw) {
-            for (int global_index = 0; global_index < region->grid_vol;
-                 global_index++) {
-                if (select_less) {
-                    if (kw_data[global_index] < double_limit)
-                        region->active_mask[global_index] = select;
-                } else {
-                    if (kw_data[global_index] >= double_limit)
-                        region->active_mask[global_index] = select;
-                }
-            }
-        } else {
-            for (int active_index = 0; active_index < region->grid_active;
-                 active_index++) {
-                if (select_less) {
-                    if (kw_data[active_index] < double_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                } else {
-                    if (kw_data[active_index] >= double_limit) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                }
-            }
-        }
-    }
-    rd_region_invalidate_index_list(region);
+    rd::visit_kw(rd_kw, [&](auto kw_data) {
+        using value_type = typename decltype(kw_data)::value_type;
+        const value_type typed_limit = static_cast<value_type>(limit);
+        if (select_less)
+            rd_region_select_if__(region, global_kw, select, [&](int index) {
+                return kw_data[index] < typed_limit;
+            });
+        else if constexpr (std::is_integral_v<value_type>)
+            rd_region_select_if__(region, global_kw, select, [&](int index) {
+                return kw_data[index] > typed_limit;
+            });
+        else
+            rd_region_select_if__(region, global_kw, select, [&](int index) {
+                return kw_data[index] >= typed_limit;
+            });
+    });
 }
 
 void rd_region_select_smaller(rd_region_type *rd_region,
@@ -475,43 +369,19 @@ static void rd_region_cmp_select__(rd_region_type *region,
         util_abort("%s: sorry - select by cmp() is only supported for float "
                    "keywords \n",
                    __func__);
-    if (rd_kw_size_and_type_equal(kw1, kw2)) {
-
-        const float *kw1_data = rd_kw_get_float_ptr(kw1);
-        const float *kw2_data = rd_kw_get_float_ptr(kw2);
-
-        if (global_kw) {
-            for (int global_index = 0; global_index < region->grid_vol;
-                 global_index++) {
-                if (select_less) {
-                    if (kw1_data[global_index] < kw2_data[global_index])
-                        region->active_mask[global_index] = select;
-                } else {
-                    if (kw1_data[global_index] >= kw2_data[global_index])
-                        region->active_mask[global_index] = select;
-                }
-            }
-        } else {
-            for (int active_index = 0; active_index < region->grid_active;
-                 active_index++) {
-                if (select_less) {
-                    if (kw1_data[active_index] < kw2_data[active_index]) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                } else {
-                    if (kw1_data[active_index] >= kw2_data[active_index]) {
-                        int global_index = rd_grid_get_global_index1A(
-                            region->parent_grid, active_index);
-                        region->active_mask[global_index] = select;
-                    }
-                }
-            }
-        }
-    } else
+    if (!rd_kw_size_and_type_equal(kw1, kw2))
         util_abort("%s: type/size mismatch between keywords. \n", __func__);
-    rd_region_invalidate_index_list(region);
+
+    rd::KWView<const float> kw1_data(kw1);
+    rd::KWView<const float> kw2_data(kw2);
+    if (select_less)
+        rd_region_select_if__(region, global_kw, select, [&](int index) {
+            return kw1_data[index] < kw2_data[index];
+        });
+    else
+        rd_region_select_if__(region, global_kw, select, [&](int index) {
+            return kw1_data[index] >= kw2_data[index];
+        });
 }
 
 void rd_region_cmp_select_less(rd_region_type *rd_region, const rd_kw_type *kw1,
@@ -78,6 +78,7 @@ rd_subsidence_survey_alloc_PRESSURE(rd_subsidence_type *rd_subsidence,
     const auto &global_index = grid_cache.global_index();
     const int size = grid_cache.size();
 
+    rd::KWScope scope = restart_view->scope();
     rd_kw_type *init_porv_kw =
         rd_subsidence->init_file->get_kw(PORV_KW, 0); /*Global indexing*/
     rd_kw_type *pressure_kw =
@@ -33,6 +33,7 @@
 #include <resdata/rd_file_flag.hpp>
 
 #include <detail/util/path.hpp>
+#include <detail/resdata/rd_tsmry_loader.hpp>
 
 namespace fs = std::filesystem;
 
@@ -551,6 +552,20 @@ void rd_sum_fwrite(const rd_sum_type *rd_sum) {
                        rd_sum->fmt_case, rd_sum->unified);
 }
 
+void rd_sum_fwrite_transposed(const rd_sum_type *rd_sum) {
+    if (!rd_sum->unified)
+        throw std::invalid_argument(
+            "Transposed summary files can only be written for unified cases");
+
+    fs::path unsmry_file = rd::filename(
+        rd_sum->rd_case, FileType::UNIFIED_SUMMARY, rd_sum->fmt_case);
+    rd::tsmry_fwrite(rd_sum->smspec.get(), unsmry_file.string());
+}
+
+int rd_sum_refresh(rd_sum_type *rd_sum) {
+    return rd_sum_data_refresh(rd_sum->data.get());
+}
+
 bool rd_sum_can_write(const rd_sum_type *rd_sum) {
     return rd_sum_data_can_write(rd_sum->data.get());
 }
@@ -806,6 +821,12 @@ void rd_sum_init_double_vector_interp(const rd_sum_type *rd_sum,
                                           data);
 }
 
+void rd_sum_init_double_frame(const rd_sum_type *rd_sum,
+                              const rd_sum_vector_type *keywords,
+                              double *data) {
+    rd_sum_data_init_double_frame(rd_sum->data.get(), keywords, data);
+}
+
 void rd_sum_init_double_frame_interp(const rd_sum_type *rd_sum,
                                      const rd_sum_vector_type *keywords,
                                      const time_t_vector_type *time_points,
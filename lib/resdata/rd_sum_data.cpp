@@ -615,6 +615,19 @@ bool rd_sum_data_fread(rd_sum_data_type *data, const stringlist_type *filelist,
     return false;
 }
 
+/*
+  Only the main case, which starts last, can still be growing.
+*/
+int rd_sum_data_refresh(rd_sum_data_type *data) {
+    if (data->data_files.empty())
+        return 0;
+
+    int new_ministeps = data->data_files.back()->refresh();
+    if (new_ministeps > 0)
+        rd_sum_data_build_index(data);
+    return new_ministeps;
+}
+
 /** The last index included in report step @report_step. If the dataset does
     not contain @report_step, the function will raise std::invalid_argument. */
 int rd_sum_data_iget_report_end(const rd_sum_data_type *data, int report_step) {
@@ -967,6 +980,55 @@ void rd_sum_data_init_double_vector(const rd_sum_data_type *data,
     rd_sum_data_init_double_vector__(data, params_index, output_data, false);
 }
 
+/*
+  Fills @output_data with the values of all the @keywords at every ministep,
+  laid out as output_data[key_index + time_index * num_keywords]. Each data
+  file is visited once for the full set of keywords, so a lazily loaded
+  UNSMRY file is read in a single pass instead of once per keyword.
+*/
+void rd_sum_data_init_double_frame(const rd_sum_data_type *data,
+                                   const rd_sum_vector_type *keywords,
+                                   double *output_data) {
+    int num_keywords = rd_sum_vector_get_size(keywords);
+    int offset = 0;
+    std::vector<int> params_indices;
+    std::vector<int> key_indices;
+    std::vector<double> columns;
+
+    for (const auto &index_node : data->index) {
+        const auto &data_file = data->data_files[index_node.data_index];
+        const auto &params_map = index_node.params_map;
+
+        params_indices.clear();
+        key_indices.clear();
+        for (int key_index = 0; key_index < num_keywords; key_index++) {
+            int main_params_index =
+                rd_sum_vector_iget_param_index(keywords, key_index);
+            int params_index = params_map[main_params_index];
+            if (params_index >= 0) {
+                params_indices.push_back(params_index);
+                key_indices.push_back(key_index);
+            } else {
+                const rd::smspec_node &smspec_node =
+                    rd_smspec_iget_node_w_params_index(data->smspec,
+                                                       main_params_index);
+                for (int i = 0; i < index_node.length; i++)
+                    output_data[key_index + (offset + i) * num_keywords] =
+                        smspec_node.get_default();
+            }
+        }
+
+        columns.resize(params_indices.size() * index_node.length);
+        data_file->get_data(params_indices, index_node.length, columns.data());
+        for (size_t k = 0; k < key_indices.size(); k++)
+            for (int i = 0; i < index_node.length; i++)
+                output_data[key_indices[k] + (offset + i) * num_keywords] =
+                    columns[k * index_node.length + i];
+
+        offset += index_node.length;
+    }
+}
+
 double_vector_type *rd_sum_data_alloc_data_vector(const rd_sum_data_type *data,
                                                   int params_index,
                                                   bool report_only) {
@@ -1031,63 +1093,131 @@ void rd_sum_data_init_double_vector_interp(
     }
 }
 
+/*
+  Fills @output_data with the values of all the @keywords at the sorted
+  ministeps @ministeps only, laid out as
+  output_data[key_index + i * num_keywords] for ministeps[i].
+*/
+static void rd_sum_data_init_double_frame_at(const rd_sum_data_type *data,
+                                             const rd_sum_vector_type *keywords,
+                                             const std::vector<int> &ministeps,
+                                             double *output_data) {
+    int num_keywords = rd_sum_vector_get_size(keywords);
+    int offset = 0;
+    auto ministep = ministeps.begin();
+    std::vector<int> params_indices;
+    std::vector<int> key_indices;
+    std::vector<int> time_indices;
+    std::vector<double> values;
+
+    for (const auto &index_node : data->index) {
+        const auto &data_file = data->data_files[index_node.data_index];
+        const auto &params_map = index_node.params_map;
+        const int row = std::distance(ministeps.begin(), ministep);
+
+        time_indices.clear();
+        while (ministep != ministeps.end() &&
+               *ministep < offset + index_node.length)
+            time_indices.push_back(*ministep++ - offset);
+        offset += index_node.length;
+        if (time_indices.empty())
+            continue;
+
+        params_indices.clear();
+        key_indices.clear();
+        for (int key_index = 0; key_index < num_keywords; key_index++) {
+            int main_params_index =
+                rd_sum_vector_iget_param_index(keywords, key_index);
+            int params_index = params_map[main_params_index];
+            if (params_index >= 0) {
+                params_indices.push_back(params_index);
+                key_indices.push_back(key_index);
+            } else {
+                const rd::smspec_node &smspec_node =
+                    rd_smspec_iget_node_w_params_index(data->smspec,
+                                                       main_params_index);
+                for (size_t i = 0; i < time_indices.size(); i++)
+                    output_data[key_index + (row + i) * num_keywords] =
+                        smspec_node.get_default();
+            }
+        }
+
+        values.resize(params_indices.size() * time_indices.size());
+        data_file->get_data(params_indices, time_indices, values.data());
+        for (size_t k = 0; k < key_indices.size(); k++)
+            for (size_t i = 0; i < time_indices.size(); i++)
+                output_data[key_indices[k] + (row + i) * num_keywords] =
+                    values[k * time_indices.size() + i];
+    }
+}
+
 void rd_sum_data_init_double_frame_interp(const rd_sum_data_type *data,
                                           const rd_sum_vector_type *keywords,
                                           const time_t_vector_type *time_points,
                                           double *output_data) {
     int num_keywords = rd_sum_vector_get_size(keywords);
-    int time_stride = num_keywords;
-    int key_stride = 1;
+    int num_time_points = time_t_vector_size(time_points);
     time_t start_time = rd_sum_data_get_data_start(data);
     time_t end_time = rd_sum_data_get_sim_end(data);
+    int length = rd_sum_data_get_length(data);
 
-    for (int time_index = 0; time_index < time_t_vector_size(time_points);
-         time_index++) {
-        time_t sim_time = time_t_vector_iget(time_points, time_index);
-        if (sim_time < start_time) {
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    rd_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = rd_sum_vector_iget_is_rate(keywords, key_index);
-                if (is_rate)
-                    output_data[data_index] = 0;
-                else
-                    output_data[data_index] =
-                        rd_sum_data_iget_first_value(data, param_index);
-            }
-        } else if (sim_time > end_time) {
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    rd_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = rd_sum_vector_iget_is_rate(keywords, key_index);
-                if (is_rate)
-                    output_data[data_index] = 0;
-                else
-                    output_data[data_index] =
-                        rd_sum_data_iget_last_value(data, param_index);
-            }
-        } else {
-            double weight1, weight2;
-            int time_index1, time_index2;
+    struct interp_point {
+        int time_index1;
+        int time_index2;
+        double weight1;
+        double weight2;
+    };
 
+    /*
+      Only the ministeps which bracket the time points are loaded, so the
+      memory and I/O used grow with the number of time points rather than
+      with the length of the case.
+    */
+    std::vector<interp_point> points(num_time_points);
+    std::vector<int> ministeps;
+    for (int time_index = 0; time_index < num_time_points; time_index++) {
+        time_t sim_time = time_t_vector_iget(time_points, time_index);
+        auto &point = points[time_index];
+        if (sim_time < start_time)
+            point = {0, 0, 1, 0};
+        else if (sim_time > end_time)
+            point = {length - 1, length - 1, 1, 0};
+        else
             rd_sum_data_init_interp_from_sim_time(
-                data, sim_time, &time_index1, &time_index2, &weight1, &weight2);
-
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    rd_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = rd_sum_vector_iget_is_rate(keywords, key_index);
-                double value = rd_sum_data_vector_iget(
-                    data, sim_time, param_index, is_rate, time_index1,
-                    time_index2, weight1, weight2);
-                output_data[data_index] = value;
-            }
+                data, sim_time, &point.time_index1, &point.time_index2,
+                &point.weight1, &point.weight2);
+        ministeps.push_back(point.time_index1);
+        ministeps.push_back(point.time_index2);
+    }
+    std::sort(ministeps.begin(), ministeps.end());
+    ministeps.erase(std::unique(ministeps.begin(), ministeps.end()),
+                    ministeps.end());
+
+    std::vector<double> frame(ministeps.size() * num_keywords);
+    rd_sum_data_init_double_frame_at(data, keywords, ministeps, frame.data());
+    auto frame_iget = [&](int ministep, int key_index) {
+        auto row = std::lower_bound(ministeps.begin(), ministeps.end(),
+                                    ministep) -
+                   ministeps.begin();
+        return frame[key_index + row * num_keywords];
+    };
+
+    for (int time_index = 0; time_index < num_time_points; time_index++) {
+        time_t sim_time = time_t_vector_iget(time_points, time_index);
+        const auto &point = points[time_index];
+        bool outside = sim_time < start_time || sim_time > end_time;
+        for (int key_index = 0; key_index < num_keywords; key_index++) {
+            int data_index = key_index + time_index * num_keywords;
+            bool is_rate = rd_sum_vector_iget_is_rate(keywords, key_index);
+            // Rates use a step function; time_index2 is the ministep
+            // rd_sum_data_get_index_from_sim_time() returns for sim_time.
+            if (is_rate)
+                output_data[data_index] =
+                    outside ? 0 : frame_iget(point.time_index2, key_index);
+            else
+                output_data[data_index] =
+                    frame_iget(point.time_index1, key_index) * point.weight1 +
+                    frame_iget(point.time_index2, key_index) * point.weight2;
         }
     }
 }
@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <ctime>
 #include <ios>
 #include <new>
@@ -20,6 +21,8 @@
 #include <resdata/rd_endian_flip.hpp>
 
 #include <detail/resdata/rd_sum_file_data.hpp>
+#include <detail/resdata/rd_summary_loader.hpp>
+#include <detail/resdata/rd_tsmry_loader.hpp>
 #include <detail/resdata/rd_unsmry_loader.hpp>
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_file.hpp>
@@ -205,6 +208,14 @@ void validate_report_step(int report_step) {
 
 namespace rd {
 
+static IndexNode params_time(const rd_smspec_type *smspec, const float *params,
+                             int report_step) {
+    time_t sim_time;
+    double sim_seconds;
+    rd_sum_tstep_time_from_params(smspec, params, &sim_time, &sim_seconds);
+    return IndexNode(sim_time, sim_seconds, report_step);
+}
+
 rd_sum_file_data::rd_sum_file_data(const rd_smspec_type *smspec)
     : rd_smspec(smspec), data(vector_alloc_new()) {}
 
@@ -276,9 +287,21 @@ double rd_sum_file_data::get_sim_length() const {
     return node.sim_seconds / rd_smspec_get_time_seconds(this->rd_smspec);
 }
 
+const float *rd_sum_file_data::column(int params_index) const {
+    int params_size = rd_smspec_get_params_size(this->rd_smspec);
+    if (params_index < 0 || params_index >= params_size)
+        util_abort("%s: param index:%d invalid: Valid range: [0,%d) \n",
+                   __func__, params_index, params_size);
+
+    return &this->columns[static_cast<size_t>(params_index) *
+                          this->column_capacity];
+}
+
 double rd_sum_file_data::iget(int time_index, int params_index) const {
     if (this->loader)
         return this->loader->iget(time_index, params_index);
+    else if (this->columnar())
+        return this->column(params_index)[time_index];
     else {
         const rd_sum_tstep_type *ministep_data = iget_ministep(time_index);
         return rd_sum_tstep_iget(ministep_data, params_index);
@@ -304,6 +327,8 @@ void rd_sum_file_data::append_tstep(rd_sum_tstep_type *tstep) {
 rd_sum_tstep_type *rd_sum_file_data::add_new_tstep(int report_step,
                                                    double sim_seconds) {
     validate_report_step(report_step);
+    if (this->columnar())
+        this->columns_to_tsteps();
 
     int ministep_nr = vector_get_size(data);
     std::unique_ptr<rd_sum_tstep_type, decltype(&rd_sum_tstep_free)> tstep(
@@ -377,6 +402,10 @@ static int cmp_ministep(const void *arg1, const void *arg2) {
 }
 
 void rd_sum_file_data::build_index() {
+    // The index of the columnar storage is built by load_columns().
+    if (this->columnar())
+        return;
+
     this->index.clear();
 
     if (this->loader) {
@@ -400,6 +429,123 @@ void rd_sum_file_data::build_index() {
     }
 }
 
+/*
+  Makes room for @capacity time steps in each column, keeping the values
+  of the time steps which are already loaded.
+*/
+void rd_sum_file_data::reserve_columns(size_t capacity) {
+    if (capacity <= this->column_capacity)
+        return;
+
+    const size_t params_size = rd_smspec_get_params_size(this->rd_smspec);
+    const size_t length = this->column_ministeps.size();
+    std::vector<float> columns(params_size * capacity);
+    for (size_t params_index = 0; params_index < params_size; params_index++) {
+        const float *column =
+            &this->columns[params_index * this->column_capacity];
+        std::copy(column, column + length, &columns[params_index * capacity]);
+    }
+    this->columns = std::move(columns);
+    this->column_capacity = capacity;
+}
+
+/*
+  Makes room for @length time steps in each column. The capacity is at
+  least doubled when it is exceeded, so that time steps appended one
+  refresh at a time only write the new values, instead of copying all
+  the columns on every append.
+*/
+void rd_sum_file_data::grow_columns(size_t length) {
+    if (length > this->column_capacity)
+        this->reserve_columns(std::max(length, 2 * this->column_capacity));
+}
+
+/*
+  Sorts the loaded time steps on time, where @time holds the time of each
+  column entry, and builds the time index.
+*/
+void rd_sum_file_data::index_columns(const std::vector<IndexNode> &time) {
+    const size_t length = time.size();
+    std::vector<size_t> order(length);
+    for (size_t i = 0; i < length; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t i1, size_t i2) {
+        return time[i1].sim_time < time[i2].sim_time;
+    });
+
+    if (!std::is_sorted(order.begin(), order.end())) {
+        const size_t params_size = rd_smspec_get_params_size(this->rd_smspec);
+        std::vector<float> sorted(length);
+        for (size_t params_index = 0; params_index < params_size;
+             params_index++) {
+            float *column =
+                &this->columns[params_index * this->column_capacity];
+            for (size_t i = 0; i < length; i++)
+                sorted[i] = column[order[i]];
+            std::copy(sorted.begin(), sorted.end(), column);
+        }
+
+        std::vector<int> ministeps(length);
+        for (size_t i = 0; i < length; i++)
+            ministeps[i] = this->column_ministeps[order[i]];
+        this->column_ministeps = std::move(ministeps);
+    }
+
+    this->index.clear();
+    for (size_t i = 0; i < length; i++) {
+        const IndexNode &node = time[order[i]];
+        this->index.add(node.sim_time, node.sim_seconds, node.report_step);
+    }
+}
+
+/*
+  Loads the columns from a transposed summary file. Returns false, leaving
+  the instance empty, if the ministeps in the file are not sorted on time.
+*/
+bool rd_sum_file_data::load_columns(const tsmry_loader &tsmry) {
+    const std::vector<time_t> sim_time = tsmry.sim_time();
+    if (!std::is_sorted(sim_time.begin(), sim_time.end()))
+        return false;
+
+    const int offset = rd_smspec_get_first_step(this->rd_smspec) - 1;
+    const std::vector<double> sim_seconds = tsmry.sim_seconds();
+    const std::vector<int> report_steps = tsmry.report_steps(offset);
+
+    this->index.clear();
+    for (int i = 0; i < tsmry.length(); i++)
+        this->index.add(sim_time[i], sim_seconds[i], report_steps[i]);
+
+    this->columns.resize(
+        size_t(rd_smspec_get_params_size(this->rd_smspec)) * tsmry.length());
+    this->column_capacity = tsmry.length();
+    tsmry.read_columns(this->columns.data());
+    this->column_ministeps = tsmry.ministeps();
+    return true;
+}
+
+/*
+  Converts the columnar storage to one rd_sum_tstep per row, which is
+  needed before new tsteps can be added.
+*/
+void rd_sum_file_data::columns_to_tsteps() {
+    const int params_size = rd_smspec_get_params_size(this->rd_smspec);
+    const int length = this->length();
+    std::vector<float> row(params_size);
+    for (int time_index = 0; time_index < length; time_index++) {
+        for (int params_index = 0; params_index < params_size; params_index++)
+            row[params_index] = this->column(params_index)[time_index];
+
+        append_tstep(rd_sum_tstep_alloc_from_data(
+            this->index[time_index].report_step,
+            this->column_ministeps[time_index], row.data(), this->rd_smspec));
+    }
+
+    this->columns.clear();
+    this->column_capacity = 0;
+    this->column_ministeps.clear();
+    this->build_index();
+}
+
 void rd_sum_file_data::get_time(int length, time_t *data) {
     for (int time_index = 0; time_index < length; time_index++)
         data[time_index] = this->iget_sim_time(time_index);
@@ -423,12 +569,48 @@ int rd_sum_file_data::get_time_report(int end_index, time_t *data) {
 }
 
 void rd_sum_file_data::get_data(int params_index, int length, double *data) {
+    this->get_data(std::vector<int>{params_index}, length, data);
+}
+
+void rd_sum_file_data::get_data(const std::vector<int> &params_indices,
+                                int length, double *data) {
     if (this->loader) {
-        const auto tmp_data = loader->get_vector(params_index);
-        memcpy(data, tmp_data.data(), length * sizeof data);
+        const auto tmp_data = loader->get_vectors(params_indices);
+        const int loader_length = loader->length();
+        for (size_t k = 0; k < params_indices.size(); k++)
+            memcpy(&data[k * length], &tmp_data[k * loader_length],
+                   length * sizeof(double));
+    } else if (this->columnar()) {
+        for (size_t k = 0; k < params_indices.size(); k++) {
+            const float *column = this->column(params_indices[k]);
+            std::copy(column, column + length, &data[k * length]);
+        }
     } else {
-        for (int time_index = 0; time_index < length; time_index++)
-            data[time_index] = this->iget(time_index, params_index);
+        for (size_t k = 0; k < params_indices.size(); k++)
+            for (int time_index = 0; time_index < length; time_index++)
+                data[k * length + time_index] =
+                    this->iget(time_index, params_indices[k]);
+    }
+}
+
+void rd_sum_file_data::get_data(const std::vector<int> &params_indices,
+                                const std::vector<int> &time_indices,
+                                double *data) {
+    const size_t num_times = time_indices.size();
+    if (this->loader) {
+        const auto values = loader->get_values(params_indices, time_indices);
+        std::copy(values.begin(), values.end(), data);
+    } else if (this->columnar()) {
+        for (size_t k = 0; k < params_indices.size(); k++) {
+            const float *column = this->column(params_indices[k]);
+            for (size_t i = 0; i < num_times; i++)
+                data[k * num_times + i] = column[time_indices[i]];
+        }
+    } else {
+        for (size_t k = 0; k < params_indices.size(); k++)
+            for (size_t i = 0; i < num_times; i++)
+                data[k * num_times + i] =
+                    this->iget(time_indices[i], params_indices[k]);
     }
 }
 
@@ -471,10 +653,25 @@ void rd_sum_file_data::fwrite_report(int report_step,
     {
         auto range = this->report_range(report_step);
         for (int index = range.first; index <= range.second; index++) {
-            const rd_sum_tstep_type *tstep = iget_ministep(index);
-            //rd_sum_tstep_fwrite( tstep , rd_smspec_get_index_map( rd_smspec ) , fortio );
-            rd_sum_tstep_fwrite(tstep, rd_smspec_get_index_map(rd_smspec),
-                                rd_smspec_num_nodes(rd_smspec), fortio);
+            if (this->columnar()) {
+                const int *index_map = rd_smspec_get_index_map(rd_smspec);
+                int num_nodes = rd_smspec_num_nodes(rd_smspec);
+
+                auto ministep_kw = make_rd_kw(MINISTEP_KW, 1, RD_INT);
+                rd_kw_iset_int(ministep_kw.get(), 0,
+                               this->column_ministeps[index]);
+                rd_kw_fwrite(ministep_kw.get(), fortio);
+
+                auto params_kw = make_rd_kw(PARAMS_KW, num_nodes, RD_FLOAT);
+                float *params = (float *)rd_kw_get_ptr(params_kw.get());
+                for (int i = 0; i < num_nodes; i++)
+                    params[i] = this->column(index_map[i])[index];
+                rd_kw_fwrite(params_kw.get(), fortio);
+            } else {
+                const rd_sum_tstep_type *tstep = iget_ministep(index);
+                rd_sum_tstep_fwrite(tstep, rd_smspec_get_index_map(rd_smspec),
+                                    rd_smspec_num_nodes(rd_smspec), fortio);
+            }
         }
     }
 }
@@ -550,30 +747,84 @@ bool rd_sum_file_data::check_file(rd::File *rd_file) {
 */
 
 void rd_sum_file_data::add_rd_file(int report_step,
-                                   rd::FileView &summary_view) {
+                                   rd::FileView &summary_view,
+                                   std::vector<IndexNode> &time) {
     validate_report_step(report_step);
 
-    size_t num_ministep = summary_view.num_named_kw(PARAMS_KW);
-    if (num_ministep > 0) {
-
-        for (size_t ikw = 0; ikw < num_ministep; ikw++) {
-            rd_kw_type *ministep_kw = summary_view.get_kw(MINISTEP_KW, ikw);
-            rd_kw_type *params_kw = summary_view.get_kw(PARAMS_KW, ikw);
-
-            {
-                int ministep_nr = rd_kw_iget_int(ministep_kw, 0);
-                std::string filename = summary_view.filename();
-                std::unique_ptr<rd_sum_tstep_type, decltype(&rd_sum_tstep_free)>
-                    tstep(rd_sum_tstep_alloc_from_file(
-                              report_step, ministep_nr, params_kw,
-                              filename.c_str(), this->rd_smspec),
-                          &rd_sum_tstep_free);
-
-                if (tstep)
-                    append_tstep(tstep.release());
-            }
+    /*
+      The PARAMS keywords are decoded one at a time into @params, and
+      scattered into their column slots, without loading them as keywords.
+    */
+    const size_t params_size = rd_smspec_get_params_size(this->rd_smspec);
+    const size_t num_ministep = summary_view.num_named_kw(PARAMS_KW);
+    this->grow_columns(this->column_ministeps.size() + num_ministep);
+
+    std::vector<float> params(params_size);
+    for (size_t ikw = 0; ikw < num_ministep; ikw++) {
+        const size_t data_size =
+            summary_view.get_file_kw(PARAMS_KW, ikw).get_size();
+        if (data_size != params_size) {
+            /*
+              This is actually a fatal error / bug; the difference in smspec
+              header structure should have been detected already in the
+              rd_smspec_load_restart() function and the restart case
+              discarded.
+            */
+            fprintf(stderr,
+                    "** Warning size mismatch between timestep loaded "
+                    "from:%s(%zu) and header:%s(%zu) - timestep discarded.\n",
+                    summary_view.filename().c_str(), data_size,
+                    rd_smspec_get_header_file(this->rd_smspec), params_size);
+            continue;
         }
+        if (summary_view.get_file_kw(MINISTEP_KW, ikw).get_size() != 1)
+            throw std::runtime_error("Malformed " MINISTEP_KW
+                                     " keyword in \"" +
+                                     summary_view.filename() + "\"");
+
+        int ministep;
+        summary_view.read_into(MINISTEP_KW, ikw, &ministep, RD_INT);
+        summary_view.read_into(PARAMS_KW, ikw, params.data(), RD_FLOAT);
+
+        const size_t time_index = this->column_ministeps.size();
+        for (size_t params_index = 0; params_index < params_size;
+             params_index++)
+            this->columns[params_index * this->column_capacity + time_index] =
+                params[params_index];
+        this->column_ministeps.push_back(ministep);
+        time.push_back(
+            params_time(this->rd_smspec, params.data(), report_step));
+    }
+}
+
+void rd_sum_file_data::add_ministep(int report_step,
+                                    const rd_kw_type *ministep_kw,
+                                    const rd_kw_type *params_kw,
+                                    const std::string &filename,
+                                    ParamsRows &rows) {
+    const int params_size = rd_smspec_get_params_size(this->rd_smspec);
+    int data_size = rd_kw_get_size(params_kw);
+
+    if (data_size != params_size) {
+        /*
+          This is actually a fatal error / bug; the difference in smspec
+          header structure should have been detected already in the
+          rd_smspec_load_restart() function and the restart case
+          discarded.
+        */
+        fprintf(stderr,
+                "** Warning size mismatch between timestep loaded "
+                "from:%s(%d) and header:%s(%d) - timestep discarded.\n",
+                filename.c_str(), data_size,
+                rd_smspec_get_header_file(this->rd_smspec), params_size);
+        return;
     }
+
+    const float *params =
+        static_cast<const float *>(rd_kw_get_void_ptr(params_kw));
+    rows.values.insert(rows.values.end(), params, params + params_size);
+    rows.time.push_back(params_time(this->rd_smspec, params, report_step));
+    rows.ministeps.push_back(rd_kw_iget_int(ministep_kw, 0));
 }
 
 bool rd_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
@@ -588,6 +839,7 @@ bool rd_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
                    "- you can not supply a unified file - come on?! \n",
                    __func__);
 
+    std::vector<IndexNode> time;
     if (file_type == FileType::SUMMARY) {
 
         /* Not unified. */
@@ -603,12 +855,31 @@ bool rd_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
                 std::unique_ptr<rd::File> rd_file = rd::File::open(data_file);
                 if (rd_file && check_file(rd_file.get())) {
                     auto global_view = rd_file->get_global_view();
-                    this->add_rd_file(report_step, *global_view);
+                    this->add_rd_file(report_step, *global_view, time);
                 }
             }
         }
     } else if (file_type == FileType::UNIFIED_SUMMARY) {
-        if (lazy_load) {
+        this->unified_filename = stringlist_iget(filelist, 0);
+        this->file_options = file_options;
+
+        /*
+          A transposed sidecar file, see rd_tsmry_loader.hpp, is used when
+          it is present and up to date.
+        */
+        std::unique_ptr<tsmry_loader> tsmry;
+        try {
+            tsmry = std::make_unique<tsmry_loader>(
+                this->rd_smspec, stringlist_iget(filelist, 0), file_options);
+        } catch (const std::exception &) {
+        }
+
+        if (tsmry && lazy_load)
+            this->loader = std::move(tsmry);
+        else if (tsmry && this->load_columns(*tsmry)) {
+            this->unified_params = tsmry->length();
+            tsmry.reset();
+        } else if (lazy_load) {
             try {
                 this->loader.reset(new unsmry_loader(
                     this->rd_smspec, stringlist_iget(filelist, 0),
@@ -623,6 +894,7 @@ bool rd_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
             std::unique_ptr<rd::File> rd_file =
                 rd::File::open(stringlist_iget(filelist, 0));
             if (rd_file && check_file(rd_file.get())) {
+                this->reserve_columns(rd_file->num_named_kw(PARAMS_KW));
                 int first_report_step =
                     rd_smspec_get_first_step(this->rd_smspec);
                 int block_index = 0;
@@ -637,19 +909,175 @@ bool rd_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
                     auto summary_view = rd_file->summary_view(block_index);
                     if (summary_view) {
                         this->add_rd_file(block_index + first_report_step,
-                                          *summary_view);
+                                          *summary_view, time);
                         block_index++;
                     } else
                         break;
                 }
+
+                this->set_unified_position(*rd_file,
+                                           rd_file->num_named_kw(PARAMS_KW));
             }
         }
     }
 
+    if (!time.empty())
+        this->index_columns(time);
+    else if (!this->columnar()) {
+        /* No PARAMS keyword was loaded into the reserved columns */
+        this->columns.clear();
+        this->column_capacity = 0;
+    }
+
     build_index();
     return (length() > 0);
 }
 
+void rd_sum_file_data::set_unified_position(const rd::File &rd_file,
+                                            size_t num_params) {
+    this->unified_params = num_params;
+    this->unified_offset = -1;
+    this->unified_report_step = rd_smspec_get_first_step(this->rd_smspec) - 1;
+    if (num_params == 0)
+        return;
+
+    auto file_view = rd_file.get_global_view();
+    this->unified_offset =
+        file_view->get_file_kw(PARAMS_KW, num_params - 1).get_offset();
+    for (size_t i = 0; i < file_view->num_named_kw(SEQHDR_KW); i++)
+        if (file_view->get_file_kw(SEQHDR_KW, i).get_offset() <
+            this->unified_offset)
+            this->unified_report_step++;
+}
+
+int rd_sum_file_data::refresh() {
+    if (this->unified_filename.empty())
+        return 0;
+
+    const int length = this->length();
+    const int first_report_step = rd_smspec_get_first_step(this->rd_smspec);
+    if (this->loader) {
+        int new_ministeps = this->loader->refresh();
+        if (new_ministeps < 0) {
+            // The transposed sidecar is replaced with the UNSMRY file.
+            try {
+                this->loader.reset(new unsmry_loader(
+                    this->rd_smspec, this->unified_filename,
+                    this->file_options));
+            } catch (const std::bad_alloc &) {
+                return 0;
+            }
+            this->build_index();
+            return this->length() - length;
+        }
+
+        const std::vector<int> report_steps =
+            this->loader->report_steps(first_report_step - 1);
+        for (int time_index = length; time_index < this->loader->length();
+             time_index++)
+            this->index.add(this->loader->iget_sim_time(time_index),
+                            this->loader->iget_sim_seconds(time_index),
+                            report_steps[time_index]);
+        return new_ministeps;
+    }
+
+    if (this->unified_offset < 0 && this->unified_params > 0) {
+        auto rd_file = rd::File::open(this->unified_filename);
+        this->set_unified_position(*rd_file, this->unified_params);
+    }
+
+    bool fmt_file = false;
+    rd_fmt_file(this->unified_filename.c_str(), &fmt_file);
+    ERT::FortIO fortio(this->unified_filename, std::ios_base::in, fmt_file);
+    if (this->unified_offset >= 0) {
+        rd_kw_ptr params_kw = make_rd_kw();
+        if (!fortio.fseek(this->unified_offset, SEEK_SET) ||
+            rd_kw_fread_header(params_kw.get(), fortio) != RD_KW_READ_OK ||
+            strcmp(rd_kw_get_header(params_kw.get()), PARAMS_KW) != 0 ||
+            !rd_kw_fskip_data(params_kw.get(), fortio))
+            throw std::runtime_error(
+                "The file \"" + this->unified_filename +
+                "\" has been modified since it was loaded");
+    }
+
+    /*
+      The keywords after the last loaded PARAMS are read in order; the
+      MINISTEP keyword is written before its PARAMS keyword, and each
+      SEQHDR starts a new report step. A keyword which is still being
+      written ends the read, and is picked up by a later refresh.
+    */
+    ParamsRows rows;
+    int report_step = this->unified_report_step;
+    rd_kw_ptr ministep_kw{nullptr, &rd_kw_free};
+    while (true) {
+        const offset_type offset = fortio.ftell();
+        rd_kw_ptr kw{rd_kw_fread_alloc(fortio), &rd_kw_free};
+        if (!kw)
+            break;
+
+        const char *header = rd_kw_get_header(kw.get());
+        if (strcmp(header, SEQHDR_KW) == 0)
+            report_step++;
+        else if (strcmp(header, MINISTEP_KW) == 0)
+            ministep_kw = std::move(kw);
+        else if (strcmp(header, PARAMS_KW) == 0 && ministep_kw) {
+            this->add_ministep(report_step, ministep_kw.get(), kw.get(),
+                               this->unified_filename, rows);
+            ministep_kw.reset();
+            this->unified_params++;
+            this->unified_offset = offset;
+            this->unified_report_step = report_step;
+        }
+    }
+
+    if (!rows.time.empty())
+        this->append_rows(rows);
+    return this->length() - length;
+}
+
+/*
+  Appends rows read after the initial load. The rows are added to the
+  columns when they follow the existing data in time, otherwise the data
+  is converted to tsteps and sorted on time again.
+*/
+void rd_sum_file_data::append_rows(const ParamsRows &rows) {
+    const size_t params_size = rd_smspec_get_params_size(this->rd_smspec);
+    const size_t length = this->length();
+    const size_t num_rows = rows.time.size();
+
+    bool in_order = length > 0 && this->columnar() &&
+                    rows.time[0].sim_time >= this->index.back().sim_time;
+    for (size_t row = 1; row < num_rows; row++)
+        in_order &= rows.time[row].sim_time >= rows.time[row - 1].sim_time;
+
+    if (in_order) {
+        this->grow_columns(length + num_rows);
+        for (size_t params_index = 0; params_index < params_size;
+             params_index++) {
+            float *column =
+                &this->columns[params_index * this->column_capacity];
+            for (size_t row = 0; row < num_rows; row++)
+                column[length + row] =
+                    rows.values[row * params_size + params_index];
+        }
+
+        for (size_t row = 0; row < num_rows; row++) {
+            const IndexNode &node = rows.time[row];
+            this->index.add(node.sim_time, node.sim_seconds, node.report_step);
+            this->column_ministeps.push_back(rows.ministeps[row]);
+        }
+    } else {
+        if (this->columnar())
+            this->columns_to_tsteps();
+
+        for (size_t row = 0; row < num_rows; row++)
+            append_tstep(rd_sum_tstep_alloc_from_data(
+                rows.time[row].report_step, rows.ministeps[row],
+                &rows.values[row * params_size], this->rd_smspec));
+        this->build_index();
+    }
+}
+
 const rd_smspec_type *rd_sum_file_data::smspec() const {
     return this->rd_smspec;
 }
@@ -209,6 +209,12 @@ PYBIND11_MODULE(_rd_sum, m) {
     m.def("_fwrite_sum", [](py::handle self) {
         rd_sum_fwrite(from_cwrap<rd_sum_type>(self));
     });
+    m.def("_fwrite_transposed", [](py::handle self) {
+        rd_sum_fwrite_transposed(from_cwrap<rd_sum_type>(self));
+    });
+    m.def("_refresh", [](py::handle self) {
+        return rd_sum_refresh(from_cwrap<rd_sum_type>(self));
+    });
     m.def("_can_write", [](py::handle self) {
         return rd_sum_can_write(from_cwrap<rd_sum_type>(self));
     });
@@ -341,15 +347,7 @@ PYBIND11_MODULE(_rd_sum, m) {
               int timelen = rd_sum_get_data_length(rd_sum);
               if (data.request().size < timelen * keylen)
                   throw std::invalid_argument("Incorrect size of buffer");
-              for (int time_index = 0; time_index < timelen; time_index++) {
-                  for (int key_index = 0; key_index < keylen; key_index++) {
-                      int param_index =
-                          rd_sum_vector_iget_param_index(keyvec, key_index);
-                      int data_index = key_index + time_index * keylen;
-                      out[data_index] =
-                          rd_sum_iget(rd_sum, time_index, param_index);
-                  }
-              }
+              rd_sum_init_double_frame(rd_sum, keyvec, out);
           });
     m.def("_init_pandas_frame_interp",
           [](py::handle self, py::handle keywords, py::handle time_points,
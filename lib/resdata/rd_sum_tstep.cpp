@@ -105,15 +105,9 @@ static void rd_sum_tstep_set_time_info_from_seconds(rd_sum_tstep_type *tstep,
     util_inplace_forward_seconds_utc(&tstep->sim_time, tstep->sim_seconds);
 }
 
-static void rd_sum_tstep_set_time_info_from_date(rd_sum_tstep_type *tstep,
-                                                 time_t sim_start,
-                                                 time_t sim_time) {
-    tstep->sim_time = sim_time;
-    tstep->sim_seconds = util_difftime_seconds(sim_start, tstep->sim_time);
-}
-
-static void rd_sum_tstep_set_time_info(rd_sum_tstep_type *tstep,
-                                       const rd_smspec_type *smspec) {
+void rd_sum_tstep_time_from_params(const rd_smspec_type *smspec,
+                                   const float *params, time_t *sim_time,
+                                   double *sim_seconds) {
     int date_day_index = rd_smspec_get_date_day_index(smspec);
     int date_month_index = rd_smspec_get_date_month_index(smspec);
     int date_year_index = rd_smspec_get_date_year_index(smspec);
@@ -121,22 +115,46 @@ static void rd_sum_tstep_set_time_info(rd_sum_tstep_type *tstep,
     time_t sim_start = rd_smspec_get_start_time(smspec);
 
     if (sim_time_index >= 0) {
-        double sim_time = tstep->data[sim_time_index];
-        double sim_seconds = sim_time * rd_smspec_get_time_seconds(smspec);
-        rd_sum_tstep_set_time_info_from_seconds(tstep, sim_start, sim_seconds);
+        *sim_seconds = static_cast<double>(params[sim_time_index]) *
+                       rd_smspec_get_time_seconds(smspec);
+        *sim_time = sim_start;
+        util_inplace_forward_seconds_utc(sim_time, *sim_seconds);
     } else if (date_day_index >= 0) {
-        int day = util_roundf(tstep->data[date_day_index]);
-        int month = util_roundf(tstep->data[date_month_index]);
-        int year = util_roundf(tstep->data[date_year_index]);
+        int day = util_roundf(params[date_day_index]);
+        int month = util_roundf(params[date_month_index]);
+        int year = util_roundf(params[date_year_index]);
 
-        time_t sim_time = rd_make_date(day, month, year);
-        rd_sum_tstep_set_time_info_from_date(tstep, sim_start, sim_time);
+        *sim_time = rd_make_date(day, month, year);
+        *sim_seconds = util_difftime_seconds(sim_start, *sim_time);
     } else
         util_abort("%s: Could not extract date/time information from "
                    "SMSPEC header file. \n",
                    __func__);
 }
 
+static void rd_sum_tstep_set_time_info(rd_sum_tstep_type *tstep,
+                                       const rd_smspec_type *smspec) {
+    rd_sum_tstep_time_from_params(smspec, tstep->data.data(), &tstep->sim_time,
+                                  &tstep->sim_seconds);
+}
+
+/**
+   Creates a tstep from a full PARAMS row of rd_smspec_get_params_size()
+   elements; the time information is extracted from the row.
+*/
+
+rd_sum_tstep_type *rd_sum_tstep_alloc_from_data(int report_step,
+                                                int ministep_nr,
+                                                const float *data,
+                                                const rd_smspec_type *smspec) {
+    std::unique_ptr<rd_sum_tstep_type, decltype(&rd_sum_tstep_free)> ministep(
+        rd_sum_tstep_alloc(report_step, ministep_nr, smspec),
+        &rd_sum_tstep_free);
+    ministep->data.assign(data, data + ministep->data.size());
+    rd_sum_tstep_set_time_info(ministep.get(), smspec);
+    return ministep.release();
+}
+
 /**
    If the rd_kw instance is in some way invalid (i.e. wrong size);
    the function will return NULL:
@@ -151,12 +169,9 @@ rd_sum_tstep_type *rd_sum_tstep_alloc_from_file(int report_step,
     int data_size = rd_kw_get_size(params_kw);
 
     if (data_size == rd_smspec_get_params_size(smspec)) {
-        std::unique_ptr<rd_sum_tstep_type, decltype(&rd_sum_tstep_free)>
-            ministep(rd_sum_tstep_alloc(report_step, ministep_nr, smspec),
-                     &rd_sum_tstep_free);
-        rd_kw_get_memcpy_data(params_kw, ministep->data.data());
-        rd_sum_tstep_set_time_info(ministep.get(), smspec);
-        return ministep.release();
+        return rd_sum_tstep_alloc_from_data(
+            report_step, ministep_nr,
+            static_cast<const float *>(rd_kw_get_void_ptr(params_kw)), smspec);
     } else {
         /*
        This is actually a fatal error / bug; the difference in smspec
@@ -0,0 +1,381 @@
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <resdata/rd_smspec.hpp>
+#include <resdata/rd_file_flag.hpp>
+#include <resdata/rd_util.hpp>
+
+#include <detail/resdata/rd_unsmry_loader.hpp>
+#include <detail/resdata/rd_tsmry_loader.hpp>
+
+namespace fs = std::filesystem;
+
+/*
+  Layout of the transposed summary file, all values in native byte order:
+
+     char     magic[8]                  "RDTSMRY\0"
+     int32    version
+     int32    params_size
+     int32    length                    Number of ministeps
+     int64    source_size               Size of the UNSMRY file
+     int32    name_length
+     char     name[name_length]         Basename of the UNSMRY file
+     int64    sim_time[length]
+     double   sim_seconds[length]
+     int32    report_step[length]       Number of SEQHDR up to the ministep
+     int32    ministep[length]
+     int64    offset[params_size]       File offset of each params block
+     float    data[params_size][length]
+*/
+
+namespace {
+
+constexpr char tsmry_magic[8] = "RDTSMRY";
+constexpr int32_t tsmry_version = 1;
+
+/* Upper limit on the memory used for the columns while writing. */
+constexpr size_t tsmry_write_chunk_bytes = 64 << 20;
+
+template <typename T> void write_value(std::ostream &stream, T value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+void write_array(std::ostream &stream, const std::vector<T> &values) {
+    stream.write(reinterpret_cast<const char *>(values.data()),
+                 static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T> T read_value(std::istream &stream) {
+    T value;
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+}
+
+template <typename T>
+std::vector<T> read_array(std::istream &stream, size_t size) {
+    std::vector<T> values(size);
+    stream.read(reinterpret_cast<char *>(values.data()),
+                static_cast<std::streamsize>(size * sizeof(T)));
+    return values;
+}
+
+void tsmry_write_data(std::ostream &stream, const rd_smspec_type *smspec,
+                      const std::string &unsmry_file) {
+    rd::unsmry_loader loader(smspec, unsmry_file);
+    const int params_size = rd_smspec_get_params_size(smspec);
+    const int length = loader.length();
+
+    stream.write(tsmry_magic, sizeof tsmry_magic);
+    write_value<int32_t>(stream, tsmry_version);
+    write_value<int32_t>(stream, params_size);
+    write_value<int32_t>(stream, length);
+    write_value<int64_t>(stream, fs::file_size(unsmry_file));
+
+    const std::string name = fs::path(unsmry_file).filename().string();
+    write_value<int32_t>(stream, static_cast<int32_t>(name.size()));
+    stream.write(name.data(), static_cast<std::streamsize>(name.size()));
+
+    const std::vector<time_t> sim_time = loader.sim_time();
+    write_array(stream, std::vector<int64_t>(sim_time.begin(), sim_time.end()));
+    write_array(stream, loader.sim_seconds());
+    write_array(stream, loader.report_steps(0));
+    write_array(stream, loader.ministeps());
+
+    const int64_t block_size = static_cast<int64_t>(length) * sizeof(float);
+    const int64_t data_start = static_cast<int64_t>(stream.tellp()) +
+                               params_size * sizeof(int64_t);
+    std::vector<int64_t> offsets(params_size);
+    for (int params_index = 0; params_index < params_size; params_index++)
+        offsets[params_index] = data_start + params_index * block_size;
+    write_array(stream, offsets);
+
+    const size_t chunk_size = std::max<size_t>(
+        1, tsmry_write_chunk_bytes / (sizeof(double) * std::max(length, 1)));
+    std::vector<int> positions;
+    std::vector<float> columns;
+    for (int first = 0; first < params_size; first += chunk_size) {
+        const int last =
+            std::min(params_size, first + static_cast<int>(chunk_size));
+        positions.resize(last - first);
+        for (int params_index = first; params_index < last; params_index++)
+            positions[params_index - first] = params_index;
+
+        const std::vector<double> values = loader.get_vectors(positions);
+        columns.assign(values.begin(), values.end());
+        write_array(stream, columns);
+    }
+}
+
+} // namespace
+
+namespace rd {
+
+std::string tsmry_filename(const std::string &unsmry_file) {
+    fs::path path(unsmry_file);
+    bool formatted = false;
+    rd_get_file_type(unsmry_file.c_str(), &formatted, nullptr);
+    return path.replace_extension(formatted ? ".FTSMRY" : ".TSMRY").string();
+}
+
+void tsmry_fwrite(const rd_smspec_type *smspec,
+                  const std::string &unsmry_file) {
+    if (!try_exists(unsmry_file))
+        throw std::invalid_argument(
+            fmt::format("No such summary file \"{}\"", unsmry_file));
+
+    /* Several processes may generate the sidecar of the same case, so each
+       writes its own temporary file before renaming it into place. */
+    const std::string tsmry_file = tsmry_filename(unsmry_file);
+    std::random_device random;
+    const std::string tmp_file =
+        tsmry_file + fmt::format(".{:08x}{:08x}.tmp", random(), random());
+    try {
+        {
+            std::ofstream stream(tmp_file, std::ios_base::binary);
+            if (!stream)
+                throw std::ios_base::failure(fmt::format(
+                    "Failed to open \"{}\" for writing", tmp_file));
+            stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+            tsmry_write_data(stream, smspec, unsmry_file);
+            stream.flush();
+        }
+        fs::rename(tmp_file, tsmry_file);
+    } catch (const std::bad_alloc &) {
+        // unsmry_loader signals a malformed summary file with bad_alloc
+        std::error_code ec;
+        fs::remove(tmp_file, ec);
+        throw std::invalid_argument(fmt::format(
+            "Could not load the summary data in \"{}\"", unsmry_file));
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(tmp_file, ec);
+        throw;
+    }
+}
+
+tsmry_loader::tsmry_loader(const rd_smspec_type *smspec,
+                           const std::string &unsmry_file,
+                           FileMode file_options)
+    : filename(tsmry_filename(unsmry_file)), file_options(file_options),
+      size(rd_smspec_get_params_size(smspec)) {
+    std::error_code ec;
+    auto tsmry_time = fs::last_write_time(this->filename, ec);
+    if (ec)
+        throw std::ios_base::failure(
+            fmt::format("No transposed summary file \"{}\"", this->filename));
+    if (tsmry_time < fs::last_write_time(unsmry_file))
+        throw std::ios_base::failure(fmt::format(
+            "Transposed summary file \"{}\" is older than \"{}\"",
+            this->filename, unsmry_file));
+
+    auto &stream = this->open_stream();
+    char magic[sizeof tsmry_magic];
+    stream.read(magic, sizeof magic);
+    if (std::memcmp(magic, tsmry_magic, sizeof magic) != 0 ||
+        read_value<int32_t>(stream) != tsmry_version)
+        throw std::ios_base::failure(fmt::format(
+            "\"{}\" is not a transposed summary file", this->filename));
+
+    const int params_size = read_value<int32_t>(stream);
+    this->m_length = read_value<int32_t>(stream);
+    const auto source_size = read_value<int64_t>(stream);
+    const auto name_length = read_value<int32_t>(stream);
+    if (params_size != this->size || this->m_length < 0 || name_length < 0)
+        throw std::ios_base::failure(
+            fmt::format("Transposed summary file \"{}\" does not match the "
+                        "summary header",
+                        this->filename));
+
+    std::string name(name_length, '\0');
+    stream.read(name.data(), name_length);
+    if (name != fs::path(unsmry_file).filename().string() ||
+        source_size != static_cast<int64_t>(fs::file_size(unsmry_file)))
+        throw std::ios_base::failure(
+            fmt::format("Transposed summary file \"{}\" does not match \"{}\"",
+                        this->filename, unsmry_file));
+
+    const auto sim_time = read_array<int64_t>(stream, this->m_length);
+    this->m_sim_time.assign(sim_time.begin(), sim_time.end());
+    this->m_sim_seconds = read_array<double>(stream, this->m_length);
+    this->m_report_steps = read_array<int32_t>(stream, this->m_length);
+    this->m_ministeps = read_array<int32_t>(stream, this->m_length);
+    this->offsets = read_array<int64_t>(stream, this->size);
+
+    const int64_t block_size = int64_t(this->m_length) * sizeof(float);
+    const int64_t file_size = fs::file_size(this->filename);
+    for (int64_t offset : this->offsets) {
+        if (offset < 0 || offset + block_size > file_size)
+            throw std::ios_base::failure(fmt::format(
+                "Transposed summary file \"{}\" is truncated", this->filename));
+    }
+
+    if ((this->file_options & FileMode::CLOSE_STREAM) ==
+        FileMode::CLOSE_STREAM)
+        stream.close();
+}
+
+std::ifstream &tsmry_loader::open_stream() const {
+    if (!this->stream.is_open()) {
+        this->stream.clear();
+        this->stream.exceptions(std::ios_base::goodbit);
+        this->stream.open(this->filename, std::ios_base::binary);
+        if (!this->stream)
+            throw std::ios_base::failure(
+                fmt::format("Failed to open file \"{}\"", this->filename));
+        this->stream.exceptions(std::ios_base::failbit |
+                                std::ios_base::badbit);
+    }
+    return this->stream;
+}
+
+void tsmry_loader::read_block(int64_t offset, float *data,
+                              size_t count) const {
+    auto &stream = this->open_stream();
+    stream.seekg(offset);
+    stream.read(reinterpret_cast<char *>(data),
+                static_cast<std::streamsize>(count * sizeof(float)));
+}
+
+int tsmry_loader::length() const { return this->m_length; }
+
+std::vector<double>
+tsmry_loader::get_vectors(const std::vector<int> &positions) const {
+    for (int pos : positions) {
+        if (pos < 0 || pos >= this->size)
+            throw std::out_of_range(
+                "tsmry_loader::get_vectors pos: " + std::to_string(pos) +
+                " PARAMS_SIZE: " + std::to_string(this->size));
+    }
+
+    std::vector<double> data(positions.size() * this->m_length);
+    std::vector<float> column(this->m_length);
+    for (size_t k = 0; k < positions.size(); k++) {
+        this->read_block(this->offsets[positions[k]], column.data(),
+                         column.size());
+        std::copy(column.begin(), column.end(),
+                  data.begin() + k * this->m_length);
+    }
+
+    if ((this->file_options & FileMode::CLOSE_STREAM) ==
+        FileMode::CLOSE_STREAM)
+        this->stream.close();
+
+    return data;
+}
+
+std::vector<double>
+tsmry_loader::get_values(const std::vector<int> &positions,
+                         const std::vector<int> &time_indices) const {
+    for (int pos : positions) {
+        if (pos < 0 || pos >= this->size)
+            throw std::out_of_range(
+                "tsmry_loader::get_values pos: " + std::to_string(pos) +
+                " PARAMS_SIZE: " + std::to_string(this->size));
+    }
+    for (int time_index : time_indices) {
+        if (time_index < 0 || time_index >= this->m_length)
+            throw std::out_of_range("tsmry_loader::get_values time_index: " +
+                                    std::to_string(time_index));
+    }
+
+    /* The vectors are contiguous in the sidecar, so each one is read in
+       full and the requested ministeps are picked from it. */
+    const size_t num_times = time_indices.size();
+    std::vector<double> data(positions.size() * num_times);
+    std::vector<float> column(this->m_length);
+    for (size_t k = 0; k < positions.size() && num_times > 0; k++) {
+        this->read_block(this->offsets[positions[k]], column.data(),
+                         column.size());
+        for (size_t i = 0; i < num_times; i++)
+            data[k * num_times + i] = column[time_indices[i]];
+    }
+
+    if ((this->file_options & FileMode::CLOSE_STREAM) ==
+        FileMode::CLOSE_STREAM)
+        this->stream.close();
+
+    return data;
+}
+
+double tsmry_loader::iget(int time_index, int params_index) const {
+    if (params_index < 0 || params_index >= this->size || time_index < 0 ||
+        time_index >= this->m_length)
+        throw std::out_of_range(fmt::format(
+            "tsmry_loader::iget time_index: {} params_index: {}", time_index,
+            params_index));
+
+    float value;
+    this->read_block(this->offsets[params_index] + time_index * sizeof(float),
+                     &value, 1);
+
+    if ((this->file_options & FileMode::CLOSE_STREAM) ==
+        FileMode::CLOSE_STREAM)
+        this->stream.close();
+
+    return value;
+}
+
+void tsmry_loader::read_columns(float *columns) const {
+    const int64_t block_size = int64_t(this->m_length) * sizeof(float);
+    bool contiguous = true;
+    for (int params_index = 1; params_index < this->size; params_index++)
+        contiguous &= (this->offsets[params_index] ==
+                       this->offsets[0] + params_index * block_size);
+
+    if (this->size > 0 && contiguous)
+        this->read_block(this->offsets[0], columns,
+                         size_t(this->size) * this->m_length);
+    else {
+        for (int params_index = 0; params_index < this->size; params_index++)
+            this->read_block(this->offsets[params_index],
+                             columns + size_t(params_index) * this->m_length,
+                             this->m_length);
+    }
+
+    if ((this->file_options & FileMode::CLOSE_STREAM) ==
+        FileMode::CLOSE_STREAM)
+        this->stream.close();
+}
+
+std::vector<int> tsmry_loader::report_steps(int offset) const {
+    std::vector<int> report_steps(this->m_report_steps);
+    for (auto &report_step : report_steps)
+        report_step += offset;
+    return report_steps;
+}
+
+std::vector<time_t> tsmry_loader::sim_time() const { return this->m_sim_time; }
+
+std::vector<double> tsmry_loader::sim_seconds() const {
+    return this->m_sim_seconds;
+}
+
+time_t tsmry_loader::iget_sim_time(int time_index) const {
+    return this->m_sim_time.at(time_index);
+}
+
+double tsmry_loader::iget_sim_seconds(int time_index) const {
+    return this->m_sim_seconds.at(time_index);
+}
+
+int tsmry_loader::refresh() { return -1; }
+
+} // namespace rd
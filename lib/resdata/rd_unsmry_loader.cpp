@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <ctime>
 #include <new>
 #include <stdexcept>
@@ -22,6 +23,9 @@
 
 namespace rd {
 
+/* Number of PARAMS keywords read ahead of the strided readers. */
+static constexpr int params_readahead = 8;
+
 unsmry_loader::unsmry_loader(const rd_smspec_type *smspec,
                              const std::string &filename, FileMode file_options)
     : size(rd_smspec_get_params_size(smspec)),
@@ -32,6 +36,7 @@ unsmry_loader::unsmry_loader(const rd_smspec_type *smspec,
         std::unique_ptr<rd::File> file = rd::File::open(filename, file_options);
         this->file = std::move(file);
     }
+    this->file->advise(ERT::FortIO::AccessHint::STRIDED);
     if (!this->file->has_kw(PARAMS_KW)) {
         throw std::bad_alloc();
     }
@@ -66,19 +71,75 @@ unsmry_loader::unsmry_loader(const rd_smspec_type *smspec,
 int unsmry_loader::length() const { return this->m_length; }
 
 std::vector<double> unsmry_loader::get_vector(int pos) const {
-    if (pos >= size)
-        throw std::out_of_range(
-            "unsmry_loader::get_vector pos: " + std::to_string(pos) +
-            " PARAMS_SIZE: " + std::to_string(size));
+    return this->get_vectors({pos});
+}
 
-    std::vector<double> data(this->length());
-    auto index_map = make_int_vector(1, pos);
-    float value;
+std::vector<double>
+unsmry_loader::get_vectors(const std::vector<int> &positions) const {
+    for (int pos : positions) {
+        if (pos < 0 || pos >= size)
+            throw std::out_of_range(
+                "unsmry_loader::get_vectors pos: " + std::to_string(pos) +
+                " PARAMS_SIZE: " + std::to_string(size));
+    }
+
+    const int num_positions = positions.size();
+    std::vector<double> data(num_positions * this->length());
+    if (num_positions == 0)
+        return data;
+
+    auto index_map = make_int_vector(num_positions, 0);
+    for (int k = 0; k < num_positions; k++)
+        int_vector_iset(index_map.get(), k, positions[k]);
 
+    std::vector<float> values(num_positions);
+    for (int index = 0; index < std::min(params_readahead, this->length());
+         index++)
+        file_view->will_need(PARAMS_KW, index);
     for (int index = 0; index < this->length(); index++) {
+        if (index + params_readahead < this->length())
+            file_view->will_need(PARAMS_KW, index + params_readahead);
         file_view->index_fload_kw(PARAMS_KW, index, index_map.get(),
-                                  (char *)&value);
-        data[index] = value;
+                                  (char *)values.data());
+        for (int k = 0; k < num_positions; k++)
+            data[k * this->length() + index] = values[k];
+    }
+
+    if (file_view->has_flags(FileMode::CLOSE_STREAM))
+        file_view->close();
+
+    return data;
+}
+
+std::vector<double>
+unsmry_loader::get_values(const std::vector<int> &positions,
+                          const std::vector<int> &time_indices) const {
+    for (int pos : positions) {
+        if (pos < 0 || pos >= size)
+            throw std::out_of_range(
+                "unsmry_loader::get_values pos: " + std::to_string(pos) +
+                " PARAMS_SIZE: " + std::to_string(size));
+    }
+
+    const int num_positions = positions.size();
+    const int num_times = time_indices.size();
+    std::vector<double> data(num_positions * num_times);
+    if (num_positions == 0)
+        return data;
+
+    auto index_map = make_int_vector(num_positions, 0);
+    for (int k = 0; k < num_positions; k++)
+        int_vector_iset(index_map.get(), k, positions[k]);
+
+    std::vector<float> values(num_positions);
+    for (int i = 0; i < num_times; i++) {
+        if (time_indices[i] < 0 || time_indices[i] >= this->length())
+            throw std::out_of_range("unsmry_loader::get_values time_index: " +
+                                    std::to_string(time_indices[i]));
+        file_view->index_fload_kw(PARAMS_KW, time_indices[i], index_map.get(),
+                                  (char *)values.data());
+        for (int k = 0; k < num_positions; k++)
+            data[k * num_times + i] = values[k];
     }
 
     if (file_view->has_flags(FileMode::CLOSE_STREAM))
@@ -127,19 +188,47 @@ double unsmry_loader::iget_sim_seconds(int time_index) const {
     }
 }
 
+int unsmry_loader::refresh() {
+    int length = this->m_length;
+    this->file->refresh();
+
+    /*
+      The MINISTEP keyword is written before the PARAMS keyword, a MINISTEP
+      without PARAMS at the end of the file belongs to a ministep which has
+      not been completely written yet.
+    */
+    this->m_length = std::min(this->file->num_named_kw(PARAMS_KW),
+                              this->file->num_named_kw(MINISTEP_KW));
+    return this->m_length - length;
+}
+
 std::vector<int> unsmry_loader::report_steps(int offset) const {
     std::vector<int> report_steps;
     int current_step = offset;
-    for (const auto &file_kw : *file_view) {
-        if (SEQHDR_KW == file_kw->get_header())
+    for (size_t kw_nr = 0; kw_nr < file_view->size(); kw_nr++) {
+        std::string header = file_view->get_file_kw(kw_nr).get_header();
+        if (SEQHDR_KW == header)
             current_step++;
 
-        if (PARAMS_KW == file_kw->get_header())
+        if (PARAMS_KW == header)
             report_steps.push_back(current_step);
     }
     return report_steps;
 }
 
+std::vector<int> unsmry_loader::ministeps() const {
+    std::vector<int> ministeps(this->length());
+    auto index_map = make_int_vector(1, 0);
+    for (int index = 0; index < this->length(); index++)
+        file_view->index_fload_kw(MINISTEP_KW, index, index_map.get(),
+                                  (char *)&ministeps[index]);
+
+    if (file_view->has_flags(FileMode::CLOSE_STREAM))
+        file_view->close();
+
+    return ministeps;
+}
+
 std::vector<time_t> unsmry_loader::sim_time() const {
     if (this->time_index >= 0) {
         const std::vector<double> sim_seconds = this->sim_seconds();
@@ -151,9 +240,11 @@ std::vector<time_t> unsmry_loader::sim_time() const {
         return st;
 
     } else {
-        const auto day = this->get_vector(this->date_index[0]);
-        const auto month = this->get_vector(this->date_index[1]);
-        const auto year = this->get_vector(this->date_index[2]);
+        const auto dates = this->get_vectors(
+            {this->date_index[0], this->date_index[1], this->date_index[2]});
+        const double *day = dates.data();
+        const double *month = day + this->length();
+        const double *year = month + this->length();
         std::vector<time_t> st(this->length());
 
         for (size_t i = 0; i < st.size(); i++)
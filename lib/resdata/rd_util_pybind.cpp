@@ -14,7 +14,9 @@ PYBIND11_MODULE(_rd_util, m) {
     py::enum_<FileMode> file_mode(m, "FileMode", py::arithmetic());
     file_mode.value("DEFAULT", FileMode::DEFAULT)
         .value("CLOSE_STREAM", FileMode::CLOSE_STREAM)
-        .value("WRITABLE", FileMode::WRITABLE);
+        .value("WRITABLE", FileMode::WRITABLE)
+        .value("MMAP", FileMode::MMAP)
+        .value("INDEX_CACHE", FileMode::INDEX_CACHE);
 
     file_mode.def(
         "__or__", [](FileMode a, FileMode b) { return a | b; },
@@ -1,18 +1,29 @@
 #include <cstdio>
+#include <cstdlib>
 #include <utime.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <ios>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <ert/util/test_util.hpp>
 #include <ert/util/util.hpp>
 #include <ert/util/test_work_area.hpp>
 
+#include <resdata/rd_block_prefetcher.hpp>
 #include <resdata/rd_endian_flip.hpp>
 #include <resdata/rd_file.hpp>
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_magic.hpp>
 #include <resdata/rd_type.hpp>
 
 void test_load_nonexisting_file() {
@@ -76,8 +87,691 @@ void test_create_and_load_index_file() {
     }
 }
 
+static void write_test_file(const char *file_name, int num_kw) {
+    ERT::FortIO fortio(file_name, std::ios_base::out);
+    for (int k = 0; k < num_kw; ++k) {
+        std::string name = "TEST" + std::to_string(k) + "_KW";
+        rd_kw_type *kw = rd_kw_alloc(name.c_str(), 10, RD_INT);
+        for (int i = 0; i < 10; ++i)
+            rd_kw_iset_int(kw, i, k + i);
+        rd_kw_fwrite(kw, fortio);
+        rd_kw_free(kw);
+    }
+    fortio.fflush();
+}
+
+static std::filesystem::path single_cache_file(const char *cache_dir) {
+    std::filesystem::path cache_file;
+    int count = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(cache_dir)) {
+        cache_file = entry.path();
+        count++;
+    }
+    test_assert_int_equal(count, 1);
+    return cache_file;
+}
+
+void test_index_cache() {
+    rd::util::TestArea ta("Index_cache");
+    const char *file_name = "data_file";
+    const char *cache_dir = "index_cache";
+    setenv("RD_INDEX_CACHE_DIR", cache_dir, 1);
+    test_assert_true(rd::File::index_cache_dir() == cache_dir);
+
+    write_test_file(file_name, 2);
+    auto rd_file = rd::File::open(file_name, FileMode::INDEX_CACHE);
+    test_assert_size_t_equal(rd_file->size(), 2);
+    auto cache_file = single_cache_file(cache_dir);
+    auto cache_time = std::filesystem::last_write_time(cache_file);
+
+    // A second open is served from the cache and leaves it untouched
+    auto cached_file = rd::File::open(file_name, FileMode::INDEX_CACHE);
+    test_assert_size_t_equal(cached_file->size(), 2);
+    test_assert_true(cached_file->has_kw("TEST1_KW"));
+    test_assert_int_equal(
+        rd_kw_iget_int(cached_file->get_kw("TEST1_KW", 0), 3), 4);
+    test_assert_true(std::filesystem::last_write_time(cache_file) ==
+                     cache_time);
+
+    // Opening without the flag neither reads nor writes the cache
+    write_test_file(file_name, 3);
+    test_assert_size_t_equal(rd::File::open(file_name)->size(), 3);
+    test_assert_true(std::filesystem::last_write_time(cache_file) ==
+                     cache_time);
+
+    // A changed file invalidates the cached index
+    auto changed_file = rd::File::open(file_name, FileMode::INDEX_CACHE);
+    test_assert_size_t_equal(changed_file->size(), 3);
+    test_assert_true(changed_file->has_kw("TEST2_KW"));
+    test_assert_true(single_cache_file(cache_dir) == cache_file);
+
+    // A corrupt cache file is ignored and replaced
+    {
+        std::FILE *stream = std::fopen(cache_file.c_str(), "w");
+        std::fputs("garbage", stream);
+        std::fclose(stream);
+    }
+    test_assert_size_t_equal(
+        rd::File::open(file_name, FileMode::INDEX_CACHE)->size(), 3);
+    test_assert_size_t_equal(
+        rd::File::open(file_name, FileMode::INDEX_CACHE)->size(), 3);
+    single_cache_file(cache_dir);
+
+    unsetenv("RD_INDEX_CACHE_DIR");
+}
+
+static void write_prefix(const char *file_name, const std::string &content,
+                         size_t size) {
+    std::ofstream stream(file_name, std::ios_base::binary);
+    stream.write(content.data(), size);
+}
+
+void test_refresh(FileMode flags) {
+    rd::util::TestArea ta("Refresh");
+    const char *file_name = "DATA.UNRST";
+    write_test_file(file_name, 4);
+
+    std::string content;
+    std::vector<offset_type> offsets;
+    {
+        std::ifstream stream(file_name, std::ios_base::binary);
+        content.assign(std::istreambuf_iterator<char>(stream),
+                       std::istreambuf_iterator<char>());
+        auto rd_file = rd::File::open(file_name);
+        auto view = rd_file->get_global_view();
+        for (size_t k = 0; k < view->size(); k++)
+            offsets.push_back(view->get_file_kw(k).get_offset());
+    }
+
+    write_prefix(file_name, content, offsets[1]);
+    auto rd_file = rd::File::open(file_name, flags);
+    test_assert_size_t_equal(rd_file->size(), 1);
+    test_assert_size_t_equal(rd_file->refresh(), 0);
+
+    // The keyword at offsets[2] is only partially written
+    write_prefix(file_name, content, offsets[2] + 20);
+    test_assert_size_t_equal(rd_file->refresh(), 1);
+    test_assert_true(rd_file->has_kw("TEST1_KW"));
+    test_assert_false(rd_file->has_kw("TEST2_KW"));
+
+    write_prefix(file_name, content, content.size());
+    test_assert_size_t_equal(rd_file->refresh(), 2);
+    test_assert_size_t_equal(rd_file->size(), 4);
+    test_assert_size_t_equal(rd_file->get_global_view()->num_distinct_kw(), 4);
+    test_assert_int_equal(rd_kw_iget_int(rd_file->get_kw("TEST3_KW", 0), 9),
+                          12);
+    test_assert_int_equal(rd_kw_iget_int(rd_file->get_kw("TEST0_KW", 0), 9),
+                          9);
+
+    write_prefix(file_name, content, offsets[3] + 20);
+    test_assert_throw(rd_file->refresh(), std::runtime_error);
+}
+
+static void write_multi_record_file(const char *file_name, int num_kw,
+                                    int kw_size) {
+    ERT::FortIO fortio(file_name, std::ios_base::out);
+    for (int k = 0; k < num_kw; ++k) {
+        std::string name = "KW" + std::to_string(k);
+        rd_kw_type *kw = rd_kw_alloc(name.c_str(), kw_size, RD_INT);
+        for (int i = 0; i < kw_size; ++i)
+            rd_kw_iset_int(kw, i, k + i);
+        rd_kw_fwrite(kw, fortio);
+        rd_kw_free(kw);
+    }
+}
+
+void test_concurrent_load(FileMode flags) {
+    rd::util::TestArea ta("Concurrent_load");
+    const char *file_name = "DATA.UNRST";
+    const int num_kw = 64;
+    const int kw_size = 2500;
+    write_multi_record_file(file_name, num_kw, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    std::vector<std::vector<rd_kw_type *>> loaded(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < loaded.size(); t++)
+        threads.emplace_back([&view, &loaded, t]() {
+            for (int k = 0; k < num_kw; k++) {
+                int index = (k + t * 7) % num_kw;
+                std::string name = "KW" + std::to_string(index);
+                loaded[t].push_back(view->get_kw(name, 0));
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < loaded.size(); t++) {
+        for (int k = 0; k < num_kw; k++) {
+            int index = (k + t * 7) % num_kw;
+            std::string name = "KW" + std::to_string(index);
+            rd_kw_type *kw = loaded[t][k];
+            test_assert_true(kw == rd_file->get_kw(name.c_str(), 0));
+            test_assert_int_equal(rd_kw_iget_int(kw, kw_size - 1),
+                                  index + kw_size - 1);
+        }
+    }
+}
+
+void test_concurrent_indexed_load(FileMode flags) {
+    rd::util::TestArea ta("Concurrent_indexed_load");
+    const char *file_name = "DATA.UNRST";
+    const int num_kw = 64;
+    const int kw_size = 2500;
+    write_multi_record_file(file_name, num_kw, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    std::vector<int> failures(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < failures.size(); t++)
+        threads.emplace_back([&view, &failures, t]() {
+            auto index_map = make_int_vector(2, 0);
+            int_vector_iset(index_map.get(), 1, kw_size - 1);
+            for (int k = 0; k < num_kw; k++) {
+                int index = (k + t * 7) % num_kw;
+                std::string name = "KW" + std::to_string(index);
+                if (t % 2 == 0) {
+                    int values[2];
+                    view->index_fload_kw(name, 0, index_map.get(),
+                                         reinterpret_cast<char *>(values));
+                    failures[t] += values[0] != index ||
+                                   values[1] != index + kw_size - 1;
+                } else
+                    failures[t] +=
+                        rd_kw_iget_int(view->get_kw(name, 0), 0) != index;
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int failed : failures)
+        test_assert_int_equal(failed, 0);
+}
+
+void test_preload(FileMode flags) {
+    rd::util::TestArea ta("Preload");
+    const char *file_name = "DATA.UNRST";
+    const int kw_size = 2500;
+    write_multi_record_file(file_name, 20, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    view->preload({"KW3", "KW11", "KW3", "NOSUCHKW"}, 4);
+    for (int k = 0; k < 20; k++) {
+        bool loaded = view->get_loaded_kw(k) != nullptr;
+        test_assert_bool_equal(loaded, k == 3 || k == 11);
+    }
+    test_assert_int_equal(rd_kw_iget_int(view->get_kw("KW11", 0), 7), 18);
+
+    view->preload_all(3);
+    for (int k = 0; k < 20; k++) {
+        rd_kw_type *kw = view->get_loaded_kw(k);
+        test_assert_not_NULL(kw);
+        test_assert_int_equal(rd_kw_iget_int(kw, kw_size - 1), k + kw_size - 1);
+    }
+
+    view->clear();
+    view->preload_all(1);
+    test_assert_int_equal(rd_kw_iget_int(view->get_kw("KW19", 0), 0), 19);
+}
+
+void test_read_into(FileMode flags, bool formatted) {
+    rd::util::TestArea ta("Read_into");
+    const char *file_name = formatted ? "DATA.FUNRST" : "DATA.UNRST";
+    const int kw_size = 2500;
+    {
+        ERT::FortIO fortio(file_name, std::ios_base::out, formatted);
+        rd_kw_type *ints = rd_kw_alloc("INTS", kw_size, RD_INT);
+        rd_kw_type *floats = rd_kw_alloc("FLOATS", kw_size, RD_FLOAT);
+        rd_kw_type *bools = rd_kw_alloc("BOOLS", kw_size, RD_BOOL);
+        for (int i = 0; i < kw_size; ++i) {
+            rd_kw_iset_int(ints, i, 3 * i);
+            rd_kw_iset_float(floats, i, 0.25f * i);
+            rd_kw_iset_bool(bools, i, i % 3 == 0);
+        }
+        rd_kw_fwrite(ints, fortio);
+        rd_kw_fwrite(floats, fortio);
+        rd_kw_fwrite(bools, fortio);
+        rd_kw_free(ints);
+        rd_kw_free(floats);
+        rd_kw_free(bools);
+    }
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    std::vector<int> ints(kw_size);
+    std::vector<float> floats(kw_size);
+    std::vector<double> doubles(kw_size);
+    std::unique_ptr<bool[]> bools(new bool[kw_size]);
+    view->read_into("INTS", 0, ints.data(), RD_INT);
+    view->read_into("FLOATS", 0, floats.data(), RD_FLOAT);
+    view->read_into("FLOATS", 0, doubles.data(), RD_DOUBLE);
+    view->read_into("BOOLS", 0, bools.get(), RD_BOOL);
+    for (int i = 0; i < kw_size; ++i) {
+        test_assert_int_equal(ints[i], 3 * i);
+        test_assert_float_equal(floats[i], 0.25f * i);
+        test_assert_double_equal(doubles[i], 0.25 * i);
+        test_assert_bool_equal(bools[i], i % 3 == 0);
+    }
+
+    // The keywords are neither loaded nor cached
+    for (size_t k = 0; k < view->size(); k++)
+        test_assert_NULL(view->get_loaded_kw(k));
+    test_assert_size_t_equal(rd_file->cache_stats().misses, 0);
+
+    // A loaded keyword is copied, with its changes
+    rd_kw_iset_float(view->get_kw("FLOATS", 0), 5, 100);
+    view->read_into("FLOATS", 0, doubles.data(), RD_DOUBLE);
+    test_assert_double_equal(doubles[5], 100);
+
+    test_assert_throw(view->read_into("INTS", 0, doubles.data(), RD_DOUBLE),
+                      std::invalid_argument);
+    test_assert_throw(view->read_into("INTS", 1, ints.data(), RD_INT),
+                      std::out_of_range);
+
+    // The stream based read, which is used without positional reads
+    ERT::FortIO fortio(file_name, std::ios_base::in, formatted);
+    std::fill(ints.begin(), ints.end(), 0);
+    std::fill(doubles.begin(), doubles.end(), 0);
+    rd_kw_fread_data_into(fortio, view->get_file_kw(0).get_offset(), RD_INT,
+                          kw_size, ints.data(), RD_INT);
+    rd_kw_fread_data_into(fortio, view->get_file_kw(1).get_offset(),
+                          RD_FLOAT, kw_size, doubles.data(), RD_DOUBLE);
+    test_assert_int_equal(ints[kw_size - 1], 3 * (kw_size - 1));
+    test_assert_double_equal(doubles[kw_size - 1], 0.25 * (kw_size - 1));
+
+    // The positional read of an unformatted file does not fall back
+    if (!formatted) {
+        std::fill(ints.begin(), ints.end(), 0);
+        test_assert_true(rd_kw_pread_data_into(
+            fortio, view->get_file_kw(0).get_offset(), RD_INT, kw_size,
+            ints.data(), RD_INT));
+        for (int i = 0; i < kw_size; ++i)
+            test_assert_int_equal(ints[i], 3 * i);
+    }
+}
+
+void test_memory_budget(FileMode flags) {
+    rd::util::TestArea ta("Memory_budget");
+    const char *file_name = "DATA.UNRST";
+    const int kw_size = 2500;
+    const size_t kw_bytes = kw_size * sizeof(int);
+    write_multi_record_file(file_name, 20, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    rd_file->set_memory_budget(3 * kw_bytes + kw_bytes / 2);
+    auto pinned = rd_file->pin_kw("KW0", 0);
+    test_assert_not_NULL(pinned.get());
+
+    for (int k = 1; k < 20; k++) {
+        std::string name = "KW" + std::to_string(k);
+        rd_kw_type *kw = rd_file->get_kw(name, 0);
+        test_assert_int_equal(rd_kw_iget_int(kw, kw_size - 1), k + kw_size - 1);
+        test_assert_true(rd_file->cache_stats().loaded_bytes <=
+                         rd_file->memory_budget());
+    }
+    auto stats = rd_file->cache_stats();
+    test_assert_size_t_equal(stats.misses, 20);
+    test_assert_size_t_equal(stats.evictions, 17);
+    test_assert_size_t_equal(stats.loaded_bytes, 3 * kw_bytes);
+
+    // The pinned keyword is kept, and evicted keywords are read again
+    test_assert_int_equal(rd_kw_iget_int(pinned.get(), 1), 1);
+    test_assert_true(rd_file->get_kw("KW0", 0) == pinned.get());
+    test_assert_int_equal(rd_kw_iget_int(rd_file->get_kw("KW1", 0), 1), 2);
+    stats = rd_file->cache_stats();
+    test_assert_size_t_equal(stats.hits, 1);
+    test_assert_size_t_equal(stats.misses, 21);
+
+    // clear() keeps the pinned keyword
+    rd_file->get_global_view()->clear();
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, kw_bytes);
+    test_assert_true(rd_file->get_kw("KW0", 0) == pinned.get());
+
+    pinned.reset();
+    rd_file->get_global_view()->clear();
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, 0);
+
+    rd_file->set_memory_budget(0);
+    for (int k = 0; k < 20; k++)
+        rd_file->get_kw("KW" + std::to_string(k), 0);
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes,
+                             20 * kw_bytes);
+}
+
+void test_scope(FileMode flags) {
+    rd::util::TestArea ta("Scope");
+    const char *file_name = "DATA.UNRST";
+    const int kw_size = 2500;
+    const size_t kw_bytes = kw_size * sizeof(int);
+    write_multi_record_file(file_name, 5, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    rd_file->set_memory_budget(1);
+    {
+        // Every keyword returned in the scope is kept loaded
+        auto scope = rd_file->scope();
+        rd_kw_type *kw0 = rd_file->get_kw("KW0", 0);
+        {
+            auto inner = rd_file->scope();
+            rd_file->get_kw("KW1", 0);
+        }
+        rd_kw_type *kw2 = rd_file->get_global_view()->get_kw("KW2", 0);
+        test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes,
+                                 3 * kw_bytes);
+        test_assert_size_t_equal(rd_file->cache_stats().evictions, 0);
+        test_assert_true(rd_file->get_kw("KW0", 0) == kw0);
+        test_assert_int_equal(rd_kw_iget_int(kw0, 1), 1);
+        test_assert_int_equal(rd_kw_iget_int(kw2, 1), 3);
+
+        // ... and is not dropped by clear()
+        rd_file->get_global_view()->clear();
+        test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes,
+                                 3 * kw_bytes);
+    }
+    // Closing the last scope brings the file back within the budget
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, kw_bytes);
+    test_assert_size_t_equal(rd_file->cache_stats().evictions, 2);
+
+    // Keywords returned after the scope are evicted again
+    rd_file->get_kw("KW3", 0);
+    rd_file->get_kw("KW4", 0);
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, kw_bytes);
+}
+
+static std::string read_content(const char *file_name) {
+    std::ifstream stream(file_name, std::ios_base::binary);
+    return {std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()};
+}
+
+void test_write(FileMode flags) {
+    rd::util::TestArea ta("Write");
+    const char *file_name = "DATA.UNRST";
+    write_multi_record_file(file_name, 5, 2500);
+
+    // Keywords which are not loaded are copied as they are
+    auto rd_file = rd::File::open(file_name, flags);
+    {
+        ERT::FortIO target("COPY.UNRST", std::ios_base::out);
+        rd_file->write(target, 0);
+    }
+    test_assert_true(read_content("COPY.UNRST") == read_content(file_name));
+    test_assert_size_t_equal(rd_file->cache_stats().misses, 0);
+
+    // Loaded keywords are written with their modifications
+    rd_kw_iset_int(rd_file->get_kw("KW2", 0), 1000, -1);
+    {
+        ERT::FortIO target("COPY.UNRST", std::ios_base::out);
+        rd_file->get_global_view()->write(target, 1);
+    }
+    auto copy = rd::File::open("COPY.UNRST");
+    test_assert_size_t_equal(copy->size(), 4);
+    test_assert_int_equal(rd_kw_iget_int(copy->get_kw("KW2", 0), 1000), -1);
+    test_assert_int_equal(rd_kw_iget_int(copy->get_kw("KW4", 0), 1000), 1004);
+}
+
+static void write_restart_blocks(const char *file_name, int num_steps,
+                                 int kw_size) {
+    ERT::FortIO fortio(file_name, std::ios_base::out);
+    for (int step = 0; step < num_steps; ++step) {
+        rd_kw_type *seqnum = rd_kw_alloc(SEQNUM_KW, 1, RD_INT);
+        rd_kw_iset_int(seqnum, 0, step);
+        rd_kw_fwrite(seqnum, fortio);
+        rd_kw_free(seqnum);
+        for (const char *name : {"DATA", "XTRA"}) {
+            rd_kw_type *kw = rd_kw_alloc(name, kw_size, RD_INT);
+            for (int i = 0; i < kw_size; ++i)
+                rd_kw_iset_int(kw, i, step * kw_size + i);
+            rd_kw_fwrite(kw, fortio);
+            rd_kw_free(kw);
+        }
+    }
+}
+
+void test_block_prefetcher(FileMode flags) {
+    rd::util::TestArea ta("Block_prefetcher");
+    const char *file_name = "DATA.UNRST";
+    const int num_steps = 8;
+    const int kw_size = 2500;
+    write_restart_blocks(file_name, num_steps, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    test_assert_throw(rd::BlockPrefetcher(view, SEQNUM_KW, {}, 0),
+                      std::invalid_argument);
+
+    rd::BlockPrefetcher steps(view, SEQNUM_KW, {SEQNUM_KW, "DATA"});
+    test_assert_size_t_equal(steps.size(), num_steps);
+    for (int step = 0; step < num_steps; step++) {
+        auto step_view = steps.next();
+        test_assert_not_NULL(step_view.get());
+        test_assert_size_t_equal(step_view->size(), 3);
+
+        // The prefetched keywords survive clear(), the others are not loaded
+        view->clear();
+        rd_kw_type *data = step_view->get_loaded_kw(1);
+        test_assert_not_NULL(data);
+        test_assert_NULL(step_view->get_loaded_kw(2));
+        test_assert_int_equal(rd_kw_iget_int(step_view->get_kw(SEQNUM_KW, 0),
+                                             0),
+                              step);
+        test_assert_int_equal(rd_kw_iget_int(data, kw_size - 1),
+                              (step + 1) * kw_size - 1);
+        test_assert_int_equal(rd_kw_iget_int(step_view->get_kw("XTRA", 0), 0),
+                              step * kw_size);
+    }
+    test_assert_NULL(steps.next().get());
+    test_assert_NULL(steps.next().get());
+}
+
+void test_block_prefetcher_memory_cap(FileMode flags) {
+    rd::util::TestArea ta("Block_prefetcher_cap");
+    const char *file_name = "DATA.UNRST";
+    const int num_steps = 8;
+    const int kw_size = 2500;
+    const size_t block_bytes = (2 * kw_size + 1) * sizeof(int);
+    write_restart_blocks(file_name, num_steps, kw_size);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    rd::BlockPrefetcher steps(view, SEQNUM_KW, {}, 4, block_bytes);
+    for (int step = 0; step < num_steps; step++) {
+        auto step_view = steps.next();
+        test_assert_int_equal(rd_kw_iget_int(step_view->get_kw(SEQNUM_KW, 0),
+                                             0),
+                              step);
+        // The current block and at most one block ahead are loaded
+        view->clear();
+        test_assert_true(rd_file->cache_stats().loaded_bytes <=
+                         2 * block_bytes);
+    }
+    test_assert_NULL(steps.next().get());
+    view->clear();
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, 0);
+}
+
+void test_block_prefetcher_cancel(FileMode flags) {
+    rd::util::TestArea ta("Block_prefetcher_cancel");
+    const char *file_name = "DATA.UNRST";
+    write_restart_blocks(file_name, 32, 2500);
+
+    auto rd_file = rd::File::open(file_name, flags);
+    auto view = rd_file->get_global_view();
+    {
+        rd::BlockPrefetcher steps(view, SEQNUM_KW, {}, 3);
+        test_assert_not_NULL(steps.next().get());
+        test_assert_not_NULL(steps.next().get());
+        steps.cancel();
+        test_assert_NULL(steps.next().get());
+        view->clear();
+        test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, 0);
+    }
+
+    // Destroyed while the blocks ahead are loaded
+    {
+        rd::BlockPrefetcher steps(view, SEQNUM_KW, {}, 8);
+        test_assert_not_NULL(steps.next().get());
+    }
+    view->clear();
+    test_assert_size_t_equal(rd_file->cache_stats().loaded_bytes, 0);
+}
+
+void test_filtered_open(FileMode flags) {
+    rd::util::TestArea ta("Filtered_open");
+    const char *file_name = "DATA.UNRST";
+    const int num_steps = 4;
+    const int kw_size = 2500;
+    write_restart_blocks(file_name, num_steps, kw_size);
+
+    auto rd_file = rd::File::open(file_name, {"DATA"}, flags);
+    test_assert_size_t_equal(rd_file->size(), 2 * num_steps);
+    test_assert_false(rd_file->has_kw("XTRA"));
+    test_assert_size_t_equal(rd_file->num_named_kw(SEQNUM_KW), num_steps);
+
+    auto view = rd_file->get_global_view();
+    auto step_view = view->restart_view_from_seqnum_index(2);
+    test_assert_size_t_equal(step_view->size(), 2);
+    test_assert_int_equal(rd_kw_iget_int(step_view->get_kw("DATA", 0), 1),
+                          2 * kw_size + 1);
+
+    // The filter is applied to the keywords appended later
+    {
+        ERT::FortIO fortio(file_name, std::ios_base::app);
+        rd_kw_type *kw = rd_kw_alloc("XTRA", 1, RD_INT);
+        rd_kw_iset_int(kw, 0, 0);
+        rd_kw_fwrite(kw, fortio);
+        rd_kw_set_header_name(kw, "DATA");
+        rd_kw_fwrite(kw, fortio);
+        rd_kw_free(kw);
+    }
+    test_assert_size_t_equal(rd_file->refresh(), 1);
+    test_assert_size_t_equal(rd_file->num_named_kw("DATA"), num_steps + 1);
+    test_assert_false(rd_file->has_kw("XTRA"));
+
+    auto selected = rd::File::open(
+        file_name,
+        [](const std::string &header) { return header == "XTRA"; }, flags);
+    test_assert_size_t_equal(selected->num_named_kw("XTRA"), num_steps + 1);
+    test_assert_false(selected->has_kw("DATA"));
+
+    // The partial index of a filtered file is not written
+    test_assert_throw(rd_file->write_index("DATA.INDEX"), std::logic_error);
+    test_assert_false(std::filesystem::exists("DATA.INDEX"));
+
+    // Nor is a copy of it, which would lack the filtered keywords
+    {
+        ERT::FortIO target("COPY.UNRST", std::ios_base::out);
+        test_assert_throw(rd_file->write(target, 0), std::logic_error);
+        test_assert_throw(step_view->write(target, 0), std::logic_error);
+        test_assert_long_equal(target.ftell(), 0);
+    }
+}
+
+void test_index_memory() {
+    rd::util::TestArea ta("Index_memory");
+    const char *file_name = "DATA.UNRST";
+    const int num_steps = 20000;
+    write_restart_blocks(file_name, num_steps, 1);
+
+    auto rd_file = rd::File::open(file_name);
+    auto view = rd_file->get_global_view();
+    test_assert_size_t_equal(view->size(), 3 * num_steps);
+
+    double bytes_per_kw = static_cast<double>(view->index_memory_usage()) /
+                          static_cast<double>(view->size());
+    printf("Index of %zu keywords: %.1f bytes per keyword\n", view->size(),
+           bytes_per_kw);
+    test_assert_true(bytes_per_kw < 64);
+
+    // Loading keywords does not grow the index
+    size_t index_bytes = view->index_memory_usage();
+    view->preload_all();
+    test_assert_size_t_equal(view->index_memory_usage(), index_bytes);
+}
+
+void test_blockview_slices() {
+    rd::util::TestArea ta("Blockview_slices");
+    const char *file_name = "DATA.UNRST";
+    write_restart_blocks(file_name, 4, 100);
+
+    auto rd_file = rd::File::open(file_name);
+    auto view = rd_file->get_global_view();
+    test_assert_size_t_equal(view->num_distinct_kw(), 3);
+    test_assert_false(view->has_kw("LONGER_THAN_EIGHT"));
+
+    // A blockview shares the keywords of the view it is created from
+    auto step = view->restart_view_from_seqnum_index(1);
+    test_assert_size_t_equal(step->size(), 3);
+    test_assert_true(step->get_file_kw(0) == view->get_file_kw(3));
+    test_assert_true(step->get_kw("XTRA", 0) == view->get_kw(5));
+    test_assert_size_t_equal(step->num_named_kw(SEQNUM_KW), 1);
+    test_assert_throw(step->get_kw("DATA", 1), std::out_of_range);
+    test_assert_throw(step->get_file_kw(3), std::out_of_range);
+
+    std::vector<std::string> distinct = {SEQNUM_KW, "DATA", "XTRA"};
+    test_assert_true(step->get_distinct_kw() == distinct);
+    test_assert_true(view->get_distinct_kw() == distinct);
+
+    auto tail = step->blockview("DATA", std::nullopt, 0);
+    test_assert_size_t_equal(tail->size(), 2);
+    test_assert_false(tail->has_kw(SEQNUM_KW));
+    test_assert_NULL(step->blockview("DATA", std::nullopt, 1).get());
+
+    auto last = view->restart_view_from_seqnum_index(3);
+    test_assert_size_t_equal(last->size(), 3);
+
+    // Blockviews keep their range when keywords are appended to the file
+    {
+        ERT::FortIO fortio(file_name, std::ios_base::app);
+        rd_kw_type *kw = rd_kw_alloc("XTRA", 1, RD_INT);
+        rd_kw_iset_int(kw, 0, 0);
+        rd_kw_fwrite(kw, fortio);
+        rd_kw_free(kw);
+    }
+    test_assert_size_t_equal(rd_file->refresh(), 1);
+    test_assert_size_t_equal(view->num_named_kw("XTRA"), 5);
+    test_assert_size_t_equal(last->size(), 3);
+    test_assert_size_t_equal(last->num_named_kw("XTRA"), 1);
+    test_assert_size_t_equal(
+        view->restart_view_from_seqnum_index(3)->num_named_kw("XTRA"), 2);
+}
+
 int main(int argc, char **argv) {
     util_install_signals();
     test_load_nonexisting_file();
     test_create_and_load_index_file();
+    test_index_cache();
+    test_refresh(FileMode::DEFAULT);
+    test_refresh(FileMode::CLOSE_STREAM);
+    test_refresh(FileMode::MMAP);
+    test_concurrent_load(FileMode::DEFAULT);
+    test_concurrent_load(FileMode::CLOSE_STREAM);
+    test_concurrent_load(FileMode::MMAP);
+    test_concurrent_indexed_load(FileMode::DEFAULT);
+    test_concurrent_indexed_load(FileMode::CLOSE_STREAM);
+    test_concurrent_indexed_load(FileMode::MMAP);
+    test_preload(FileMode::DEFAULT);
+    test_preload(FileMode::CLOSE_STREAM);
+    test_preload(FileMode::MMAP);
+    test_memory_budget(FileMode::DEFAULT);
+    test_memory_budget(FileMode::CLOSE_STREAM);
+    test_scope(FileMode::DEFAULT);
+    test_scope(FileMode::CLOSE_STREAM);
+    test_write(FileMode::DEFAULT);
+    test_write(FileMode::CLOSE_STREAM);
+    test_write(FileMode::MMAP);
+    test_blockview_slices();
+    test_index_memory();
+    for (auto flags :
+         {FileMode::DEFAULT, FileMode::CLOSE_STREAM, FileMode::MMAP}) {
+        test_block_prefetcher(flags);
+        test_block_prefetcher_memory_cap(flags);
+        test_block_prefetcher_cancel(flags);
+        test_filtered_open(flags);
+        test_read_into(flags, false);
+    }
+    test_read_into(FileMode::DEFAULT, true);
 }
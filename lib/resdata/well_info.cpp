@@ -2,9 +2,12 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 #include <fmt/format.h>
 
 #include <resdata/rd_rsthead.hpp>
+#include <resdata/rd_block_prefetcher.hpp>
 #include <resdata/rd_file.hpp>
 #include <resdata/rd_file_view.hpp>
 #include <resdata/rd_kw.hpp>
@@ -72,10 +75,16 @@ void WellInfo::add_wells(rd::FileView *rst_view, int report_nr,
 void WellInfo::add_UNRST_wells(rd::File *rst_file,
                                bool load_segment_information) {
     auto rst_view = rst_file->get_global_view();
-    size_t num_blocks = rst_view->num_named_kw(SEQNUM_KW);
-    for (size_t block_nr = 0; block_nr < num_blocks; block_nr++) {
-
-        auto step_view = rst_view->restart_view_from_seqnum_index(block_nr);
+    /* RSEG is left out as it is read piecewise with rd_kw_index_fload. */
+    std::vector<std::string> well_kws = {
+        SEQNUM_KW, INTEHEAD_KW, LOGIHEAD_KW, DOUBHEAD_KW, IWEL_KW, ZWEL_KW,
+        XWEL_KW,   ICON_KW,     SCON_KW,     XCON_KW};
+    if (load_segment_information)
+        well_kws.push_back(ISEG_KW);
+
+    rd::BlockPrefetcher steps(rst_view, SEQNUM_KW, std::move(well_kws));
+    for (size_t block_nr = 0; block_nr < steps.size(); block_nr++) {
+        auto step_view = steps.next();
         if (!step_view)
             throw std::runtime_error(
                 fmt::format("Could not find restart step: {}", block_nr));
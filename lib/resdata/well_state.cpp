@@ -253,6 +253,8 @@ bool WellState::add_MSW(rd::FileView *rst_view, int well_nr,
 std::shared_ptr<WellState> WellState::read_wells_in_restart(
     rd::FileView *file_view, const rd_grid_type *grid, int report_nr,
     int global_well_nr, bool load_segment_information) {
+    /* The well is loaded from several keywords of the view at once */
+    rd::KWScope scope = file_view->scope();
     if (file_view->has_kw(IWEL_KW)) {
         auto global_header = RSTHead::read(file_view, -1);
         const rd_kw_type *global_iwel_kw = file_view->get_kw(IWEL_KW, 0);
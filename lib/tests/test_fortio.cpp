@@ -10,6 +10,7 @@
 #include <fstream>
 #include <initializer_list>
 #include <ios>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
@@ -18,6 +19,7 @@
 #include <vector>
 
 #include <resdata/FortIO.hpp>
+#include <resdata/rd_kw.hpp>
 
 #include <ert/util/util.hpp>
 
@@ -359,3 +361,436 @@ TEST_CASE_METHOD(Tmpdir, "Reading and writing with FortIO") {
     REQUIRE_FALSE(fortio.ftruncate(0));
     fortio.close();
 }
+
+TEST_CASE_METHOD(Tmpdir, "Memory mapped FortIO") {
+    auto filename = (dirname / "CASE.EGRID").string();
+    GIVEN("A fortio file with two records") {
+        write_records(filename, {{"A", 1}, {"BB", 2}});
+
+        ERT::FortIO fortio(filename, std::ios_base::in);
+        REQUIRE(fortio.mmap_file());
+        REQUIRE(fortio.mapped_size() == 4 * 4 + 3);
+
+        THEN("The records are found in the mapping") {
+            offset_type offset = 0;
+            int record_size = 0;
+            const char *record = fortio.mapped_record(offset, record_size);
+            REQUIRE(record != nullptr);
+            REQUIRE(record_size == 1);
+            REQUIRE(record[0] == 'A');
+            REQUIRE(offset == 2 * 4 + 1);
+
+            record = fortio.mapped_record(offset, record_size);
+            REQUIRE(record != nullptr);
+            REQUIRE(record_size == 2);
+            REQUIRE(std::string(record, 2) == "BB");
+            REQUIRE(offset == fortio.mapped_size());
+
+            REQUIRE(fortio.mapped_record(offset, record_size) == nullptr);
+        }
+
+        THEN("Unmapping falls back to the stream") {
+            fortio.munmap_file();
+            REQUIRE_FALSE(fortio.is_mapped());
+            std::array<char, 3> buffer = {0, 0, 0};
+            REQUIRE(fortio.fread_buffer(buffer.data(), 3));
+        }
+    }
+
+    GIVEN("A fortio file with mismatched record markers") {
+        {
+            auto content = concat(to_bytes_big(1), std::array{std::byte{'A'}},
+                                  to_bytes_big(3));
+            std::ofstream file(filename, std::ios::binary);
+            file.write(as_char(content.data()), content.size());
+        }
+
+        ERT::FortIO fortio(filename, std::ios_base::in);
+        REQUIRE(fortio.mmap_file());
+
+        THEN("No record is found") {
+            offset_type offset = 0;
+            int record_size = 0;
+            REQUIRE(fortio.mapped_record(offset, record_size) == nullptr);
+            REQUIRE(offset == 0);
+        }
+    }
+
+    GIVEN("A writable or formatted fortio") {
+        write_records(filename, {{"A", 1}});
+        THEN("The file is not mapped") {
+            ERT::FortIO writable(filename,
+                                 std::ios_base::in | std::ios_base::out);
+            REQUIRE_FALSE(writable.mmap_file());
+
+            ERT::FortIO formatted(filename, std::ios_base::in, true);
+            REQUIRE_FALSE(formatted.mmap_file());
+        }
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Raw copies between FortIO instances") {
+    auto source_file = (dirname / "SOURCE.UNRST").string();
+    std::string content(3 * 1024 * 1024 + 17, '\0');
+    for (size_t i = 0; i < content.size(); i++)
+        content[i] = static_cast<char>(i * 7 % 251);
+    {
+        std::ofstream file(source_file, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+
+    auto target_file = (dirname / "TARGET.UNRST").string();
+    auto read_target = [&]() {
+        std::ifstream file(target_file, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    };
+
+    GIVEN("A source which is read, or mapped") {
+        bool mapped = GENERATE(false, true);
+        ERT::FortIO source(source_file, std::ios_base::in);
+        if (mapped)
+            REQUIRE(source.mmap_file());
+
+        THEN("The byte ranges are appended to the target") {
+            {
+                ERT::FortIO target(target_file, std::ios_base::out);
+                target.fwrite_record("AB", 2);
+                REQUIRE(target.fwrite_raw(source, 5, content.size() - 5));
+                REQUIRE(target.fwrite_raw(source, 0, 5));
+                target.fwrite_record("CD", 2);
+            }
+
+            std::string data = read_target();
+            REQUIRE(data.size() == content.size() + 2 * 10);
+            REQUIRE(data.substr(10, content.size() - 5) == content.substr(5));
+            REQUIRE(data.substr(5 + content.size(), 5) == content.substr(0, 5));
+        }
+
+        THEN("Ranges beyond the source are rejected") {
+            ERT::FortIO target(target_file, std::ios_base::out);
+            REQUIRE_FALSE(target.fwrite_raw(source, 1, content.size()));
+            REQUIRE(target.ftell() == 0);
+        }
+    }
+
+    GIVEN("A target with a different format or byte order") {
+        ERT::FortIO source(source_file, std::ios_base::in);
+        bool fmt_file = GENERATE(false, true);
+        ERT::FortIO target(target_file, std::ios_base::out, fmt_file,
+                           fmt_file ? RD_ENDIAN_FLIP : !RD_ENDIAN_FLIP);
+        THEN("Nothing is copied") {
+            REQUIRE_FALSE(target.fwrite_raw(source, 0, 8));
+            REQUIRE(target.ftell() == 0);
+        }
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Gathered records match single records") {
+    bool endian_flip = GENERATE(false, true);
+    size_t record_size = GENERATE(4, 4000);
+    size_t size = GENERATE(0, 3, 4000, 4001, 2000 * 4000 + 12);
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++)
+        data[i] = static_cast<char>(i * 13 % 241);
+
+    auto read_file = [](const std::string &file_name) {
+        std::ifstream file(file_name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    };
+
+    auto expected_file = (dirname / "EXPECTED.UNRST").string();
+    {
+        ERT::FortIO fortio(expected_file, std::ios_base::out, false,
+                           endian_flip);
+        fortio.fwrite_record("AB", 2);
+        for (size_t offset = 0; offset < size; offset += record_size)
+            fortio.fwrite_record(&data[offset],
+                                 std::min(record_size, size - offset));
+        fortio.fwrite_record("CD", 2);
+    }
+
+    auto gathered_file = (dirname / "GATHERED.UNRST").string();
+    {
+        ERT::FortIO fortio(gathered_file, std::ios_base::out, false,
+                           endian_flip);
+        fortio.fwrite_record("AB", 2);
+        fortio.fwrite_records(data.data(), size, record_size);
+        REQUIRE(fortio.ftell() ==
+                static_cast<offset_type>(read_file(expected_file).size() -
+                                         10));
+        fortio.fwrite_record("CD", 2);
+    }
+    REQUIRE(read_file(gathered_file) == read_file(expected_file));
+
+    // The records are appended at the end of an existing file
+    {
+        ERT::FortIO fortio(gathered_file, std::ios_base::app, false,
+                           endian_flip);
+        fortio.fwrite_records(data.data(), size, record_size);
+    }
+    {
+        ERT::FortIO fortio(expected_file, std::ios_base::app, false,
+                           endian_flip);
+        for (size_t offset = 0; offset < size; offset += record_size)
+            fortio.fwrite_record(&data[offset],
+                                 std::min(record_size, size - offset));
+    }
+    REQUIRE(read_file(gathered_file) == read_file(expected_file));
+}
+
+TEST_CASE_METHOD(Tmpdir, "Records are read back with positional reads") {
+    bool endian_flip = GENERATE(false, true);
+    bool mapped = GENERATE(false, true);
+    size_t size = GENERATE(3, 4001, 2000 * 4000 + 12);
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++)
+        data[i] = static_cast<char>(i * 13 % 241);
+
+    auto filename = (dirname / "DATA.UNRST").string();
+    {
+        ERT::FortIO fortio(filename, std::ios_base::out, false, endian_flip);
+        fortio.fwrite_record("AB", 2);
+        fortio.fwrite_records(data.data(), size, 4000);
+    }
+
+    ERT::FortIO fortio(filename, std::ios_base::in, false, endian_flip);
+    if (mapped)
+        REQUIRE(fortio.mmap_file());
+    std::string read(size, '\0');
+    REQUIRE(fortio.pread_records(10, read.data(), size, 4000));
+    REQUIRE(read == data);
+    REQUIRE(fortio.ftell() == 0);
+
+    // The record markers must match the layout asked for
+    if (size > 2000)
+        REQUIRE_FALSE(fortio.pread_records(10, read.data(), size, 2000));
+    REQUIRE_FALSE(fortio.pread_records(0, read.data(), size, 4000));
+    REQUIRE_FALSE(fortio.pread_records(10, read.data(), size + 1, 4000));
+}
+
+namespace {
+
+/* The number of write system calls made by the process so far, or -1 where
+   /proc/self/io is not available. */
+long write_syscalls() {
+    std::ifstream io("/proc/self/io");
+    std::string name;
+    long value;
+    while (io >> name >> value)
+        if (name == "syscw:")
+            return value;
+    return -1;
+}
+
+} // namespace
+
+TEST_CASE_METHOD(Tmpdir, "Small gathered writes go through the buffer") {
+    if (write_syscalls() < 0)
+        return;
+
+    const std::string data(40, 'x');
+    const int num_writes = 2000;
+    auto filename = (dirname / "CASE.UNSMRY").string();
+    ERT::FortIO fortio(filename, std::ios_base::out);
+    const long before = write_syscalls();
+    for (int i = 0; i < num_writes; i++)
+        fortio.fwrite_records(data.data(), data.size(), 40);
+    fortio.fflush();
+
+    // 2000 records of 48 bytes fill a few dozen stream buffers
+    REQUIRE(write_syscalls() - before < num_writes / 10);
+    REQUIRE(fortio.ftell() == num_writes * 48);
+}
+
+TEST_CASE_METHOD(Tmpdir, "Access hints and buffer size of FortIO") {
+    using AccessHint = ERT::FortIO::AccessHint;
+    auto filename = (dirname / "CASE.UNRST").string();
+    std::vector<std::string> records;
+    {
+        ERT::FortIO fortio(filename, std::ios_base::out);
+        for (int i = 0; i < 50; i++) {
+            records.emplace_back(i * 97 % 3001, static_cast<char>(i));
+            fortio.fwrite_record(records.back().data(), records.back().size());
+        }
+    }
+
+    auto hint = GENERATE(AccessHint::NORMAL, AccessHint::SEQUENTIAL,
+                         AccessHint::RANDOM, AccessHint::STRIDED);
+    size_t buffer_size = GENERATE(0, 16, 4096);
+    bool mapped = GENERATE(false, true);
+
+    ERT::FortIO fortio(filename, std::ios_base::in);
+    fortio.set_buffer_size(buffer_size);
+    if (mapped)
+        REQUIRE(fortio.mmap_file());
+    fortio.advise(hint);
+    REQUIRE(fortio.access_hint() == hint);
+    REQUIRE(fortio.buffer_size() == buffer_size);
+
+    // will_need() is only a hint, also outside the file
+    fortio.will_need(0, util_file_size(filename.c_str()));
+    fortio.will_need(-10, 100);
+    fortio.will_need(util_file_size(filename.c_str()) + 100, 100);
+
+    auto read_records = [&](ERT::FortIO &fortio) {
+        fortio.fseek(0, SEEK_SET);
+        for (const auto &record : records) {
+            std::string buffer(record.size(), '\0');
+            REQUIRE(fortio.fread_buffer(buffer.data(), buffer.size()));
+            REQUIRE(buffer == record);
+        }
+    };
+    read_records(fortio);
+
+    THEN("The settings survive reopening the stream") {
+        REQUIRE(fortio.fclose_stream());
+        REQUIRE(fortio.fopen_stream());
+        REQUIRE(fortio.access_hint() == hint);
+        REQUIRE(fortio.buffer_size() == buffer_size);
+        read_records(fortio);
+    }
+    THEN("The settings move with the instance") {
+        ERT::FortIO moved(std::move(fortio));
+        REQUIRE(moved.access_hint() == hint);
+        REQUIRE(moved.buffer_size() == buffer_size);
+        read_records(moved);
+    }
+    THEN("The buffer can be reset while the stream is closed") {
+        REQUIRE(fortio.fclose_stream());
+        fortio.set_buffer_size(0);
+        REQUIRE(fortio.fopen_stream());
+        REQUIRE(fortio.buffer_size() == 0);
+        read_records(fortio);
+    }
+    THEN("The buffer can be changed in the middle of a read") {
+        fortio.fseek(0, SEEK_SET);
+        for (size_t i = 0; i < records.size(); i++) {
+            if (i == records.size() / 2)
+                fortio.set_buffer_size(buffer_size + 64);
+            std::string buffer(records[i].size(), '\0');
+            REQUIRE(fortio.fread_buffer(buffer.data(), buffer.size()));
+            REQUIRE(buffer == records[i]);
+        }
+        REQUIRE(fortio.buffer_size() == buffer_size + 64);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "The buffer can be changed while writing") {
+    std::string filename = (dirname / "WRITE").string();
+    std::vector<std::string> records;
+    for (int i = 0; i < 20; i++)
+        records.emplace_back(i * 311 % 1001, static_cast<char>(i));
+
+    {
+        ERT::FortIO fortio(filename, std::ios_base::out);
+        for (size_t i = 0; i < records.size(); i++) {
+            if (i == 5)
+                fortio.set_buffer_size(128);
+            if (i == 15)
+                fortio.set_buffer_size(0);
+            fortio.fwrite_record(records[i].data(), records[i].size());
+        }
+    }
+
+    ERT::FortIO fortio(filename, std::ios_base::in);
+    for (const auto &record : records) {
+        std::string buffer(record.size(), '\0');
+        REQUIRE(fortio.fread_buffer(buffer.data(), buffer.size()));
+        REQUIRE(buffer == record);
+    }
+    REQUIRE(fortio.read_at_eof());
+}
+
+TEST_CASE_METHOD(Tmpdir, "Direct io writes the same file as buffered io") {
+    bool endian_flip = GENERATE(false, true);
+    // Around the size of the aligned buffers, and at odd offsets
+    size_t size = GENERATE(3, (8 << 20) - 5, (8 << 20) + 4097, 20 << 20);
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++)
+        data[i] = static_cast<char>(i * 13 % 241);
+
+    auto read_file = [](const std::string &file_name) {
+        std::ifstream file(file_name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    };
+
+    auto source_file = (dirname / "SOURCE.UNRST").string();
+    {
+        ERT::FortIO fortio(source_file, std::ios_base::out, false,
+                           endian_flip);
+        fortio.fwrite_record("ABC", 3);
+        fortio.fwrite_records(data.data(), size, 4000);
+    }
+    offset_type record_size = read_file(source_file).size() - 11;
+
+    auto write_file = [&](const std::string &file_name, bool direct_io) {
+        ERT::FortIO source(source_file, std::ios_base::in, false,
+                           endian_flip);
+        ERT::FortIO fortio(file_name, std::ios_base::out, false, endian_flip);
+        fortio.set_direct_io(direct_io);
+        REQUIRE(fortio.direct_io() == direct_io);
+
+        fortio.fwrite_record("AB", 2);
+        fortio.fwrite_records(data.data(), size, 4000);
+        REQUIRE(fortio.fwrite_raw(source, 11, record_size));
+        fortio.fwrite_record("CD", 2);
+        REQUIRE(fortio.fwrite_raw(source, 0, 11 + record_size));
+    };
+    auto buffered_file = (dirname / "BUFFERED.UNRST").string();
+    auto direct_file = (dirname / "DIRECT.UNRST").string();
+    write_file(buffered_file, false);
+    write_file(direct_file, true);
+    REQUIRE(read_file(direct_file) == read_file(buffered_file));
+}
+
+TEST_CASE_METHOD(Tmpdir, "Direct io goes on across keywords") {
+    // Written in several chunks by rd_kw_fwrite(), with small keywords
+    // between the large ones
+    auto large = make_rd_kw("LARGE", 3 << 20, RD_FLOAT);
+    auto small = make_rd_kw("SMALL", 10, RD_INT);
+    for (int i = 0; i < rd_kw_get_size(large.get()); i++)
+        rd_kw_iset_float(large.get(), i, 0.5f * i);
+    for (int i = 0; i < rd_kw_get_size(small.get()); i++)
+        rd_kw_iset_int(small.get(), i, i);
+
+    auto read_file = [](const std::string &file_name) {
+        std::ifstream file(file_name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    };
+    auto write_file = [&](const std::string &file_name, bool direct_io) {
+        std::vector<offset_type> positions;
+        ERT::FortIO fortio(file_name, std::ios_base::out);
+        fortio.set_direct_io(direct_io);
+        for (int i = 0; i < 3; i++) {
+            rd_kw_fwrite(small.get(), fortio);
+            positions.push_back(fortio.ftell());
+            rd_kw_fwrite(large.get(), fortio);
+            positions.push_back(fortio.ftell());
+        }
+        fortio.fflush();
+        REQUIRE(static_cast<offset_type>(
+                    std::filesystem::file_size(file_name)) ==
+                positions.back());
+
+        rd_kw_fwrite(small.get(), fortio);
+        positions.push_back(fortio.ftell());
+        return positions;
+    };
+
+    auto buffered_file = (dirname / "BUFFERED.UNRST").string();
+    auto direct_file = (dirname / "DIRECT.UNRST").string();
+    auto buffered_positions = write_file(buffered_file, false);
+    auto direct_positions = write_file(direct_file, true);
+    REQUIRE(direct_positions == buffered_positions);
+    REQUIRE(read_file(direct_file) == read_file(buffered_file));
+
+    ERT::FortIO fortio(direct_file, std::ios_base::in);
+    rd_kw_ptr kw(rd_kw_fread_alloc(fortio), rd_kw_free);
+    REQUIRE(rd_kw_equal(kw.get(), small.get()));
+    kw.reset(rd_kw_fread_alloc(fortio));
+    REQUIRE(rd_kw_equal(kw.get(), large.get()));
+}
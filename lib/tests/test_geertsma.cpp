@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <resdata/FortIO.hpp>
@@ -242,6 +243,60 @@ TEST_CASE_METHOD(Tmpdir,
     REQUIRE(dz > 0);
 }
 
+TEST_CASE_METHOD(Tmpdir, "Subsidence surveys load within a memory budget") {
+    auto grid = make_rectangular_grid(2, 1, 1, 100.0, 100.0, 100.0, nullptr);
+
+    auto init_path = dirname / "TEST.INIT";
+    auto unrst_path = dirname / "TEST.UNRST";
+
+    write_subsidence_init(init_path, rd_grid_get_active_size(grid.get()));
+    write_subsidence_restart(unrst_path, std::vector<float>{1.0f, 10.0f},
+                             std::vector<float>{10.0f, 20.0f},
+                             std::vector<float>{1e5f, 2e5f},
+                             std::vector<float>{9e4f, 8e4f});
+
+    std::unique_ptr<rd::File> init = rd::File::open(init_path);
+    std::unique_ptr<rd::File> restart = rd::File::open(unrst_path);
+    std::unique_ptr<rd::File> budget_restart = rd::File::open(unrst_path);
+    budget_restart->set_memory_budget(1);
+
+    using subsidence_ptr =
+        std::unique_ptr<rd_subsidence_type, decltype(&rd_subsidence_free)>;
+    subsidence_ptr subsidence(rd_subsidence_alloc(grid.get(), init.get()),
+                              rd_subsidence_free);
+    subsidence_ptr budget_subsidence(
+        rd_subsidence_alloc(grid.get(), init.get()), rd_subsidence_free);
+
+    for (int i = 0; i < 2; i++) {
+        std::string name = "S" + std::to_string(i + 1);
+        auto view =
+            restart->get_global_view()->restart_view_from_seqnum_index(i);
+        auto budget_view =
+            budget_restart->get_global_view()->restart_view_from_seqnum_index(
+                i);
+        rd_subsidence_add_survey_PRESSURE(subsidence.get(), name, view.get());
+        rd_subsidence_add_survey_PRESSURE(budget_subsidence.get(), name,
+                                          budget_view.get());
+    }
+
+    // PRESSURE and RPORV are used together, and kept while the survey loads
+    auto stats = budget_restart->cache_stats();
+    REQUIRE(stats.evictions > 0);
+    REQUIRE(stats.loaded_bytes == 2 * sizeof(float));
+
+    for (const auto *monitor : {"S2", ""}) {
+        std::optional<std::string> monitor_name;
+        if (*monitor)
+            monitor_name = monitor;
+        REQUIRE(rd_subsidence_eval_geertsma_rporv(
+                    budget_subsidence.get(), "S1", monitor_name, nullptr, 1000,
+                    1000, 0, 5e8, 0.3, 0.0) ==
+                rd_subsidence_eval_geertsma_rporv(subsidence.get(), "S1",
+                                                  monitor_name, nullptr, 1000,
+                                                  1000, 0, 5e8, 0.3, 0.0));
+    }
+}
+
 TEST_CASE_METHOD(Tmpdir, "Subsidence survey validation") {
     auto grid = make_rectangular_grid(2, 1, 1, 100.0, 100.0, 100.0, nullptr);
 
@@ -1,10 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include <cstdio>
 #include <fstream>
 #include <ios>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 #include <resdata/FortIO.hpp>
 #include <resdata/rd_file_kw.hpp>
@@ -24,10 +26,6 @@ SCENARIO("A FileKW is constructed from explicit header information") {
             REQUIRE(file_kw.get_header() == "TEST_KW");
             REQUIRE(rd_type_is_equal(file_kw.get_data_type(), RD_INT));
         }
-
-        THEN("No keyword has been loaded yet") {
-            REQUIRE(file_kw.get_kw_ptr() == nullptr);
-        }
     }
 }
 
@@ -48,6 +46,28 @@ SCENARIO("A FileKW is constructed from an rd_kw instance") {
     }
 }
 
+SCENARIO("Keyword headers are packed into integers") {
+    GIVEN("Headers of up to eight characters") {
+        THEN("They survive packing and unpacking") {
+            for (const std::string header : {"", "KW", "EIGHTLEN"})
+                REQUIRE(unpack_kw_name(pack_kw_name(header).value()) ==
+                        header);
+        }
+        THEN("Different headers pack differently") {
+            REQUIRE(pack_kw_name("SWAT") != pack_kw_name("SWAT2"));
+            FileKW file_kw(0, RD_INT, 1, "KW");
+            REQUIRE(pack_kw_name("KW") == file_kw.get_name());
+        }
+    }
+    GIVEN("A header longer than eight characters") {
+        THEN("It can not be packed") {
+            REQUIRE_FALSE(pack_kw_name("NINECHARS").has_value());
+            REQUIRE_THROWS_AS(FileKW(0, RD_INT, 1, "NINECHARS"),
+                              std::invalid_argument);
+        }
+    }
+}
+
 SCENARIO("Two FileKW instances are compared for equality") {
     GIVEN("A reference FileKW") {
         FileKW reference(64, RD_INT, 3, "KW");
@@ -99,7 +119,7 @@ SCENARIO_METHOD(Tmpdir, "A FileKW index entry is written and read back") {
 
             THEN("A single FileKW equal to the original is recovered") {
                 REQUIRE(kw_list.size() == 1);
-                REQUIRE(*kw_list[0] == original);
+                REQUIRE(kw_list[0] == original);
             }
         }
     }
@@ -129,9 +149,9 @@ SCENARIO_METHOD(Tmpdir, "Several FileKW index entries are written and read") {
 
             THEN("Each recovered FileKW equals its original in order") {
                 REQUIRE(kw_list.size() == 3);
-                REQUIRE(*kw_list[0] == first);
-                REQUIRE(*kw_list[1] == second);
-                REQUIRE(*kw_list[2] == third);
+                REQUIRE(kw_list[0] == first);
+                REQUIRE(kw_list[1] == second);
+                REQUIRE(kw_list[2] == third);
             }
         }
 
@@ -168,8 +188,8 @@ SCENARIO_METHOD(Tmpdir, "A full width eight character header round-trips") {
 
             THEN("The full eight character header is recovered intact") {
                 REQUIRE(kw_list.size() == 1);
-                REQUIRE(kw_list[0]->get_header() == "EIGHTLEN");
-                REQUIRE(*kw_list[0] == original);
+                REQUIRE(kw_list[0].get_header() == "EIGHTLEN");
+                REQUIRE(kw_list[0] == original);
             }
         }
     }
@@ -213,7 +233,7 @@ SCENARIO_METHOD(Tmpdir, "Reading a FileKW past the end of the stream fails") {
             REQUIRE(stream.good());
             stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
             auto disk_kw = FileKW::read(stream, 1);
-            REQUIRE(*disk_kw[0] == original);
+            REQUIRE(disk_kw[0] == original);
 
             THEN("Reading another entry throws") {
                 REQUIRE_THROWS_AS(FileKW::read(stream, 1),
@@ -223,7 +243,7 @@ SCENARIO_METHOD(Tmpdir, "Reading a FileKW past the end of the stream fails") {
     }
 }
 
-SCENARIO_METHOD(Tmpdir, "A FileKW lazily loads its keyword from file") {
+SCENARIO_METHOD(Tmpdir, "A FileKW loads its keyword from file") {
     GIVEN("A keyword written to a fortran formatted file") {
         auto filename = (dirname / "DATA").string();
 
@@ -240,36 +260,69 @@ SCENARIO_METHOD(Tmpdir, "A FileKW lazily loads its keyword from file") {
 
         FileKW file_kw(kw.get(), offset);
 
-        THEN("The keyword is not loaded until requested") {
-            REQUIRE(file_kw.get_kw_ptr() == nullptr);
-        }
-
-        WHEN("get_kw is called with a reading fortio handle") {
+        WHEN("load is called with a reading fortio handle") {
             ERT::FortIO fortio(filename, std::ios_base::in);
-            rd_kw_type *loaded = file_kw.get_kw(fortio);
+            auto loaded = file_kw.load(fortio);
 
-            THEN("The keyword is loaded and cached") {
+            THEN("The keyword is read") {
                 REQUIRE(loaded != nullptr);
-                REQUIRE(file_kw.get_kw_ptr() == loaded);
-                REQUIRE(rd_kw_get_size(loaded) == 4);
+                REQUIRE(rd_kw_get_size(loaded.get()) == 4);
                 for (int i = 0; i < 4; i++)
-                    REQUIRE(rd_kw_iget_int(loaded, i) == i * 10);
+                    REQUIRE(rd_kw_iget_int(loaded.get(), i) == i * 10);
+            }
+        }
+
+        WHEN("The header does not match the keyword in the file") {
+            FileKW other(offset, RD_INT, 5, "MYKW");
+            ERT::FortIO fortio(filename, std::ios_base::in);
+
+            THEN("load throws") {
+                REQUIRE_THROWS_AS(other.load(fortio), std::runtime_error);
             }
+        }
+    }
+}
+
+SCENARIO_METHOD(Tmpdir, "A FileKW is loaded with positional reads") {
+    GIVEN("A file holding a keyword spanning several records") {
+        auto filename = (dirname / "DATA.UNRST").string();
+        auto kw = make_rd_kw("MYKW", 2500, RD_FLOAT);
+        for (int i = 0; i < 2500; i++)
+            rd_kw_iset_float(kw.get(), i, i * 0.5f);
+
+        offset_type offset;
+        {
+            ERT::FortIO fortio(filename, std::ios_base::out);
+            rd_kw_fwrite(kw.get(), fortio);
+            offset = fortio.ftell();
+            rd_kw_fwrite(kw.get(), fortio);
+        }
+        FileKW file_kw(kw.get(), offset);
+
+        WHEN("pread is called") {
+            bool mapped = GENERATE(false, true);
+            ERT::FortIO fortio(filename, std::ios_base::in);
+            if (mapped)
+                REQUIRE(fortio.mmap_file());
+            REQUIRE(fortio.can_pread());
 
-            AND_WHEN("clear is called") {
-                file_kw.clear();
+            offset_type position = fortio.ftell();
+            auto loaded = file_kw.pread(fortio);
 
-                THEN("The cached keyword is dropped") {
-                    REQUIRE(file_kw.get_kw_ptr() == nullptr);
-                }
+            THEN("The keyword is loaded without moving the stream") {
+                REQUIRE(fortio.ftell() == position);
+                REQUIRE(loaded != nullptr);
+                REQUIRE(rd_kw_equal(loaded.get(), kw.get()));
             }
         }
     }
 }
 
-SCENARIO_METHOD(Tmpdir, "An unloaded FileKW cannot be written back in place") {
-    GIVEN("A FileKW whose keyword has not been loaded") {
+SCENARIO_METHOD(Tmpdir,
+                "A FileKW is not written back in place from another keyword") {
+    GIVEN("A FileKW and a keyword with a different size") {
         FileKW file_kw(0, RD_INT, 10, "TEST_KW");
+        auto kw = make_rd_kw("TEST_KW", 5, RD_INT);
 
         auto filename = (dirname / "dummy").string();
         {
@@ -281,7 +334,7 @@ SCENARIO_METHOD(Tmpdir, "An unloaded FileKW cannot be written back in place") {
             ERT::FortIO fortio(filename, std::ios_base::in, false, true);
 
             THEN("A runtime_error is raised") {
-                REQUIRE_THROWS_AS(file_kw.inplace_write(fortio),
+                REQUIRE_THROWS_AS(file_kw.inplace_write(fortio, kw.get()),
                                   std::runtime_error);
             }
         }
@@ -1,14 +1,24 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <limits>
 #include <new>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <ert/util/int_vector.hpp>
 
@@ -20,6 +30,7 @@
 #include "tmpdir.hpp"
 
 using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinRel;
 
 namespace {
 
@@ -380,3 +391,581 @@ TEST_CASE_METHOD(Tmpdir, "FileKW::read guards against buffer_size overflow",
     REQUIRE(stream.good());
     REQUIRE_THROWS_AS(FileKW::read(stream, SIZE_MAX), std::length_error);
 }
+
+TEST_CASE_METHOD(Tmpdir, "keywords read from a memory mapped file",
+                 "[rd_kw]") {
+    auto path = (dirname / "FILE").string();
+    auto int_kw = make_int_kw("INTKW", 2500);
+    auto double_kw = make_rd_kw("DBLKW", 1001, RD_DOUBLE);
+    for (int i = 0; i < 1001; i++)
+        rd_kw_iset_double(double_kw.get(), i, 0.5 * i);
+    auto bool_kw = make_rd_kw("BOOLKW", 3, RD_BOOL);
+    rd_kw_iset_bool(bool_kw.get(), 1, true);
+    auto char_kw = make_rd_kw("CHARKW", 210, RD_CHAR);
+    for (int i = 0; i < 210; i++)
+        rd_kw_iset_string8(char_kw.get(), i, std::to_string(i).c_str());
+    auto mess_kw = make_rd_kw("MESSKW", 0, RD_MESS);
+    {
+        ERT::FortIO fortio(path, std::ios_base::out);
+        for (const auto *kw : {int_kw.get(), double_kw.get(), bool_kw.get(),
+                               char_kw.get(), mess_kw.get()})
+            rd_kw_fwrite(kw, fortio);
+    }
+
+    ERT::FortIO fortio(path, std::ios_base::in);
+    REQUIRE(fortio.mmap_file());
+    REQUIRE(fortio.is_mapped());
+
+    for (const auto *kw : {int_kw.get(), double_kw.get(), bool_kw.get(),
+                           char_kw.get(), mess_kw.get()}) {
+        rd_kw_ptr loaded(rd_kw_fread_alloc(fortio), rd_kw_free);
+        REQUIRE(loaded);
+        REQUIRE(rd_kw_equal(loaded.get(), kw));
+    }
+    REQUIRE(fortio.read_at_eof());
+    REQUIRE(rd_kw_fread_alloc(fortio) == nullptr);
+}
+
+TEST_CASE_METHOD(Tmpdir, "a truncated keyword can not be read from a mapping",
+                 "[rd_kw]") {
+    auto path = (dirname / "FILE").string();
+    {
+        auto kw = make_int_kw("INTKW", 100);
+        ERT::FortIO fortio(path, std::ios_base::out);
+        rd_kw_fwrite(kw.get(), fortio);
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+    ERT::FortIO fortio(path, std::ios_base::in);
+    REQUIRE(fortio.mmap_file());
+    REQUIRE(rd_kw_fread_alloc(fortio) == nullptr);
+}
+
+TEST_CASE_METHOD(Tmpdir, "fread_indexed_data coalesces and scatters elements",
+                 "[rd_kw]") {
+    auto path = (dirname / "FILE").string();
+    {
+        auto kw = make_int_kw("INTKW", 3500);
+        ERT::FortIO fortio(path, std::ios_base::out);
+        rd_kw_fwrite(kw.get(), fortio);
+    }
+
+    // Unsorted, with duplicates and spanning several fortran records.
+    const std::vector<int> indices = {3499, 0, 999, 1000, 17, 2001, 17, 1999};
+    auto index_map = make_int_vector(0, 0);
+    for (int index : indices)
+        int_vector_append(index_map.get(), index);
+
+    ERT::FortIO fortio(path, std::ios_base::in);
+    bool mapped = GENERATE(false, true);
+    if (mapped)
+        REQUIRE(fortio.mmap_file());
+    // Strided readers read the ranges with pread()
+    if (GENERATE(false, true))
+        fortio.advise(ERT::FortIO::AccessHint::STRIDED);
+
+    offset_type max_gap = GENERATE(0, 64, RD_KW_FREAD_INDEXED_MAX_GAP,
+                                   offset_type(1) << 30);
+    std::vector<int> values(indices.size(), -1);
+    rd_kw_fread_indexed_data(fortio, 0, RD_INT, 3500, index_map.get(),
+                             reinterpret_cast<char *>(values.data()),
+                             max_gap);
+    REQUIRE(values == indices);
+
+    SECTION("out of range elements are rejected") {
+        int_vector_append(index_map.get(), 3500);
+        values.resize(indices.size() + 1);
+        REQUIRE_THROWS_AS(
+            rd_kw_fread_indexed_data(fortio, 0, RD_INT, 3500, index_map.get(),
+                                     reinterpret_cast<char *>(values.data()),
+                                     max_gap),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "formatted keywords survive a round trip",
+                 "[rd_kw]") {
+    auto path = (dirname / "CASE.FUNRST").string();
+    auto int_kw = make_int_kw("INTKW", 1000);
+    auto float_kw = make_rd_kw("FLOATKW", 777, RD_FLOAT);
+    auto double_kw = make_rd_kw("DBLKW", 333, RD_DOUBLE);
+    auto bool_kw = make_rd_kw("BOOLKW", 25, RD_BOOL);
+    auto char_kw = make_rd_kw("CHARKW", 11, RD_CHAR);
+    auto string_kw = make_rd_kw("STRKW", 4, RD_STRING(12));
+    for (int i = 0; i < 777; i++)
+        rd_kw_iset_float(float_kw.get(), i, -0.25f * i + 1.5e-7f);
+    for (int i = 0; i < 333; i++)
+        rd_kw_iset_double(double_kw.get(), i, 1.0 / (i + 1) - 1e12 * i);
+    for (int i = 0; i < 25; i++)
+        rd_kw_iset_bool(bool_kw.get(), i, i % 3 == 0);
+    for (int i = 0; i < 11; i++)
+        rd_kw_iset_string8(char_kw.get(), i, i % 2 ? "A B" : "WELL-1");
+    for (int i = 0; i < 4; i++)
+        rd_kw_iset_string_ptr(string_kw.get(), i, i % 2 ? "long string" : "");
+
+    const std::vector<rd_kw_type *> kws = {int_kw.get(),  float_kw.get(),
+                                           double_kw.get(), bool_kw.get(),
+                                           char_kw.get(), string_kw.get()};
+    {
+        ERT::FortIO fortio(path, std::ios_base::out, /*fmt_file=*/true);
+        for (auto *kw : kws)
+            rd_kw_fwrite(kw, fortio);
+    }
+
+    ERT::FortIO fortio(path, std::ios_base::in, /*fmt_file=*/true);
+    for (auto *kw : kws) {
+        rd_kw_ptr copy{rd_kw_fread_alloc(fortio), rd_kw_free};
+        REQUIRE(copy);
+        INFO(rd_kw_get_header(kw));
+        REQUIRE(rd_kw_get_size(copy.get()) == rd_kw_get_size(kw));
+        if (kw == float_kw.get()) {
+            for (int i = 0; i < rd_kw_get_size(kw); i++)
+                REQUIRE_THAT(rd_kw_iget_float(copy.get(), i),
+                             WithinRel(rd_kw_iget_float(kw, i), 1e-7f));
+        } else if (kw == double_kw.get()) {
+            for (int i = 0; i < rd_kw_get_size(kw); i++)
+                REQUIRE_THAT(rd_kw_iget_double(copy.get(), i),
+                             WithinRel(rd_kw_iget_double(kw, i), 1e-13));
+        } else
+            REQUIRE(rd_kw_equal(copy.get(), kw));
+    }
+    REQUIRE(rd_kw_fread_alloc(fortio) == nullptr);
+}
+
+TEST_CASE_METHOD(Tmpdir, "formatted keywords tolerate irregular layout",
+                 "[rd_kw]") {
+    auto path = (dirname / "CASE.FUNRST").string();
+    {
+        std::ofstream out(path);
+        out << " 'DBLKW   '           4 'DOUB'\n"
+            << "  0.12500000000000D+01 -0.3D-02\n\n"
+            << "\t+1.0E+2   0.50000000000000D+00\n"
+            << " 'REALKW  '  3 'REAL'\n"
+            << "   0.25000000E+00  -1.5d+01    +7\n"
+            << " 'INTKW   ' 3 'INTE'\n"
+            << " +5 -7\n          11\n"
+            << " 'LOGIKW  ' 4 'LOGI'\n"
+            << "  T  F\n  F    T\n";
+    }
+
+    ERT::FortIO fortio(path, std::ios_base::in, /*fmt_file=*/true);
+    rd_kw_ptr dbl_kw{rd_kw_fread_alloc(fortio), rd_kw_free};
+    REQUIRE(dbl_kw);
+    REQUIRE(rd_kw_iget_double(dbl_kw.get(), 0) == 1.25);
+    REQUIRE_THAT(rd_kw_iget_double(dbl_kw.get(), 1), WithinRel(-0.003, 1e-15));
+    REQUIRE(rd_kw_iget_double(dbl_kw.get(), 2) == 100.0);
+    REQUIRE(rd_kw_iget_double(dbl_kw.get(), 3) == 0.5);
+
+    rd_kw_ptr real_kw{rd_kw_fread_alloc(fortio), rd_kw_free};
+    REQUIRE(real_kw);
+    REQUIRE(rd_kw_iget_float(real_kw.get(), 0) == 0.25f);
+    REQUIRE(rd_kw_iget_float(real_kw.get(), 1) == -15.0f);
+    REQUIRE(rd_kw_iget_float(real_kw.get(), 2) == 7.0f);
+
+    rd_kw_ptr int_kw{rd_kw_fread_alloc(fortio), rd_kw_free};
+    REQUIRE(int_kw);
+    REQUIRE(rd_kw_iget_int(int_kw.get(), 0) == 5);
+    REQUIRE(rd_kw_iget_int(int_kw.get(), 1) == -7);
+    REQUIRE(rd_kw_iget_int(int_kw.get(), 2) == 11);
+
+    rd_kw_ptr bool_kw{rd_kw_fread_alloc(fortio), rd_kw_free};
+    REQUIRE(bool_kw);
+    REQUIRE(rd_kw_iget_bool(bool_kw.get(), 0));
+    REQUIRE_FALSE(rd_kw_iget_bool(bool_kw.get(), 1));
+    REQUIRE_FALSE(rd_kw_iget_bool(bool_kw.get(), 2));
+    REQUIRE(rd_kw_iget_bool(bool_kw.get(), 3));
+}
+
+TEST_CASE_METHOD(Tmpdir, "formatted keywords can be skipped and indexed",
+                 "[rd_kw]") {
+    auto path = (dirname / "CASE.FUNRST").string();
+    {
+        ERT::FortIO fortio(path, std::ios_base::out, /*fmt_file=*/true);
+        for (int k = 0; k < 3; k++) {
+            const std::string name = "KW" + std::to_string(k);
+            auto kw = make_int_kw(name.c_str(), 3500 + k);
+            rd_kw_fwrite(kw.get(), fortio);
+        }
+    }
+
+    ERT::FortIO fortio(path, std::ios_base::in, /*fmt_file=*/true);
+    rd_kw_fskip(fortio);
+    const offset_type kw_offset = fortio.ftell();
+    rd_kw_fskip(fortio);
+    rd_kw_ptr last{rd_kw_fread_alloc(fortio), rd_kw_free};
+    REQUIRE(last);
+    REQUIRE(std::string(rd_kw_get_header(last.get())) == "KW2");
+    REQUIRE(rd_kw_get_size(last.get()) == 3502);
+
+    const std::vector<int> indices = {3500, 0, 999, 17, 2001, 17};
+    auto index_map = make_int_vector(0, 0);
+    for (int index : indices)
+        int_vector_append(index_map.get(), index);
+
+    std::vector<int> values(indices.size(), -1);
+    rd_kw_fread_indexed_data(fortio, kw_offset, RD_INT, 3501, index_map.get(),
+                             reinterpret_cast<char *>(values.data()));
+    REQUIRE(values == indices);
+
+    int_vector_append(index_map.get(), 3501);
+    values.resize(indices.size() + 1);
+    REQUIRE_THROWS_AS(
+        rd_kw_fread_indexed_data(fortio, kw_offset, RD_INT, 3501,
+                                 index_map.get(),
+                                 reinterpret_cast<char *>(values.data())),
+        std::invalid_argument);
+}
+
+namespace {
+
+/* The printf based formatting the formatted writer must reproduce. */
+std::string printf_scientific(const char *format, double x) {
+    double pow_x = ceil(log10(fabs(x)));
+    double arg_x = x / pow(10.0, pow_x);
+    if (x != 0.0) {
+        if (fabs(arg_x) == 1.0) {
+            arg_x *= 0.10;
+            pow_x += 1;
+        }
+    } else {
+        arg_x = 0.0;
+        pow_x = 0.0;
+    }
+    char text[64];
+    snprintf(text, sizeof text, format, arg_x, (int)pow_x);
+    return text;
+}
+
+template <typename T>
+std::string printf_formatted_kw(const char *name, const char *type,
+                                const std::vector<T> &values) {
+    constexpr bool is_float = std::is_same_v<T, float>;
+    const size_t columns = is_float ? 4 : 3;
+    const char *format = is_float ? "  %11.8fE%+03d" : "  %17.14fD%+03d";
+
+    char header[64];
+    snprintf(header, sizeof header, " '%-8s' %11d '%-4s'\n", name,
+             static_cast<int>(values.size()), type);
+    std::string text = header;
+    for (size_t block = 0; block < values.size(); block += 1000) {
+        size_t block_end = std::min(block + 1000, values.size());
+        for (size_t line = block; line < block_end; line += columns) {
+            for (size_t i = line; i < std::min(line + columns, block_end); i++)
+                text += printf_scientific(format, values[i]);
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+template <typename T>
+void require_printf_layout(const std::filesystem::path &dirname) {
+    constexpr bool is_float = std::is_same_v<T, float>;
+    using bits_type = std::conditional_t<is_float, uint32_t, uint64_t>;
+    using limits = std::numeric_limits<T>;
+    std::vector<T> values = {0.0, -0.0, 1.0, -1.0, 0.1, 10.0, 1e-5,
+                             0.999999999, 0.99999999999999999, 123456789.0,
+                             -2.5e-3};
+    values.insert(values.end(), {limits::max(), limits::lowest(),
+                                 limits::min(), limits::denorm_min()});
+    for (int power = -40; power <= 40; power++) {
+        auto value = static_cast<T>(pow(10.0, power));
+        for (T near : {value, std::nextafter(value, T(0)),
+                       std::nextafter(value, limits::max())})
+            if (std::isfinite(near) && near != 0)
+                values.push_back(near);
+    }
+    for (int i = 0; i < 2000; i++)
+        values.push_back(static_cast<T>(i * 0.001 - 0.5));
+    std::mt19937_64 rng(42);
+    while (values.size() < 10000) {
+        auto bits = static_cast<bits_type>(rng());
+        T value;
+        std::memcpy(&value, &bits, sizeof value);
+        if (std::isfinite(value))
+            values.push_back(value);
+    }
+
+    auto kw = make_rd_kw(is_float ? "REALKW" : "DOUBKW",
+                         static_cast<int>(values.size()),
+                         is_float ? RD_FLOAT : RD_DOUBLE);
+    std::memcpy(rd_kw_get_void_ptr(kw.get()), values.data(),
+                values.size() * sizeof(T));
+
+    auto path = (dirname / "CASE.FUNRST").string();
+    {
+        ERT::FortIO fortio(path, std::ios_base::out, /*fmt_file=*/true);
+        rd_kw_fwrite(kw.get(), fortio);
+    }
+    std::stringstream written;
+    written << std::ifstream(path).rdbuf();
+
+    REQUIRE(written.str() ==
+            printf_formatted_kw(is_float ? "REALKW" : "DOUBKW",
+                                is_float ? "REAL" : "DOUB", values));
+}
+
+} // namespace
+
+TEST_CASE_METHOD(Tmpdir, "formatted reals are written as with printf",
+                 "[rd_kw]") {
+    SECTION("float") { require_printf_layout<float>(dirname); }
+    SECTION("double") { require_printf_layout<double>(dirname); }
+}
+
+TEST_CASE_METHOD(Tmpdir, "formatted integers and strings are laid out",
+                 "[rd_kw]") {
+    auto int_kw = make_rd_kw("INTKW", 8, RD_INT);
+    const int ints[] = {0, -1, 7, 2147483647, -2147483647 - 1, 42, 1000, -9};
+    for (int i = 0; i < 8; i++)
+        rd_kw_iset_int(int_kw.get(), i, ints[i]);
+    auto bool_kw = make_rd_kw("BOOLKW", 3, RD_BOOL);
+    rd_kw_iset_bool(bool_kw.get(), 0, true);
+    rd_kw_iset_bool(bool_kw.get(), 1, false);
+    rd_kw_iset_bool(bool_kw.get(), 2, true);
+    auto char_kw = make_rd_kw("CHARKW", 2, RD_CHAR);
+    rd_kw_iset_string8(char_kw.get(), 0, "AB");
+    rd_kw_iset_string8(char_kw.get(), 1, "12345678");
+    auto string_kw = make_rd_kw("STRKW", 1, RD_STRING(10));
+    rd_kw_iset_string_ptr(string_kw.get(), 0, "xyz");
+
+    auto path = (dirname / "CASE.FUNRST").string();
+    {
+        ERT::FortIO fortio(path, std::ios_base::out, /*fmt_file=*/true);
+        for (auto *kw : {int_kw.get(), bool_kw.get(), char_kw.get(),
+                         string_kw.get()})
+            rd_kw_fwrite(kw, fortio);
+    }
+    std::stringstream written;
+    written << std::ifstream(path).rdbuf();
+
+    REQUIRE(written.str() ==
+            " 'INTKW   '           8 'INTE'\n"
+            "           0          -1           7  2147483647 -2147483648"
+            "          42\n"
+            "        1000          -9\n"
+            " 'BOOLKW  '           3 'LOGI'\n"
+            "  T  F  T\n"
+            " 'CHARKW  '           2 'CHAR'\n"
+            " 'AB      ' '12345678'\n"
+            " 'STRKW   '           1 'C010'\n"
+            " 'xyz       '\n");
+}
+
+TEST_CASE_METHOD(Tmpdir, "unformatted keywords are written in chunks",
+                 "[rd_kw]") {
+    auto path = (dirname / "CASE.UNRST").string();
+    auto int_kw = make_int_kw("INTKW", 1500000);
+    auto bool_kw = make_rd_kw("BOOLKW", 2500, RD_BOOL);
+    for (int i = 0; i < 2500; i++)
+        rd_kw_iset_bool(bool_kw.get(), i, i % 7 == 0);
+    auto char_kw = make_rd_kw("CHARKW", 300, RD_CHAR);
+    for (int i = 0; i < 300; i++)
+        rd_kw_iset_string8(char_kw.get(), i, i % 2 ? "ODD" : "EVEN-ONE");
+    auto mess_kw = make_rd_kw("MESSKW", 0, RD_MESS);
+
+    const std::vector<rd_kw_type *> kws = {int_kw.get(), bool_kw.get(),
+                                           char_kw.get(), mess_kw.get()};
+    {
+        ERT::FortIO fortio(path, std::ios_base::out);
+        for (auto *kw : kws)
+            rd_kw_fwrite(kw, fortio);
+    }
+
+    offset_type expected_size = 0;
+    for (auto *kw : kws)
+        expected_size += rd_kw_fortio_size__(rd_kw_get_data_type(kw),
+                                             rd_kw_get_size(kw));
+    REQUIRE(std::filesystem::file_size(path) ==
+            static_cast<uintmax_t>(expected_size));
+
+    ERT::FortIO fortio(path, std::ios_base::in);
+    for (auto *kw : kws) {
+        rd_kw_ptr copy{rd_kw_fread_alloc(fortio), rd_kw_free};
+        REQUIRE(copy);
+        REQUIRE(rd_kw_equal(copy.get(), kw));
+    }
+}
+
+namespace {
+
+rd_kw_ptr make_double_kw(const std::vector<double> &values) {
+    auto kw = make_rd_kw("KW", values.size(), RD_DOUBLE);
+    std::copy(values.begin(), values.end(),
+              static_cast<double *>(rd_kw_get_ptr(kw.get())));
+    return kw;
+}
+
+std::vector<double> kw_values(const rd_kw_type *kw) {
+    auto data = static_cast<const double *>(rd_kw_get_ptr(kw));
+    return {data, data + rd_kw_get_size(kw)};
+}
+
+std::vector<double> random_values(size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(0.5, 2.0);
+    std::vector<double> values(size);
+    for (auto &value : values)
+        value = distribution(generator);
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("inplace ops agree with an element wise loop", "[rd_kw]") {
+    /* Below the block size, with a tail after the blocks, and large enough
+       to be split between threads. */
+    size_t size = GENERATE(size_t(7), size_t(1000), size_t((1 << 20) + 13));
+    auto a = random_values(size, 1);
+    auto b = random_values(size, 2);
+    auto target = make_double_kw(a);
+    auto other = make_double_kw(b);
+
+    std::vector<double> expected(a);
+    SECTION("add") {
+        rd_kw_inplace_add(target.get(), other.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] += b[i];
+    }
+    SECTION("sub") {
+        rd_kw_inplace_sub(target.get(), other.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] -= b[i];
+    }
+    SECTION("mul") {
+        rd_kw_inplace_mul(target.get(), other.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] *= b[i];
+    }
+    SECTION("div") {
+        rd_kw_inplace_div(target.get(), other.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] /= b[i];
+    }
+    SECTION("add squared") {
+        rd_kw_inplace_add_squared(target.get(), other.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] += b[i] * b[i];
+    }
+    SECTION("mul with itself") {
+        rd_kw_inplace_mul(target.get(), target.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] *= a[i];
+    }
+    SECTION("sqrt") {
+        rd_kw_inplace_sqrt(target.get());
+        for (size_t i = 0; i < size; i++)
+            expected[i] = std::sqrt(a[i]);
+    }
+    SECTION("abs") {
+        rd_kw_scale_double(target.get(), -1);
+        rd_kw_inplace_abs(target.get());
+    }
+    SECTION("scale and shift") {
+        rd_kw_scale_double(target.get(), 3);
+        rd_kw_shift_double(target.get(), -1);
+        for (size_t i = 0; i < size; i++)
+            expected[i] = expected[i] * 3 - 1;
+    }
+    REQUIRE(kw_values(target.get()) == expected);
+}
+
+TEST_CASE("indexed ops agree with a loop over the index list", "[rd_kw]") {
+    size_t size = 5000;
+    auto a = random_values(size, 3);
+    auto b = random_values(size, 4);
+    auto target = make_double_kw(a);
+    auto other = make_double_kw(b);
+
+    /* A long run, scattered cells, a run cut short by a duplicate, and a
+       run ending at the last element. */
+    std::vector<int> index;
+    for (int i = 10; i < 1010; i++)
+        index.push_back(i);
+    for (int i : {3, 2500, 17, 17, 4999, 0})
+        index.push_back(i);
+    for (int i = 2000; i < 2040; i++)
+        index.push_back(i);
+    index.push_back(2020);
+    for (int i = 4900; i < 5000; i++)
+        index.push_back(i);
+
+    int_vector_type *index_set = int_vector_alloc(0, 0);
+    for (int i : index)
+        int_vector_append(index_set, i);
+
+    std::vector<double> expected(a);
+    SECTION("add") {
+        rd_kw_inplace_add_indexed(target.get(), index_set, other.get());
+        for (int i : index)
+            expected[i] += b[i];
+    }
+    SECTION("mul with itself") {
+        rd_kw_inplace_mul_indexed(target.get(), index_set, target.get());
+        for (int i : index)
+            expected[i] *= expected[i];
+    }
+    SECTION("copy") {
+        rd_kw_copy_indexed(target.get(), index_set, other.get());
+        for (int i : index)
+            expected[i] = b[i];
+    }
+    SECTION("sum") {
+        double sum;
+        rd_kw_element_sum_indexed(target.get(), index_set, &sum);
+        double expected_sum = 0;
+        for (int i : index)
+            expected_sum += a[i];
+        REQUIRE_THAT(sum, WithinRel(expected_sum, 1e-12));
+    }
+    REQUIRE(kw_values(target.get()) == expected);
+    int_vector_free(index_set);
+}
+
+TEST_CASE("element sum and max_min agree with a loop", "[rd_kw]") {
+    size_t size = GENERATE(size_t(1), size_t(1000), size_t((1 << 20) + 13));
+    auto values = random_values(size, 5);
+    values[size / 2] = 10;
+    values[size - 1] = 0.25;
+
+    auto kw = make_double_kw(values);
+    double sum;
+    rd_kw_element_sum(kw.get(), &sum);
+    double expected_sum = 0;
+    for (double value : values)
+        expected_sum += value;
+    REQUIRE_THAT(sum, WithinRel(expected_sum, 1e-12));
+
+    auto float_kw = make_rd_kw("KW", size, RD_FLOAT);
+    for (size_t i = 0; i < size; i++)
+        rd_kw_iset_float(float_kw.get(), i, values[i]);
+    REQUIRE_THAT(rd_kw_element_sum_float(float_kw.get()),
+                 WithinRel(expected_sum, 1e-5));
+
+    double max;
+    double min;
+    rd_kw_max_min(kw.get(), &max, &min);
+    REQUIRE(max == *std::max_element(values.begin(), values.end()));
+    REQUIRE(min == *std::min_element(values.begin(), values.end()));
+}
+
+TEST_CASE("max_min ignores NaN unless it is the first element", "[rd_kw]") {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> values(300, 1);
+    values[100] = nan;
+    values[150] = 5;
+    values[299] = -2;
+
+    double max;
+    double min;
+    auto kw = make_double_kw(values);
+    rd_kw_max_min(kw.get(), &max, &min);
+    REQUIRE(max == 5);
+    REQUIRE(min == -2);
+
+    values[0] = nan;
+    kw = make_double_kw(values);
+    rd_kw_max_min(kw.get(), &max, &min);
+    REQUIRE(std::isnan(max));
+    REQUIRE(std::isnan(min));
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <resdata/FortIO.hpp>
+#include <resdata/rd_file.hpp>
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_allocator.hpp>
+#include <resdata/rd_type.hpp>
+
+#include "tmpdir.hpp"
+
+namespace {
+
+bool is_aligned(const void *ptr, uintptr_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("Keyword data is cache line aligned", "[rd_kw_allocator]") {
+    for (int size : {1, 3, 411, 100000}) {
+        auto kw = make_rd_kw("KW", size, RD_FLOAT);
+        REQUIRE(is_aligned(rd_kw_get_ptr(kw.get()),
+                           rd::AlignedKWAllocator::alignment));
+    }
+}
+
+TEST_CASE("Keywords take their data from the scoped allocator",
+          "[rd_kw_allocator]") {
+    auto pool = rd::KWPool::create();
+    rd_kw_ptr kw{nullptr, &rd_kw_free};
+    {
+        rd::ScopedKWAllocator scope(*pool);
+        REQUIRE(&rd::current_kw_allocator() == pool.get());
+        kw.reset(rd_kw_alloc("INTEHEAD", 411, RD_INT));
+    }
+    REQUIRE(&rd::current_kw_allocator() == &rd::default_kw_allocator());
+
+    auto stats = pool->stats();
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.bytes_in_use == 411 * sizeof(int));
+
+    SECTION("and give it back when resized") {
+        rd_kw_iset_int(kw.get(), 410, 7);
+        rd_kw_resize(kw.get(), 500);
+        REQUIRE(rd_kw_iget_int(kw.get(), 410) == 7);
+        REQUIRE(rd_kw_iget_int(kw.get(), 499) == 0);
+        stats = pool->stats();
+        REQUIRE(stats.allocations == 2);
+        REQUIRE(stats.deallocations == 1);
+        REQUIRE(stats.bytes_in_use == 500 * sizeof(int));
+    }
+
+    SECTION("and when freed") {
+        kw.reset();
+        stats = pool->stats();
+        REQUIRE(stats.deallocations == 1);
+        REQUIRE(stats.bytes_in_use == 0);
+        REQUIRE(stats.peak_bytes_in_use == 411 * sizeof(int));
+    }
+}
+
+TEST_CASE("KWPool shares chunks between small buffers", "[rd_kw_allocator]") {
+    auto pool = rd::KWPool::create();
+    void *small[100];
+    for (auto &ptr : small) {
+        ptr = pool->allocate(100);
+        REQUIRE(is_aligned(ptr, 64));
+    }
+    REQUIRE(pool->stats().system_allocations == 1);
+
+    // Freed blocks are reused
+    pool->deallocate(small[10], 100);
+    REQUIRE(pool->allocate(100) == small[10]);
+
+    void *large = pool->allocate(rd::KWPool::max_block_size + 1);
+    REQUIRE(is_aligned(large, rd::AlignedKWAllocator::alignment));
+    REQUIRE(pool->stats().system_allocations == 1);
+    pool->deallocate(large, rd::KWPool::max_block_size + 1);
+
+    for (auto *ptr : small)
+        pool->deallocate(ptr, 100);
+    REQUIRE(pool->stats().bytes_in_use == 0);
+}
+
+TEST_CASE("Keywords from a pool outlive its owner", "[rd_kw_allocator]") {
+    auto pool = rd::KWPool::create();
+    rd_kw_ptr kw{nullptr, &rd_kw_free};
+    rd_kw_ptr large_kw{nullptr, &rd_kw_free};
+    {
+        rd::ScopedKWAllocator scope(*pool);
+        kw.reset(rd_kw_alloc("LOGIHEAD", 121, RD_BOOL));
+        large_kw.reset(rd_kw_alloc("PRESSURE", 10000, RD_FLOAT));
+    }
+    pool.reset();
+    rd_kw_iset_bool(kw.get(), 120, true);
+    REQUIRE(rd_kw_iget_bool(kw.get(), 120));
+    kw.reset();
+    rd_kw_resize(large_kw.get(), 20000);
+    REQUIRE(rd_kw_iget_float(large_kw.get(), 19999) == 0);
+}
+
+TEST_CASE("Huge pages are used above the threshold", "[rd_kw_allocator]") {
+    auto &allocator = rd::default_kw_allocator();
+    allocator.set_huge_page_threshold(rd::AlignedKWAllocator::huge_page_size);
+    auto kw = make_rd_kw("PRESSURE", 1 << 20, RD_DOUBLE);
+    allocator.set_huge_page_threshold(0);
+
+    REQUIRE(is_aligned(rd_kw_get_ptr(kw.get()),
+                       rd::AlignedKWAllocator::huge_page_size));
+    rd_kw_iset_double(kw.get(), (1 << 20) - 1, 1.5);
+    REQUIRE(rd_kw_iget_double(kw.get(), (1 << 20) - 1) == 1.5);
+}
+
+TEST_CASE_METHOD(Tmpdir, "The small keywords of a file share a pool",
+                 "[rd_kw_allocator]") {
+    auto filename = (dirname / "CASE.UNRST").string();
+    const int num_kw = 50;
+    {
+        ERT::FortIO fortio(filename, std::ios_base::out);
+        for (int k = 0; k < num_kw; k++) {
+            auto name = "KW" + std::to_string(k);
+            auto kw = make_rd_kw(name.c_str(), 10, RD_INT);
+            rd_kw_iset_int(kw.get(), 9, k);
+            rd_kw_fwrite(kw.get(), fortio);
+        }
+    }
+
+    auto file = rd::File::open(filename);
+    for (int k = 0; k < num_kw; k++)
+        REQUIRE(rd_kw_iget_int(file->get_kw("KW" + std::to_string(k), 0),
+                               9) == k);
+
+    auto stats = file->kw_allocation_stats();
+    REQUIRE(stats.allocations == num_kw);
+    REQUIRE(stats.bytes_in_use == num_kw * 10 * sizeof(int));
+    REQUIRE(stats.system_allocations == 1);
+
+    file->get_global_view()->clear();
+    REQUIRE(file->kw_allocation_stats().bytes_in_use == 0);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ert/util/util.hpp>
+
+#include <resdata/FortIO.hpp>
+#include <resdata/rd_endian_flip.hpp>
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_mapped.hpp>
+#include <resdata/rd_type.hpp>
+
+#include "tmpdir.hpp"
+
+using Catch::Matchers::ContainsSubstring;
+
+TEST_CASE_METHOD(Tmpdir, "MappedKW exposes keywords in a mapped file",
+                 "[rd_kw_mapped]") {
+    auto path = (dirname / "FILE").string();
+    auto small_kw = make_rd_kw("SMALL", 10, RD_INT);
+    auto large_kw = make_rd_kw("LARGE", 2500, RD_FLOAT);
+    auto char_kw = make_rd_kw("NAMES", 3, RD_CHAR);
+    for (int i = 0; i < 10; i++)
+        rd_kw_iset_int(small_kw.get(), i, i * i);
+    for (int i = 0; i < 2500; i++)
+        rd_kw_iset_float(large_kw.get(), i, 0.25f * i);
+    for (int i = 0; i < 3; i++)
+        rd_kw_iset_string8(char_kw.get(), i, std::to_string(i).c_str());
+
+    std::vector<offset_type> offsets;
+    {
+        ERT::FortIO fortio(path, std::ios_base::out);
+        for (const auto *kw : {small_kw.get(), large_kw.get(), char_kw.get()}) {
+            offsets.push_back(fortio.ftell());
+            rd_kw_fwrite(kw, fortio);
+        }
+    }
+
+    ERT::FortIO fortio(path, std::ios_base::in);
+    REQUIRE(fortio.mmap_file());
+
+    SECTION("the header is read from the mapping") {
+        rd::MappedKW large(fortio, offsets[1]);
+        REQUIRE(large.header() == "LARGE");
+        REQUIRE(large.size() == 2500);
+        REQUIRE(rd_type_is_float(large.data_type()));
+    }
+
+    SECTION("the records point into the mapping") {
+        rd::MappedKW large(fortio, offsets[1]);
+        const auto &records = large.records();
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].first == 0);
+        REQUIRE(records[0].count == 1000);
+        REQUIRE(records[2].first == 2000);
+        REQUIRE(records[2].count == 500);
+
+        for (const auto &record : records) {
+            REQUIRE(record.data > fortio.mapped_data());
+            REQUIRE(record.data <
+                    fortio.mapped_data() + fortio.mapped_size());
+            float value;
+            memcpy(&value, record.data + 4 * (record.count - 1), sizeof value);
+            if (RD_ENDIAN_FLIP)
+                util_endian_flip_vector(&value, sizeof value, 1);
+            REQUIRE(value == 0.25f * (record.first + record.count - 1));
+        }
+    }
+
+    SECTION("get() returns the keyword data") {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            rd::MappedKW mapped(fortio, offsets[i]);
+            const rd_kw_type *kw = mapped.get();
+            REQUIRE(kw == mapped.get());
+            const rd_kw_type *expected[] = {small_kw.get(), large_kw.get(),
+                                            char_kw.get()};
+            REQUIRE(rd_kw_equal(kw, expected[i]));
+        }
+    }
+
+    SECTION("only single record numeric data can be borrowed") {
+        rd::MappedKW large(fortio, offsets[1]);
+        rd::MappedKW names(fortio, offsets[2]);
+        REQUIRE_FALSE(large.borrowed());
+        REQUIRE_FALSE(names.borrowed());
+
+        rd::MappedKW small(fortio, offsets[0]);
+        if (small.borrowed()) {
+            const char *data =
+                static_cast<const char *>(rd_kw_get_ptr(small.get()));
+            REQUIRE(data == small.records()[0].data);
+        }
+        if (RD_ENDIAN_FLIP)
+            REQUIRE_FALSE(small.borrowed());
+    }
+
+    SECTION("an offset which is not a keyword is rejected") {
+        REQUIRE_THROWS_AS(rd::MappedKW(fortio, offsets[0] + 4),
+                          std::runtime_error);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "MappedKW rejects truncated and unmapped files",
+                 "[rd_kw_mapped]") {
+    auto path = (dirname / "FILE").string();
+    {
+        auto kw = make_rd_kw("KW", 100, RD_DOUBLE);
+        ERT::FortIO fortio(path, std::ios_base::out);
+        rd_kw_fwrite(kw.get(), fortio);
+    }
+
+    {
+        ERT::FortIO fortio(path, std::ios_base::in);
+        REQUIRE_THROWS_WITH(rd::MappedKW(fortio, 0),
+                            ContainsSubstring("not mapped"));
+    }
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    ERT::FortIO fortio(path, std::ios_base::in);
+    REQUIRE(fortio.mmap_file());
+    REQUIRE_THROWS_WITH(rd::MappedKW(fortio, 0),
+                        ContainsSubstring("incomplete data"));
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <resdata/rd_kw.hpp>
+#include <resdata/rd_kw_view.hpp>
+#include <resdata/rd_type.hpp>
+
+using Catch::Matchers::ContainsSubstring;
+
+TEST_CASE("KWView exposes the elements of a keyword", "[rd_kw_view]") {
+    auto kw = make_rd_kw("KW", 5, RD_FLOAT);
+    rd::KWView<float> view(kw.get());
+    REQUIRE(view.size() == 5);
+    REQUIRE_FALSE(view.empty());
+
+    std::iota(view.begin(), view.end(), 1.0f);
+    view[4] = 10;
+    REQUIRE(rd_kw_iget_float(kw.get(), 0) == 1);
+    REQUIRE(rd_kw_iget_float(kw.get(), 3) == 4);
+    REQUIRE(rd_kw_iget_float(kw.get(), 4) == 10);
+
+    const rd_kw_type *const_kw = kw.get();
+    rd::KWView<const float> const_view(const_kw);
+    REQUIRE(std::accumulate(const_view.begin(), const_view.end(), 0.0f) == 20);
+    REQUIRE(const_view.at(4) == 10);
+    REQUIRE_THROWS_AS(const_view.at(5), std::out_of_range);
+}
+
+TEST_CASE("KWView checks the type of the keyword", "[rd_kw_view]") {
+    auto kw = make_rd_kw("PORO", 3, RD_DOUBLE);
+    REQUIRE_THROWS_WITH(rd::KWView<float>(kw.get()),
+                        ContainsSubstring("PORO") &&
+                            ContainsSubstring("DOUB"));
+    REQUIRE_NOTHROW(rd::KWView<double>(kw.get()));
+
+    auto bool_kw = make_rd_kw("FLAGS", 3, RD_BOOL);
+    rd_kw_iset_bool(bool_kw.get(), 1, true);
+    rd::KWView<const bool> flags(bool_kw.get());
+    REQUIRE(flags[1]);
+    REQUIRE_FALSE(flags[2]);
+}
+
+TEST_CASE("visit_kw dispatches on the type of the keyword", "[rd_kw_view]") {
+    auto int_kw = make_rd_kw("I", 4, RD_INT);
+    auto double_kw = make_rd_kw("D", 4, RD_DOUBLE);
+    for (int i = 0; i < 4; i++) {
+        rd_kw_iset_int(int_kw.get(), i, i);
+        rd_kw_iset_double(double_kw.get(), i, i + 0.5);
+    }
+
+    auto sum = [](auto view) {
+        double total = 0;
+        for (auto value : view)
+            total += value;
+        return total;
+    };
+    const rd_kw_type *const_int_kw = int_kw.get();
+    REQUIRE(rd::visit_kw(const_int_kw, sum) == 6);
+    REQUIRE(rd::visit_kw(double_kw.get(), sum) == 8);
+
+    rd::visit_kw(int_kw.get(), [](auto view) {
+        static_assert(
+            !std::is_const_v<typename decltype(view)::element_type>);
+        for (auto &value : view)
+            value *= 2;
+    });
+    REQUIRE(rd_kw_iget_int(int_kw.get(), 3) == 6);
+
+    auto char_kw = make_rd_kw("C", 2, RD_CHAR);
+    REQUIRE_THROWS_WITH(rd::visit_kw(char_kw.get(), sum),
+                        ContainsSubstring("not numeric"));
+}
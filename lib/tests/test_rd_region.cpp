@@ -127,6 +127,28 @@ TEST_CASE("rd_region", "[rd_region]") {
             rd_kw_free(int_kw);
         }
 
+        SECTION("select with limit on int and double kw") {
+            rd_kw_type *int_kw = rd_kw_alloc("INTGR", 1000, RD_INT);
+            rd_kw_type *double_kw = rd_kw_alloc("DOUBLE", 1000, RD_DOUBLE);
+            for (int i = 0; i < 1000; i++) {
+                rd_kw_iset_int(int_kw, i, i);
+                rd_kw_iset_double(double_kw, i, i);
+            }
+
+            /* Larger is > for integer keywords and >= otherwise. */
+            rd_region_select_larger(region, int_kw, 600);
+            REQUIRE(num_selected(region) == 399);
+            rd_region_select_larger(region, double_kw, 600);
+            REQUIRE(num_selected(region) == 400);
+            rd_region_deselect_smaller(region, double_kw, 700);
+            REQUIRE(num_selected(region) == 300);
+            rd_region_deselect_larger(region, int_kw, 0);
+            REQUIRE(num_selected(region) == 0);
+
+            rd_kw_free(int_kw);
+            rd_kw_free(double_kw);
+        }
+
         SECTION("select with bool kw") {
             rd_kw_type *bool_kw = rd_kw_alloc("BOOL", 1000, RD_BOOL);
 
@@ -10,12 +10,14 @@
 #include <filesystem>
 #include <fstream>
 #include <ios>
+#include <iterator>
 #include <optional>
 #include <sstream>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <vector>
 
 #include <ert/util/stringlist.hpp>
@@ -32,6 +34,7 @@
 #include <resdata/rd_sum_vector.hpp>
 
 #include "ert/util/double_vector.hpp"
+#include "detail/resdata/rd_tsmry_loader.hpp"
 #include "detail/resdata/rd_unsmry_loader.hpp"
 #include "resdata/FortIO.hpp"
 #include "resdata/rd_file_view.hpp"
@@ -164,6 +167,21 @@ void write_malformed_lgr_smspec(const fs::path &path, bool with_lgrs,
         write_single_int_kw(fortio, NUMLZ_KW, 6);
 }
 
+/** Overwrites the last float of a transposed summary file with @value. */
+void tamper_last_value(const std::string &tsmry_file, float value) {
+    std::fstream stream(tsmry_file, std::ios_base::in | std::ios_base::out |
+                                        std::ios_base::binary);
+    stream.seekp(-static_cast<int>(sizeof value), std::ios_base::end);
+    stream.write(reinterpret_cast<const char *>(&value), sizeof value);
+}
+
+/** Replaces the content of @filename with the first @size bytes of @content. */
+void write_prefix(const std::string &filename, const std::string &content,
+                  size_t size) {
+    std::ofstream stream(filename, std::ios_base::binary);
+    stream.write(content.data(), static_cast<std::streamsize>(size));
+}
+
 void expect_smspec_load_throws(const fs::path &header_path,
                                const std::string &msg) {
     REQUIRE_THROWS_WITH(read_smspec(header_path.string(), ":", false),
@@ -1527,8 +1545,342 @@ SCENARIO_METHOD(Tmpdir, "rd::unsmry_loader reads back values from a UNSMRY") {
                 REQUIRE_THAT(bpr[2], WithinAbs(1728000.0, 1e-6));
                 REQUIRE_THAT(wwct[1], WithinAbs(8640000.0, 1e-6));
             }
+
+            THEN("get_vectors returns the same series column by column") {
+                const std::vector<int> positions{3, 1, 2, 1};
+                const std::vector<double> columns =
+                    loader->get_vectors(positions);
+                const int length = loader->length();
+
+                REQUIRE(columns.size() == positions.size() * length);
+                for (size_t k = 0; k < positions.size(); k++) {
+                    const std::vector<double> expected =
+                        loader->get_vector(positions[k]);
+                    for (int t = 0; t < length; t++)
+                        REQUIRE(columns[k * length + t] == expected[t]);
+                }
+            }
+
+            THEN("get_values picks the requested ministeps") {
+                const std::vector<int> positions{3, 1};
+                const std::vector<int> time_indices{2, 0, 3};
+                const std::vector<double> values =
+                    loader->get_values(positions, time_indices);
+
+                REQUIRE(values.size() == positions.size() * 3);
+                for (size_t k = 0; k < positions.size(); k++) {
+                    const std::vector<double> expected =
+                        loader->get_vector(positions[k]);
+                    for (size_t i = 0; i < time_indices.size(); i++)
+                        REQUIRE(values[k * 3 + i] ==
+                                expected[time_indices[i]]);
+                }
+                REQUIRE_THROWS_AS(loader->get_values(positions, {4}),
+                                  std::out_of_range);
+            }
+
+            THEN("get_vectors rejects positions outside PARAMS") {
+                REQUIRE(loader->get_vectors({}).empty());
+                REQUIRE_THROWS_AS(loader->get_vectors({1, 4}),
+                                  std::out_of_range);
+                REQUIRE_THROWS_AS(loader->get_vectors({-1}), std::out_of_range);
+            }
+        }
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Summary frames agree with the per-value getters") {
+    WriteSpec spec;
+    spec.num_report_steps = 3;
+    spec.num_ministep = 4;
+    const auto case_path = (dirname / "CASE").string();
+    const bool unified = GENERATE(true, false);
+    const bool lazy = GENERATE(true, false);
+    write_test_summary(case_path, spec, /*fmt_output=*/false, unified);
+    auto rd_sum = read_summary(case_path, ":", lazy);
+    REQUIRE(rd_sum);
+
+    auto keywords = make_sum_vector(rd_sum.get(), false);
+    for (const char *key : {"WWCT:OP-1", "FOPT", "BPR:567", "FOPT"})
+        REQUIRE(rd_sum_vector_add_key(keywords.get(), key));
+    const int num_keywords = rd_sum_vector_get_size(keywords.get());
+    const int length = rd_sum_get_data_length(rd_sum.get());
+
+    SECTION("rd_sum_init_double_frame") {
+        std::vector<double> frame(length * num_keywords);
+        rd_sum_init_double_frame(rd_sum.get(), keywords.get(), frame.data());
+
+        for (int t = 0; t < length; t++)
+            for (int k = 0; k < num_keywords; k++)
+                REQUIRE(frame[k + t * num_keywords] ==
+                        rd_sum_iget(rd_sum.get(), t,
+                                    rd_sum_vector_iget_param_index(
+                                        keywords.get(), k)));
+    }
+
+    SECTION("rd_sum_init_double_frame_interp") {
+        auto times = make_time_t_vector(0, 0);
+        time_t sim_time = spec.start_time - 86400;
+        for (int i = 0; i < 2 * length + 4; i++) {
+            time_t_vector_append(times.get(), sim_time);
+            sim_time += 43200;
+        }
+        const int num_times = time_t_vector_size(times.get());
+
+        std::vector<double> frame(num_times * num_keywords);
+        rd_sum_init_double_frame_interp(rd_sum.get(), keywords.get(),
+                                        times.get(), frame.data());
+
+        for (int k = 0; k < num_keywords; k++) {
+            std::vector<double> column(num_times);
+            rd_sum_init_double_vector_interp(
+                rd_sum.get(), rd_sum_vector_iget_key(keywords.get(), k),
+                times.get(), column.data());
+            for (int t = 0; t < num_times; t++)
+                REQUIRE(frame[k + t * num_keywords] == column[t]);
+        }
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Eagerly loaded summary data can be written back") {
+    WriteSpec spec;
+    spec.num_report_steps = 3;
+    spec.num_ministep = 4;
+    const auto case_path = (dirname / "CASE").string();
+    const auto copy_path = (dirname / "COPY").string();
+    const bool unified = GENERATE(true, false);
+    write_test_summary(case_path, spec, /*fmt_output=*/false, unified);
+    auto rd_sum = read_summary(case_path, ":", /*lazy_load=*/false);
+    REQUIRE(rd_sum);
+    const int length = rd_sum_get_data_length(rd_sum.get());
+    const int params_size =
+        rd_smspec_get_params_size(rd_sum_get_smspec(rd_sum.get()));
+
+    SECTION("rd_sum_fwrite writes the loaded values") {
+        rd_sum_set_case(rd_sum.get(), copy_path);
+        rd_sum_fwrite(rd_sum.get());
+        auto copy = read_summary(copy_path, ":", /*lazy_load=*/true);
+        REQUIRE(copy);
+        REQUIRE(rd_sum_get_data_length(copy.get()) == length);
+        for (int t = 0; t < length; t++) {
+            REQUIRE(rd_sum_iget_report_step(copy.get(), t) ==
+                    rd_sum_iget_report_step(rd_sum.get(), t));
+            for (int p = 0; p < params_size; p++)
+                REQUIRE(rd_sum_iget(copy.get(), t, p) ==
+                        rd_sum_iget(rd_sum.get(), t, p));
         }
     }
+
+    SECTION("rd_sum_add_tstep appends to the loaded values") {
+        const double bpr_last =
+            rd_sum_get_last_value_gen_key(rd_sum.get(), "BPR:567");
+        const double sim_seconds =
+            spec.num_report_steps * spec.num_ministep * spec.ministep_length;
+        rd_sum_tstep_type *tstep = rd_sum_add_tstep(
+            rd_sum.get(), spec.num_report_steps + 1, sim_seconds);
+        rd_sum_tstep_set_from_key(tstep, "BPR:567", 42.0);
+
+        REQUIRE(rd_sum_get_data_length(rd_sum.get()) == length + 1);
+        REQUIRE(rd_sum_get_last_value_gen_key(rd_sum.get(), "BPR:567") == 42.0);
+        REQUIRE(rd_sum_get_general_var(rd_sum.get(), length - 1, "BPR:567") ==
+                bpr_last);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Transposed summary sidecar") {
+    WriteSpec spec;
+    spec.num_report_steps = 3;
+    spec.num_ministep = 4;
+    const auto case_path = (dirname / "CASE").string();
+    const bool fmt_output = GENERATE(true, false);
+    write_test_summary(case_path, spec, fmt_output, /*unified=*/true);
+    const std::string unsmry_file =
+        rd::filename(case_path, FileType::UNIFIED_SUMMARY, fmt_output)
+            .string();
+    const std::string tsmry_file = rd::tsmry_filename(unsmry_file);
+
+    auto rd_sum = read_summary(case_path, ":", /*lazy_load=*/true);
+    REQUIRE(rd_sum);
+    const rd_smspec_type *smspec = rd_sum_get_smspec(rd_sum.get());
+    const int params_size = rd_smspec_get_params_size(smspec);
+    const int length = rd_sum_get_data_length(rd_sum.get());
+
+    REQUIRE_FALSE(fs::exists(tsmry_file));
+    REQUIRE_THROWS_AS(rd::tsmry_loader(smspec, unsmry_file),
+                      std::ios_base::failure);
+
+    rd_sum_fwrite_transposed(rd_sum.get());
+    REQUIRE(fs::exists(tsmry_file));
+    for (const auto &entry : fs::directory_iterator(dirname))
+        REQUIRE(entry.path().extension() != ".tmp");
+
+    SECTION("the sidecar holds the same data as the UNSMRY file") {
+        rd::unsmry_loader unsmry(smspec, unsmry_file);
+        rd::tsmry_loader tsmry(smspec, unsmry_file);
+        std::vector<int> positions(params_size);
+        for (int i = 0; i < params_size; i++)
+            positions[i] = params_size - 1 - i;
+
+        REQUIRE(tsmry.length() == unsmry.length());
+        REQUIRE(tsmry.get_vectors(positions) == unsmry.get_vectors(positions));
+        REQUIRE(tsmry.get_values(positions, {length - 1, 0, 2}) ==
+                unsmry.get_values(positions, {length - 1, 0, 2}));
+        REQUIRE(tsmry.sim_time() == unsmry.sim_time());
+        REQUIRE(tsmry.sim_seconds() == unsmry.sim_seconds());
+        REQUIRE(tsmry.report_steps(3) == unsmry.report_steps(3));
+        REQUIRE(tsmry.ministeps() == unsmry.ministeps());
+        REQUIRE(tsmry.iget(length - 1, 2) == unsmry.iget(length - 1, 2));
+        REQUIRE_THROWS_AS(tsmry.get_vectors({params_size}), std::out_of_range);
+    }
+
+    SECTION("read_summary loads the case through the sidecar") {
+        const bool lazy = GENERATE(true, false);
+        tamper_last_value(tsmry_file, 12345.0f);
+
+        auto sidecar_sum = read_summary(case_path, ":", lazy);
+        REQUIRE(sidecar_sum);
+        REQUIRE(rd_sum_get_data_length(sidecar_sum.get()) == length);
+        REQUIRE(rd_sum_iget(sidecar_sum.get(), length - 1, params_size - 1) ==
+                12345.0);
+        for (int t = 0; t < length; t++) {
+            REQUIRE(rd_sum_iget_sim_time(sidecar_sum.get(), t) ==
+                    rd_sum_iget_sim_time(rd_sum.get(), t));
+            REQUIRE(rd_sum_iget_report_step(sidecar_sum.get(), t) ==
+                    rd_sum_iget_report_step(rd_sum.get(), t));
+            REQUIRE(rd_sum_iget(sidecar_sum.get(), t, 1) ==
+                    rd_sum_iget(rd_sum.get(), t, 1));
+        }
+    }
+
+    SECTION("an outdated sidecar is ignored") {
+        tamper_last_value(tsmry_file, 12345.0f);
+        fs::last_write_time(tsmry_file, fs::last_write_time(unsmry_file) -
+                                            std::chrono::hours(1));
+        REQUIRE_THROWS_AS(rd::tsmry_loader(smspec, unsmry_file),
+                          std::ios_base::failure);
+
+        auto reloaded = read_summary(case_path, ":", /*lazy_load=*/true);
+        REQUIRE(rd_sum_iget(reloaded.get(), length - 1, params_size - 1) ==
+                rd_sum_iget(rd_sum.get(), length - 1, params_size - 1));
+    }
+
+    SECTION("concurrent writers of the sidecar do not collide") {
+        std::vector<std::thread> writers;
+        for (int i = 0; i < 4; i++)
+            writers.emplace_back([smspec, &unsmry_file] {
+                rd::tsmry_fwrite(smspec, unsmry_file);
+            });
+        for (auto &writer : writers)
+            writer.join();
+
+        rd::unsmry_loader unsmry(smspec, unsmry_file);
+        rd::tsmry_loader tsmry(smspec, unsmry_file);
+        REQUIRE(tsmry.get_vectors({1, 2}) == unsmry.get_vectors({1, 2}));
+        for (const auto &entry : fs::directory_iterator(dirname))
+            REQUIRE(entry.path().extension() != ".tmp");
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir,
+                 "Transposed summary files require a unified summary case") {
+    WriteSpec spec;
+    const auto case_path = (dirname / "CASE").string();
+    write_test_summary(case_path, spec, /*fmt_output=*/false,
+                       /*unified=*/false);
+    auto rd_sum = read_summary(case_path);
+    REQUIRE(rd_sum);
+    REQUIRE_THROWS_AS(rd_sum_fwrite_transposed(rd_sum.get()),
+                      std::invalid_argument);
+}
+
+TEST_CASE_METHOD(Tmpdir, "Refreshing a summary case which is being written") {
+    WriteSpec spec;
+    spec.num_report_steps = 3;
+    spec.num_ministep = 4;
+    const auto case_path = (dirname / "CASE").string();
+    write_test_summary(case_path, spec, /*fmt_output=*/false,
+                       /*unified=*/true);
+    const std::string unsmry_file =
+        rd::filename(case_path, FileType::UNIFIED_SUMMARY, false).string();
+
+    auto full_sum = read_summary(case_path);
+    REQUIRE(full_sum);
+    const int length = rd_sum_get_data_length(full_sum.get());
+    const int params_size =
+        rd_smspec_get_params_size(rd_sum_get_smspec(full_sum.get()));
+
+    std::string content;
+    std::vector<offset_type> params_start;
+    std::vector<offset_type> params_end;
+    {
+        std::ifstream stream(unsmry_file, std::ios_base::binary);
+        content.assign(std::istreambuf_iterator<char>(stream),
+                       std::istreambuf_iterator<char>());
+        auto rd_file = rd::File::open(unsmry_file);
+        auto view = rd_file->get_global_view();
+        for (size_t i = 0; i < view->size(); i++) {
+            if (view->get_file_kw(i).get_header() != PARAMS_KW)
+                continue;
+            params_start.push_back(view->get_file_kw(i).get_offset());
+            params_end.push_back(i + 1 < view->size()
+                                     ? view->get_file_kw(i + 1).get_offset()
+                                     : content.size());
+        }
+    }
+    REQUIRE(static_cast<int>(params_start.size()) == length);
+
+    const bool lazy = GENERATE(true, false);
+    const bool sidecar = GENERATE(true, false);
+    CAPTURE(lazy, sidecar);
+
+    // Five ministeps, the last one in the second report step
+    write_prefix(unsmry_file, content, params_end[4]);
+    if (sidecar) {
+        auto partial_sum = read_summary(case_path);
+        rd_sum_fwrite_transposed(partial_sum.get());
+    }
+    auto rd_sum = read_summary(case_path, ":", lazy);
+    REQUIRE(rd_sum);
+    REQUIRE(rd_sum_get_data_length(rd_sum.get()) == 5);
+    REQUIRE(rd_sum_refresh(rd_sum.get()) == 0);
+
+    // The PARAMS of the eighth ministep is only partially written
+    write_prefix(unsmry_file, content, params_start[7] + 16);
+    REQUIRE(rd_sum_refresh(rd_sum.get()) == 2);
+    REQUIRE(rd_sum_get_data_length(rd_sum.get()) == 7);
+
+    write_prefix(unsmry_file, content, content.size());
+    REQUIRE(rd_sum_refresh(rd_sum.get()) == length - 7);
+    REQUIRE(rd_sum_get_data_length(rd_sum.get()) == length);
+    REQUIRE(rd_sum_get_last_report_step(rd_sum.get()) ==
+            rd_sum_get_last_report_step(full_sum.get()));
+    REQUIRE(rd_sum_get_sim_length(rd_sum.get()) ==
+            rd_sum_get_sim_length(full_sum.get()));
+    for (int t = 0; t < length; t++) {
+        REQUIRE(rd_sum_iget_sim_time(rd_sum.get(), t) ==
+                rd_sum_iget_sim_time(full_sum.get(), t));
+        REQUIRE(rd_sum_iget_report_step(rd_sum.get(), t) ==
+                rd_sum_iget_report_step(full_sum.get(), t));
+        for (int p = 0; p < params_size; p++)
+            REQUIRE(rd_sum_iget(rd_sum.get(), t, p) ==
+                    rd_sum_iget(full_sum.get(), t, p));
+    }
+
+    if (!lazy) {
+        // The last loaded PARAMS keyword is no longer complete
+        write_prefix(unsmry_file, content, params_start[length - 1] + 16);
+        REQUIRE_THROWS_AS(rd_sum_refresh(rd_sum.get()), std::runtime_error);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Non-unified summary cases are not refreshed") {
+    WriteSpec spec;
+    const auto case_path = (dirname / "CASE").string();
+    write_test_summary(case_path, spec, /*fmt_output=*/false,
+                       /*unified=*/false);
+    auto rd_sum = read_summary(case_path);
+    REQUIRE(rd_sum);
+    REQUIRE(rd_sum_refresh(rd_sum.get()) == 0);
 }
 
 SCENARIO_METHOD(Tmpdir, "rd_sum_alloc_resample over a time vector") {
@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <ert/util/util.hpp>
 #include <filesystem>
+#include <vector>
 
 #include "tmpdir.hpp"
 
@@ -25,3 +30,50 @@ TEST_CASE_METHOD(Tmpdir, "Test getcwd after unlink cwd", "[unittest]") {
         fs::current_path(previous_cwd);
     }
 }
+
+TEST_CASE("Endian flip reverses the bytes of each element", "[unittest]") {
+    int element_size = GENERATE(2, 4, 8);
+    int elements = GENERATE(0, 1, 3, 7, 8, 9, 31, 33, 1000, 1003);
+    // Offsets the data from the allocation to exercise unaligned access
+    size_t misalign = GENERATE(0, 1, 4);
+
+    std::vector<unsigned char> buffer(misalign + element_size * elements);
+    for (size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = static_cast<unsigned char>(i * 31 + 7);
+    std::vector<unsigned char> expected(buffer);
+    for (int i = 0; i < elements; i++) {
+        auto first = expected.begin() + misalign + i * element_size;
+        std::reverse(first, first + element_size);
+    }
+
+    util_endian_flip_vector(buffer.data() + misalign, element_size, elements);
+    REQUIRE(buffer == expected);
+
+    util_endian_flip_vector(buffer.data() + misalign, element_size, elements);
+    util_endian_flip_vector(expected.data() + misalign, element_size,
+                            elements);
+    REQUIRE(buffer == expected);
+}
+
+TEST_CASE("Fused endian flip and widen of floats", "[unittest]") {
+    int elements = GENERATE(0, 1, 3, 4, 5, 8, 17, 1001);
+    size_t misalign = GENERATE(0, 2);
+
+    std::vector<float> values(elements);
+    for (int i = 0; i < elements; i++)
+        values[i] = (i % 2 ? -1.0f : 1.0f) * (0.125f * i + 1e-3f);
+
+    std::vector<char> source(misalign + elements * sizeof(float));
+    if (elements > 0)
+        std::memcpy(source.data() + misalign, values.data(),
+                    elements * sizeof(float));
+    util_endian_flip_vector(source.data() + misalign, sizeof(float),
+                            elements);
+
+    std::vector<double> target(elements + 1, -99.0);
+    util_endian_flip_widen_float(source.data() + misalign, target.data(),
+                                 elements);
+    for (int i = 0; i < elements; i++)
+        REQUIRE(target[i] == static_cast<double>(values[i]));
+    REQUIRE(target[elements] == -99.0);
+}
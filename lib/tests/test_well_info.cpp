@@ -182,10 +182,6 @@ std::string write_three_kw_file(const fs::path &dirname) {
     return path;
 }
 
-bool is_loaded(std::shared_ptr<FileKW> file_kw) {
-    return file_kw->get_kw_ptr() != nullptr;
-}
-
 } // namespace
 
 TEST_CASE_METHOD(Tmpdir, "keywords are lazily loaded", "[well][transaction]") {
@@ -193,17 +189,13 @@ TEST_CASE_METHOD(Tmpdir, "keywords are lazily loaded", "[well][transaction]") {
     std::unique_ptr<rd::File> file = rd::File::open(path);
     auto view = file->get_global_view();
 
-    auto fk0 = view->get_file_kw(0);
-    auto fk1 = view->get_file_kw(1);
-    auto fk2 = view->get_file_kw(2);
-
-    REQUIRE_FALSE(is_loaded(fk0));
-    REQUIRE_FALSE(is_loaded(fk1));
-    REQUIRE_FALSE(is_loaded(fk2));
+    REQUIRE(view->get_loaded_kw(0) == nullptr);
+    REQUIRE(view->get_loaded_kw(1) == nullptr);
+    REQUIRE(view->get_loaded_kw(2) == nullptr);
 
     view->get_kw(0);
 
-    REQUIRE(is_loaded(fk0));
-    REQUIRE_FALSE(is_loaded(fk1));
-    REQUIRE_FALSE(is_loaded(fk2));
+    REQUIRE(view->get_loaded_kw(0) != nullptr);
+    REQUIRE(view->get_loaded_kw(1) == nullptr);
+    REQUIRE(view->get_loaded_kw(2) == nullptr);
 }
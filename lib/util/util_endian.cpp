@@ -1,5 +1,8 @@
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+
+#include <ert/util/util.hpp>
 
 #if UINTPTR_MAX == 0xFFFFFFFF
 #define ARCH32
@@ -10,29 +13,18 @@
 #endif
 
 /*
-   Macros for endian flipping. The macros create a new endian-flipped
-   value, and should be used as:
-
-     flipped_value = FLIP32( value )
-
-   The macros are not exported and only available through the function
-   util_endian_flip_vector().
+  On x86 the 4 and 8 byte flips, and the fused flip + widen of floats, are
+  done with byte shuffles. The kernels are compiled for SSSE3 and AVX2
+  with target attributes, and selected at runtime from what the CPU
+  supports, so the library itself does not require any of them.
 */
-
-#define FLIP16(var) (((var >> 8) & 0x00ff) | ((var << 8) & 0xff00))
-
-#define FLIP32(var)                                                            \
-    (((var >> 24) & 0x000000ff) | ((var >> 8) & 0x0000ff00) |                  \
-     ((var << 8) & 0x00ff0000) | ((var << 24) & 0xff000000))
-
-#define FLIP64(var)                                                            \
-    (((var >> 56) & 0x00000000000000ff) | ((var >> 40) & 0x000000000000ff00) | \
-     ((var >> 24) & 0x0000000000ff0000) | ((var >> 8) & 0x00000000ff000000) |  \
-     ((var << 8) & 0x000000ff00000000) | ((var << 24) & 0x0000ff0000000000) |  \
-     ((var << 40) & 0x00ff000000000000) | ((var << 56) & 0xff00000000000000))
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTIL_ENDIAN_X86_KERNELS
+#include <immintrin.h>
+#endif
 
 static uint16_t util_endian_convert16(uint16_t u) {
-    return ((u >> 8U) & 0xFFU) | ((u & 0xFFU) >> 8U);
+    return ((u >> 8U) & 0xFFU) | ((u & 0xFFU) << 8U);
 }
 
 static uint32_t util_endian_convert32(uint32_t u) {
@@ -64,54 +56,230 @@ static uint64_t util_endian_convert32_64(uint64_t u) {
     return u;
 }
 
+namespace {
+
+using flip_kernel = void (*)(char *data, size_t elements);
+using widen_kernel = void (*)(const char *source, double *target,
+                              size_t elements);
+
+void flip32_scalar(char *data, size_t elements) {
+#ifdef ARCH64
+    /*
+      In the case of a 64 bit CPU the fastest way to swap 32 bit
+      variables will be by swapping two elements in one operation;
+      this is provided by the util_endian_convert32_64() function.
+    */
+    for (size_t i = 0; i < elements / 2; i++) {
+        uint64_t u;
+        memcpy(&u, data + 8 * i, sizeof u);
+        u = util_endian_convert32_64(u);
+        memcpy(data + 8 * i, &u, sizeof u);
+    }
+
+    if (elements & 1) {
+        // Odd number of elements - flip the last one as a 32 bit swap.
+        uint32_t u;
+        memcpy(&u, data + 4 * (elements - 1), sizeof u);
+        u = util_endian_convert32(u);
+        memcpy(data + 4 * (elements - 1), &u, sizeof u);
+    }
+#else
+    for (size_t i = 0; i < elements; i++) {
+        uint32_t u;
+        memcpy(&u, data + 4 * i, sizeof u);
+        u = util_endian_convert32(u);
+        memcpy(data + 4 * i, &u, sizeof u);
+    }
+#endif
+}
+
+void flip64_scalar(char *data, size_t elements) {
+    for (size_t i = 0; i < elements; i++) {
+        uint64_t u;
+        memcpy(&u, data + 8 * i, sizeof u);
+        u = util_endian_convert64(u);
+        memcpy(data + 8 * i, &u, sizeof u);
+    }
+}
+
+void flip_widen_scalar(const char *source, double *target, size_t elements) {
+    for (size_t i = 0; i < elements; i++) {
+        uint32_t u;
+        float value;
+        memcpy(&u, source + 4 * i, sizeof u);
+        u = util_endian_convert32(u);
+        memcpy(&value, &u, sizeof value);
+        target[i] = value;
+    }
+}
+
+#ifdef UTIL_ENDIAN_X86_KERNELS
+
+/* Applies the byte @shuffle to each 16 byte block of the @bytes at @data;
+   a trailing partial block is left to the caller. */
+__attribute__((target("ssse3"))) void
+flip_ssse3(char *data, size_t bytes, __m128i shuffle) {
+    size_t offset = 0;
+    for (; offset + 64 <= bytes; offset += 64) {
+        __m128i *p = reinterpret_cast<__m128i *>(data + offset);
+        __m128i v0 = _mm_loadu_si128(p);
+        __m128i v1 = _mm_loadu_si128(p + 1);
+        __m128i v2 = _mm_loadu_si128(p + 2);
+        __m128i v3 = _mm_loadu_si128(p + 3);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(v0, shuffle));
+        _mm_storeu_si128(p + 1, _mm_shuffle_epi8(v1, shuffle));
+        _mm_storeu_si128(p + 2, _mm_shuffle_epi8(v2, shuffle));
+        _mm_storeu_si128(p + 3, _mm_shuffle_epi8(v3, shuffle));
+    }
+    for (; offset + 16 <= bytes; offset += 16) {
+        __m128i *p = reinterpret_cast<__m128i *>(data + offset);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), shuffle));
+    }
+}
+
+__attribute__((target("ssse3"))) void flip32_ssse3(char *data,
+                                                   size_t elements) {
+    flip_ssse3(data, 4 * elements,
+               _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                             13, 12));
+    size_t done = elements & ~size_t(3);
+    flip32_scalar(data + 4 * done, elements - done);
+}
+
+__attribute__((target("ssse3"))) void flip64_ssse3(char *data,
+                                                   size_t elements) {
+    flip_ssse3(data, 8 * elements,
+               _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                             10, 9, 8));
+    size_t done = elements & ~size_t(1);
+    flip64_scalar(data + 8 * done, elements - done);
+}
+
+__attribute__((target("ssse3"))) void
+flip_widen_ssse3(const char *source, double *target, size_t elements) {
+    const __m128i shuffle =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t i = 0;
+    for (; i + 4 <= elements; i += 4) {
+        __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(source + 4 * i));
+        __m128 f = _mm_castsi128_ps(_mm_shuffle_epi8(v, shuffle));
+        _mm_storeu_pd(target + i, _mm_cvtps_pd(f));
+        _mm_storeu_pd(target + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+    }
+    flip_widen_scalar(source + 4 * i, target + i, elements - i);
+}
+
+/* As flip_ssse3(), with the shuffle applied to 32 byte blocks. */
+__attribute__((target("avx2"))) void flip_avx2(char *data, size_t bytes,
+                                               __m256i shuffle) {
+    size_t offset = 0;
+    for (; offset + 128 <= bytes; offset += 128) {
+        __m256i *p = reinterpret_cast<__m256i *>(data + offset);
+        __m256i v0 = _mm256_loadu_si256(p);
+        __m256i v1 = _mm256_loadu_si256(p + 1);
+        __m256i v2 = _mm256_loadu_si256(p + 2);
+        __m256i v3 = _mm256_loadu_si256(p + 3);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(v0, shuffle));
+        _mm256_storeu_si256(p + 1, _mm256_shuffle_epi8(v1, shuffle));
+        _mm256_storeu_si256(p + 2, _mm256_shuffle_epi8(v2, shuffle));
+        _mm256_storeu_si256(p + 3, _mm256_shuffle_epi8(v3, shuffle));
+    }
+    for (; offset + 32 <= bytes; offset += 32) {
+        __m256i *p = reinterpret_cast<__m256i *>(data + offset);
+        _mm256_storeu_si256(
+            p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle));
+    }
+}
+
+__attribute__((target("avx2"))) void flip32_avx2(char *data,
+                                                 size_t elements) {
+    flip_avx2(data, 4 * elements,
+              _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                               13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                               15, 14, 13, 12));
+    size_t done = elements & ~size_t(7);
+    flip32_scalar(data + 4 * done, elements - done);
+}
+
+__attribute__((target("avx2"))) void flip64_avx2(char *data,
+                                                 size_t elements) {
+    flip_avx2(data, 8 * elements,
+              _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                               9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12,
+                               11, 10, 9, 8));
+    size_t done = elements & ~size_t(3);
+    flip64_scalar(data + 8 * done, elements - done);
+}
+
+__attribute__((target("avx2"))) void
+flip_widen_avx2(const char *source, double *target, size_t elements) {
+    const __m256i shuffle = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7,
+        6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(source + 4 * i));
+        __m256 f = _mm256_castsi256_ps(_mm256_shuffle_epi8(v, shuffle));
+        _mm256_storeu_pd(target + i,
+                         _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+        _mm256_storeu_pd(target + i + 4,
+                         _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+    }
+    flip_widen_scalar(source + 4 * i, target + i, elements - i);
+}
+
+#endif
+
+struct endian_kernels {
+    flip_kernel flip32 = flip32_scalar;
+    flip_kernel flip64 = flip64_scalar;
+    widen_kernel flip_widen = flip_widen_scalar;
+};
+
+const endian_kernels &util_endian_kernels() {
+    static const endian_kernels kernels = [] {
+        endian_kernels selected;
+#ifdef UTIL_ENDIAN_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            selected.flip32 = flip32_avx2;
+            selected.flip64 = flip64_avx2;
+            selected.flip_widen = flip_widen_avx2;
+        } else if (__builtin_cpu_supports("ssse3")) {
+            selected.flip32 = flip32_ssse3;
+            selected.flip64 = flip64_ssse3;
+            selected.flip_widen = flip_widen_ssse3;
+        }
+#endif
+        return selected;
+    }();
+    return kernels;
+}
+
+} // namespace
+
 void util_endian_flip_vector(void *data, int element_size, int elements) {
-    int i;
+    if (elements <= 0)
+        return;
+
     switch (element_size) {
     case (1):
         break;
     case (2): {
         uint16_t *tmp16 = (uint16_t *)data;
 
-        for (i = 0; i < elements; i++)
+        for (int i = 0; i < elements; i++)
             tmp16[i] = util_endian_convert16(tmp16[i]);
         break;
     }
-    case (4): {
-#ifdef ARCH64
-        /*
-        In the case of a 64 bit CPU the fastest way to swap 32 bit
-        variables will be by swapping two elements in one operation;
-        this is provided by the util_endian_convert32_64() function. In the case
-        of binary restart format files this case is quite common, and
-        therefore worth supporting as a special case.
-      */
-        uint64_t *tmp64 = (uint64_t *)data;
-
-        for (i = 0; i < elements / 2; i++)
-            tmp64[i] = util_endian_convert32_64(tmp64[i]);
-
-        if (elements & 1) {
-            // Odd number of elements - flip the last element as an ordinary 32 bit swap.
-            uint32_t *tmp32 = (uint32_t *)data;
-            tmp32[elements - 1] = util_endian_convert32(tmp32[elements - 1]);
-        }
+    case (4):
+        util_endian_kernels().flip32(static_cast<char *>(data), elements);
         break;
-#else
-        uint32_t *tmp32 = (uint32_t *)data;
-
-        for (i = 0; i < elements; i++)
-            tmp32[i] = util_endian_convert32(tmp32[i]);
-
+    case (8):
+        util_endian_kernels().flip64(static_cast<char *>(data), elements);
         break;
-#endif
-    }
-    case (8): {
-        uint64_t *tmp64 = (uint64_t *)data;
-
-        for (i = 0; i < elements; i++)
-            tmp64[i] = util_endian_convert64(tmp64[i]);
-        break;
-    }
     default:
         fprintf(stderr, "%s: current element size: %d \n", __func__,
                 element_size);
@@ -120,3 +288,12 @@ void util_endian_flip_vector(void *data, int element_size, int elements) {
             __func__);
     }
 }
+
+void util_endian_flip_widen_float(const void *source, double *target,
+                                  int elements) {
+    if (elements <= 0)
+        return;
+
+    util_endian_kernels().flip_widen(static_cast<const char *>(source),
+                                     target, elements);
+}
@@ -5,6 +5,8 @@ __all__ = ["FileMode", "FileType"]
 class FileMode:
     CLOSE_STREAM: typing.ClassVar[FileMode]
     DEFAULT: typing.ClassVar[FileMode]
+    INDEX_CACHE: typing.ClassVar[FileMode]
+    MMAP: typing.ClassVar[FileMode]
     WRITABLE: typing.ClassVar[FileMode]
     __members__: typing.ClassVar[dict[str, FileMode]]
     def __and__(self, arg0: FileMode) -> FileMode: ...
@@ -31,6 +31,7 @@ class ResdataFile:
         filename: str,
         flags: FileMode = ...,
         index_filename: str | None = None,
+        keywords: list[str] | None = None,
     ) -> None: ...
     def __len__(self) -> int: ...
     def block_view(self, kw: str, kw_index: typing.SupportsInt) -> ResdataFileView: ...
@@ -52,6 +53,7 @@ class ResdataFile:
     def keys(self) -> typing.KeysView[str]: ...
     def num_named_kw(self, kw: str) -> int: ...
     def num_report_steps(self) -> int: ...
+    def refresh(self) -> int: ...
     def restart_get_kw(
         self, kw_name: str, dtime: datetime.date | datetime.datetime, copy: bool = False
     ) -> ResdataKW: ...
@@ -1,6 +1,8 @@
 import datetime
 from typing import SupportsFloat, SupportsInt, overload
 
+import numpy
+
 from .rd_kw import ResdataKW
 
 __all__ = ["ResdataFileView"]
@@ -21,6 +23,12 @@ class ResdataFileView:
     ) -> ResdataFileView: ...
     def iget_named_kw(self, kw_name: str, index: SupportsInt) -> ResdataKW: ...
     def num_keywords(self, kw: str) -> int: ...
+    def preload(
+        self, kws: list[str] | None = None, threads: SupportsInt = 0
+    ) -> None: ...
+    def read_into(
+        self, kw: str, index: SupportsInt, array: numpy.ndarray
+    ) -> None: ...
     def restart_view(
         self,
         seqnum_index: SupportsInt | None = None,
@@ -1344,6 +1344,28 @@ class Summary(BaseCClass):
 
         _rd_sum._fwrite_sum(self)
 
+    def fwrite_transposed(self):
+        """
+        Writes a column major copy of the UNSMRY file next to it.
+
+        While the copy is newer than the UNSMRY file it is used
+        automatically when the case is loaded, which makes reading a single
+        vector much faster. Only unified cases are supported, and only the
+        case itself is written, not its restart chain.
+        """
+        _rd_sum._fwrite_transposed(self)
+
+    def refresh(self):
+        """
+        Loads the ministeps written to the summary file since it was loaded.
+
+        Intended for monitoring a running simulation; the new ministeps are
+        appended without reading the SMSPEC file or the already loaded data
+        again. Only unified summary files are refreshed. Returns the number
+        of new ministeps.
+        """
+        return _rd_sum._refresh(self)
+
     def alloc_time_vector(self, report_only):
         return TimeVector.createPythonObject(
             _rd_sum._alloc_time_vector(self, report_only)
@@ -402,6 +402,71 @@ class ResdataFileTest(ResdataTest):
             ):
                 ResdataFile("TEST", index_filename="INDEX_FILE")
 
+    def test_that_the_index_cache_is_used_and_invalidated(self):
+        tmpdir = self.tmp_path_factory.mktemp(
+            "python_rd_file_index_cache", numbered=True
+        )
+        with self.monkeypatch.context() as mp:
+            mp.chdir(tmpdir)
+            mp.setenv("RD_INDEX_CACHE_DIR", str(tmpdir / "cache"))
+            kw1 = ResdataKW("KW1", 100, ResDataType.RD_INT)
+            kw2 = ResdataKW("KW2", 100, ResDataType.RD_FLOAT)
+            createFile("TEST", [kw1])
+
+            rd_file = ResdataFile("TEST", flags=FileMode.INDEX_CACHE)
+            self.assertEqual(len(rd_file), 1)
+            rd_file.close()
+            self.assertEqual(len(os.listdir("cache")), 1)
+
+            rd_file = ResdataFile("TEST", flags=FileMode.INDEX_CACHE)
+            self.assertEqual(len(rd_file), 1)
+            self.assertEqual(rd_file["KW1"][0], kw1)
+            rd_file.close()
+
+            createFile("TEST", [kw1, kw2])
+            rd_file = ResdataFile("TEST", flags=FileMode.INDEX_CACHE)
+            self.assertEqual(len(rd_file), 2)
+            self.assertIn("KW2", rd_file)
+            rd_file.close()
+            self.assertEqual(len(os.listdir("cache")), 1)
+
+    def test_that_refresh_indexes_appended_keywords(self):
+        tmpdir = self.tmp_path_factory.mktemp("python_rd_file_refresh", numbered=True)
+        with self.monkeypatch.context() as mp:
+            mp.chdir(tmpdir)
+            kw1 = ResdataKW("KW1", 100, ResDataType.RD_INT)
+            kw2 = ResdataKW("KW2", 100, ResDataType.RD_FLOAT)
+            createFile("TEST", [kw1])
+
+            rd_file = ResdataFile("TEST")
+            self.assertEqual(rd_file.refresh(), 0)
+
+            with openFortIO("TEST", mode=FortIO.APPEND_MODE) as f:
+                kw2.fwrite(f)
+                kw1.fwrite(f)
+            self.assertEqual(rd_file.refresh(), 2)
+            self.assertEqual(len(rd_file), 3)
+            self.assertEqual(rd_file.num_named_kw("KW1"), 2)
+            self.assertEqual(rd_file["KW2"][0], kw2)
+
+    def test_that_keywords_limits_the_index(self):
+        tmpdir = self.tmp_path_factory.mktemp("python_rd_file_keywords", numbered=True)
+        with self.monkeypatch.context() as mp:
+            mp.chdir(tmpdir)
+            seqnum = ResdataKW("SEQNUM", 1, ResDataType.RD_INT)
+            kw1 = ResdataKW("KW1", 100, ResDataType.RD_INT)
+            kw2 = ResdataKW("KW2", 100, ResDataType.RD_FLOAT)
+            createFile("TEST", [seqnum, kw1, kw2, seqnum, kw1, kw2])
+
+            rd_file = ResdataFile("TEST", keywords=["KW2"])
+            self.assertEqual(len(rd_file), 4)
+            self.assertNotIn("KW1", rd_file)
+            self.assertEqual(rd_file.num_named_kw("SEQNUM"), 2)
+            self.assertEqual(rd_file["KW2"][1], kw2)
+
+            with self.assertRaises(ValueError):
+                ResdataFile("TEST", index_filename="INDEX", keywords=["KW2"])
+
     def test_that_fast_opening_with_a_foreign_index_raises(self):
         tmpdir = self.tmp_path_factory.mktemp(
             "python_rd_file_foreign_index", numbered=True
@@ -673,6 +738,14 @@ def test_fast_open_with_index_roundtrip(tmpdir, extra_flags):
         assert list(fast_opened["MY_KEY"][0]) == [0, 1, 2, 3, 4]
 
 
+def test_mmap_open_reads_the_same_keywords(tmpdir):
+    with tmpdir.as_cwd():
+        _write_single_kw_file("TEST")
+
+        mapped = ResdataFile("TEST", flags=FileMode.MMAP)
+        assert list(mapped["MY_KEY"][0]) == [0, 1, 2, 3, 4]
+
+
 def test_save_kw_with_kw_from_different_file_raises(tmpdir):
     with tmpdir.as_cwd():
         _write_single_kw_file("A")
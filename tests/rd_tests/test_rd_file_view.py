@@ -1,5 +1,6 @@
 import datetime
 
+import numpy as np
 import pytest
 from resdata import FileMode, ResDataType
 from resdata.resfile import FortIO, ResdataKW, open_rd_file, openFortIO
@@ -380,6 +381,53 @@ def test_view_reads_identically_for_all_file_modes(sample_file, flags):
         assert list(view.iget_named_kw("PRESSURE", 1)) == pytest.approx([4.0, 5.0, 6.0])
 
 
+@pytest.mark.parametrize("flags", [FileMode.DEFAULT, FileMode.CLOSE_STREAM])
+def test_preload_loads_the_requested_keywords(sample_file, flags):
+    with open_rd_file(sample_file, flags=flags) as rd_file:
+        view = rd_file.global_view
+        view.preload(["PRESSURE", "NOSUCHKW"], threads=4)
+        assert list(view.iget_named_kw("PRESSURE", 1)) == pytest.approx([4.0, 5.0, 6.0])
+        view.preload()
+        assert list(view.iget_named_kw("SWAT", 0)) == pytest.approx([0.1, 0.2, 0.3])
+
+
+@pytest.mark.parametrize("flags", [FileMode.DEFAULT, FileMode.CLOSE_STREAM])
+def test_read_into_fills_the_array(sample_file, flags):
+    with open_rd_file(sample_file, flags=flags) as rd_file:
+        view = rd_file.global_view
+        pressure = np.zeros(3, dtype=np.float32)
+        view.read_into("PRESSURE", 1, pressure)
+        assert list(pressure) == pytest.approx([4.0, 5.0, 6.0])
+
+        swat = np.zeros(3, dtype=np.float64)
+        view.read_into("SWAT", 0, swat)
+        assert list(swat) == pytest.approx([0.1, 0.2, 0.3])
+
+
+def test_read_into_copies_a_modified_keyword(sample_file):
+    with open_rd_file(sample_file) as rd_file:
+        view = rd_file.global_view
+        view.iget_named_kw("PRESSURE", 0)[0] = 10.0
+        pressure = np.zeros(3, dtype=np.float64)
+        view.read_into("PRESSURE", 0, pressure)
+        assert list(pressure) == pytest.approx([10.0, 2.0, 3.0])
+
+
+def test_read_into_with_bad_arguments_raises(sample_file):
+    with open_rd_file(sample_file) as rd_file:
+        view = rd_file.global_view
+        with pytest.raises(KeyError):
+            view.read_into("NOSUCHKW", 0, np.zeros(3, dtype=np.float32))
+        with pytest.raises(IndexError):
+            view.read_into("PRESSURE", 2, np.zeros(3, dtype=np.float32))
+        with pytest.raises(ValueError):
+            view.read_into("PRESSURE", 0, np.zeros(4, dtype=np.float32))
+        with pytest.raises(ValueError):
+            view.read_into("PRESSURE", 0, np.zeros(3, dtype=np.int32))
+        with pytest.raises(TypeError):
+            view.read_into("PRESSURE", 0, np.zeros(3, dtype=np.int64))
+
+
 def test_close_stream_allows_repeated_view_reads(sample_file):
     """With CLOSE_STREAM the file handle is closed between accesses; the
     view must transparently reopen it."""
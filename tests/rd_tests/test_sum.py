@@ -710,6 +710,54 @@ class SumTest(ResdataTest):
             os.mkdir("UNITS")
             case2 = Summary("./UNITS")
 
+    def test_fwrite_transposed(self):
+        tmpdir = self.tmp_path_factory.mktemp("transposed", numbered=True)
+        with self.monkeypatch.context() as mp:
+            mp.chdir(tmpdir)
+            case = create_case("TRANSPOSED")
+            case.fwrite()
+            loaded = Summary("TRANSPOSED")
+            loaded.fwrite_transposed()
+            self.assertTrue(os.path.isfile("TRANSPOSED.TSMRY"))
+
+            for lazy_load in (True, False):
+                reloaded = Summary("TRANSPOSED", lazy_load=lazy_load)
+                for key in ("FOPT", "FOPR", "FGPT"):
+                    self.assertEqual(
+                        list(reloaded.numpy_vector(key)),
+                        list(loaded.numpy_vector(key)),
+                    )
+                self.assertEqual(
+                    list(reloaded.numpy_dates), list(loaded.numpy_dates)
+                )
+
+    def test_refresh(self):
+        tmpdir = self.tmp_path_factory.mktemp("refresh", numbered=True)
+        with self.monkeypatch.context() as mp:
+            mp.chdir(tmpdir)
+            create_case("REFRESH").fwrite()
+            full = Summary("REFRESH")
+            keywords = [kw.copy() for kw in ResdataFile("REFRESH.UNSMRY")]
+            params = [i for i, kw in enumerate(keywords) if kw.name == "PARAMS"]
+            cut = params[len(params) // 2] + 1
+
+            for lazy_load in (True, False):
+                with openFortIO("REFRESH.UNSMRY", mode=FortIO.WRITE_MODE) as f:
+                    for kw in keywords[:cut]:
+                        kw.fwrite(f)
+                case = Summary("REFRESH", lazy_load=lazy_load)
+                self.assertEqual(len(case.numpy_dates), len(params) // 2 + 1)
+                self.assertEqual(case.refresh(), 0)
+
+                with openFortIO("REFRESH.UNSMRY", mode=FortIO.APPEND_MODE) as f:
+                    for kw in keywords[cut:]:
+                        kw.fwrite(f)
+                self.assertEqual(case.refresh(), len(params) - len(params) // 2 - 1)
+                self.assertEqual(list(case.numpy_dates), list(full.numpy_dates))
+                self.assertEqual(
+                    list(case.numpy_vector("FOPT")), list(full.numpy_vector("FOPT"))
+                )
+
     def test_resample_extrapolate(self):
         """
         Test resampling of summary with extrapolate option of lower and upper boundaries enabled
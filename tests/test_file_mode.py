@@ -3,7 +3,13 @@ from resdata import FileMode
 
 
 def test_that_the_file_mode_enum_exposes_the_expected_members():
-    assert set(FileMode.__members__) == {"DEFAULT", "CLOSE_STREAM", "WRITABLE"}
+    assert set(FileMode.__members__) == {
+        "DEFAULT",
+        "CLOSE_STREAM",
+        "WRITABLE",
+        "MMAP",
+        "INDEX_CACHE",
+    }
 
 
 @pytest.mark.parametrize(
@@ -12,6 +18,8 @@ def test_that_the_file_mode_enum_exposes_the_expected_members():
         (FileMode.DEFAULT, 0),
         (FileMode.CLOSE_STREAM, 1),
         (FileMode.WRITABLE, 2),
+        (FileMode.MMAP, 4),
+        (FileMode.INDEX_CACHE, 8),
     ],
 )
 def test_that_file_mode_members_have_the_expected_integer_values(mode, value):